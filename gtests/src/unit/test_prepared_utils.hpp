@@ -0,0 +1,103 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_TEST_PREPARED_UTILS_HPP_INCLUDED__
+#define __CASS_TEST_PREPARED_UTILS_HPP_INCLUDED__
+
+#include "test_token_map_utils.hpp"
+
+#include "prepared.hpp"
+
+#define CASS_PREPARED_PROTOCOL_VERSION 4
+
+class PreparedResultResponseBuilder : protected BufferBuilder {
+public:
+  PreparedResultResponseBuilder(const std::string& id,
+                                const std::string& keyspace,
+                                const std::string& table,
+                                const ColumnMetadataVec& column_metadata,
+                                const std::vector<uint16_t>& pk_indices,
+                                const ColumnMetadataVec& result_columns) {
+    append<cass_int32_t>(CASS_RESULT_KIND_PREPARED); // Kind
+    append_string(id);
+
+    // Bind variables metadata
+    append<cass_int32_t>(CASS_RESULT_FLAG_GLOBAL_TABLESPEC); // Flags
+    append<cass_int32_t>(column_metadata.size()); // Column count
+    append<cass_int32_t>(pk_indices.size()); // Partition key count
+    for (std::vector<uint16_t>::const_iterator i = pk_indices.begin(),
+         end = pk_indices.end(); i != end; ++i) {
+      append<uint16_t>(*i);
+    }
+    append_string(keyspace);
+    append_string(table);
+    for (ColumnMetadataVec::const_iterator i = column_metadata.begin(),
+         end = column_metadata.end(); i != end; ++i) {
+      append_string(i->name);
+      append<uint16_t>(i->data_type->value_type());
+    }
+
+    // Result metadata
+    if (result_columns.empty()) {
+      append<cass_int32_t>(CASS_RESULT_FLAG_NO_METADATA); // Flags
+      append<cass_int32_t>(0); // Column count
+    } else {
+      append<cass_int32_t>(CASS_RESULT_FLAG_GLOBAL_TABLESPEC); // Flags
+      append<cass_int32_t>(result_columns.size()); // Column count
+      append_string(keyspace);
+      append_string(table);
+      for (ColumnMetadataVec::const_iterator i = result_columns.begin(),
+           end = result_columns.end(); i != end; ++i) {
+        append_string(i->name);
+        append<uint16_t>(i->data_type->value_type());
+      }
+    }
+  }
+
+  cass::ResultResponse::Ptr finish() {
+    cass::ResultResponse::Ptr result(new cass::ResultResponse());
+    result->set_buffer(size());
+    memcpy(result->data(), data(), size());
+    result->decode(CASS_PREPARED_PROTOCOL_VERSION, result->data(), size());
+    return result;
+  }
+};
+
+// Creates a prepared statement for "keyspace.table" that binds the given
+// columns and returns the result columns (if any). Only simple
+// (non-collection) column types are supported.
+inline cass::Prepared::ConstPtr create_prepared(const std::string& id,
+                                                const ColumnMetadataVec& column_metadata,
+                                                const std::vector<uint16_t>& pk_indices,
+                                                const std::string& keyspace = "keyspace",
+                                                const std::string& table = "table",
+                                                const ColumnMetadataVec& result_columns = ColumnMetadataVec()) {
+  PreparedResultResponseBuilder builder(id, keyspace, table,
+                                        column_metadata, pk_indices,
+                                        result_columns);
+  cass::TableSplitMetadata::MapPtr partitions(new cass::TableSplitMetadata::Map());
+  cass::Metadata::SchemaSnapshot schema(
+        CASS_PREPARED_PROTOCOL_VERSION, cass::VersionNumber(3, 0, 0),
+        cass::Metadata::PublishedSchema::Ptr(
+          new cass::Metadata::PublishedSchema(0, cass::KeyspaceMetadata::Map(),
+                                              partitions)));
+  return cass::Prepared::ConstPtr(
+        new cass::Prepared(builder.finish(),
+                           cass::PrepareRequest::ConstPtr(new cass::PrepareRequest("SELECT")),
+                           schema));
+}
+
+#endif
@@ -0,0 +1,183 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "bulk_loader.hpp"
+#include "query_request.hpp"
+#include "session.hpp"
+#include "test_prepared_utils.hpp"
+
+static cass::Address host(const char* ip) {
+  cass::Address address;
+  cass::Address::from_string(ip, 9042, &address);
+  return address;
+}
+
+static size_t row_count(const cass::BulkBatcher::BatchVec& batches) {
+  size_t count = 0;
+  for (cass::BulkBatcher::BatchVec::const_iterator it = batches.begin(),
+       end = batches.end(); it != end; ++it) {
+    EXPECT_EQ(it->row_count, it->request->statements().size());
+    count += it->row_count;
+  }
+  return count;
+}
+
+TEST(BulkLoaderUnitTest, BatchByLeader) {
+  cass::BulkBatcher batcher(4);
+  cass::BulkBatcher::BatchVec batches;
+
+  // Rows with a leader are batched by host regardless of their token
+  for (int i = 0; i < 10; ++i) {
+    batcher.add(host(i % 2 == 0 ? "127.0.0.1" : "127.0.0.2"), i,
+                new cass::QueryRequest("INSERT"), &batches);
+  }
+
+  ASSERT_EQ(2u, batches.size());
+  EXPECT_EQ(host("127.0.0.1"), batches[0].host);
+  EXPECT_EQ(host("127.0.0.2"), batches[1].host);
+  EXPECT_EQ(8u, row_count(batches));
+  EXPECT_EQ(static_cast<uint8_t>(CASS_BATCH_TYPE_UNLOGGED),
+            batches[0].request->type());
+
+  // Partial batches with a leader are kept until the final flush
+  batches.clear();
+  batcher.flush_partitions(&batches);
+  EXPECT_TRUE(batches.empty());
+  EXPECT_FALSE(batcher.empty());
+
+  batcher.flush(&batches);
+  ASSERT_EQ(2u, batches.size());
+  EXPECT_EQ(2u, row_count(batches));
+  EXPECT_TRUE(batcher.empty());
+}
+
+TEST(BulkLoaderUnitTest, BatchByPartition) {
+  cass::BulkBatcher batcher(3);
+  cass::BulkBatcher::BatchVec batches;
+
+  // Rows without a leader are only batched with rows of the same partition
+  const int64_t tokens[] = { 1, 2, 1, 3, 1, 2 };
+  for (size_t i = 0; i < sizeof(tokens) / sizeof(tokens[0]); ++i) {
+    batcher.add(cass::Address(), tokens[i],
+                new cass::QueryRequest("INSERT"), &batches);
+  }
+  batcher.add(host("127.0.0.1"), 1, new cass::QueryRequest("INSERT"), &batches);
+
+  ASSERT_EQ(1u, batches.size());
+  EXPECT_FALSE(batches[0].host.is_valid());
+  EXPECT_EQ(3u, batches[0].row_count);
+
+  // The partitions' partial batches are flushed at the end of a chunk
+  batches.clear();
+  batcher.flush_partitions(&batches);
+  ASSERT_EQ(2u, batches.size());
+  EXPECT_EQ(3u, row_count(batches));
+
+  batches.clear();
+  batcher.flush(&batches);
+  ASSERT_EQ(1u, batches.size());
+  EXPECT_EQ(host("127.0.0.1"), batches[0].host);
+}
+
+static cass_bool_t unbound_rows(CassStatement* statement, void* data) {
+  int* remaining = static_cast<int*>(data);
+  if (*remaining == 0) return cass_false;
+  --*remaining;
+  // The partition key is only bound for the value column
+  cass_statement_bind_int32(statement, 1, 42);
+  return cass_true;
+}
+
+TEST(BulkLoaderUnitTest, FailRowsWithoutPartitionKey) {
+  ColumnMetadataVec columns;
+  columns.push_back(ColumnMetadata("key", cass::DataType::ConstPtr(
+                                     new cass::DataType(CASS_VALUE_TYPE_VARCHAR))));
+  columns.push_back(ColumnMetadata("value", cass::DataType::ConstPtr(
+                                     new cass::DataType(CASS_VALUE_TYPE_INT))));
+  cass::Prepared::ConstPtr prepared(
+        create_prepared("id", columns, std::vector<uint16_t>(1, 0)));
+
+  CassSession* session = cass_session_new();
+  CassBulkLoader* loader =
+      cass_bulk_loader_new(session, CassPrepared::to(prepared.get()));
+
+  // Rows that can't be routed fail up front instead of being batched
+  int remaining = 10;
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_bulk_loader_run(loader, unbound_rows, &remaining));
+
+  CassBulkLoaderStats stats;
+  cass_bulk_loader_stats(loader, &stats);
+  EXPECT_EQ(0u, stats.rows);
+  EXPECT_EQ(0u, stats.batches);
+  EXPECT_EQ(10u, stats.failed_rows);
+  EXPECT_EQ(0u, stats.failed_batches);
+
+  const char* message;
+  size_t message_length;
+  cass_bulk_loader_error_message(loader, &message, &message_length);
+  EXPECT_GT(message_length, 0u);
+
+  cass_bulk_loader_free(loader);
+  cass_session_free(session);
+}
+
+TEST(BulkLoaderUnitTest, BatchSettings) {
+  cass::BulkBatcher batcher(3);
+  cass::BulkBatcher::BatchVec batches;
+
+  // The batch uses the settings and timestamp of its first row
+  cass::SharedRefPtr<cass::QueryRequest> first(new cass::QueryRequest("INSERT"));
+  first->set_consistency(CASS_CONSISTENCY_LOCAL_QUORUM);
+  first->set_serial_consistency(CASS_CONSISTENCY_LOCAL_SERIAL);
+  first->set_timestamp(1234);
+  first->set_is_idempotent(true);
+  batcher.add(host("127.0.0.1"), 0, first.get(), &batches);
+
+  cass::SharedRefPtr<cass::QueryRequest> second(new cass::QueryRequest("INSERT"));
+  second->set_is_idempotent(true);
+  batcher.add(host("127.0.0.1"), 0, second.get(), &batches);
+  batcher.flush(&batches);
+
+  ASSERT_EQ(1u, batches.size());
+  const cass::BatchRequest* batch = batches[0].request.get();
+  EXPECT_EQ(CASS_CONSISTENCY_LOCAL_QUORUM, batch->consistency());
+  EXPECT_EQ(CASS_CONSISTENCY_LOCAL_SERIAL, batch->serial_consistency());
+  EXPECT_EQ(1234, batch->timestamp());
+  EXPECT_TRUE(batch->is_idempotent());
+
+  // A single row that isn't idempotent makes the batch non-idempotent
+  batches.clear();
+  batcher.add(host("127.0.0.1"), 0, first.get(), &batches);
+  batcher.add(host("127.0.0.1"), 0, new cass::QueryRequest("INSERT"), &batches);
+  batcher.flush(&batches);
+  ASSERT_EQ(1u, batches.size());
+  EXPECT_FALSE(batches[0].request->is_idempotent());
+}
+
+TEST(BulkLoaderUnitTest, RetryableErrors) {
+  EXPECT_TRUE(cass::BulkLoader::is_retryable(CASS_ERROR_SERVER_UNAVAILABLE, false));
+  EXPECT_TRUE(cass::BulkLoader::is_retryable(CASS_ERROR_SERVER_OVERLOADED, false));
+  EXPECT_FALSE(cass::BulkLoader::is_retryable(CASS_ERROR_SERVER_INVALID_QUERY, true));
+
+  // Timed out batches may have been applied
+  EXPECT_FALSE(cass::BulkLoader::is_retryable(CASS_ERROR_LIB_REQUEST_TIMED_OUT, false));
+  EXPECT_FALSE(cass::BulkLoader::is_retryable(CASS_ERROR_SERVER_WRITE_TIMEOUT, false));
+  EXPECT_TRUE(cass::BulkLoader::is_retryable(CASS_ERROR_LIB_REQUEST_TIMED_OUT, true));
+  EXPECT_TRUE(cass::BulkLoader::is_retryable(CASS_ERROR_SERVER_WRITE_TIMEOUT, true));
+}
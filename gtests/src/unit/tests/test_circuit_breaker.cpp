@@ -0,0 +1,100 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "circuit_breaker_policy.hpp"
+#include "round_robin_policy.hpp"
+#include "scoped_ptr.hpp"
+
+#include <uv.h>
+
+const uint64_t WINDOW_NS = 10LL * 1000LL * 1000LL * 1000LL;
+const uint64_t OPEN_NS = 10LL * 1000LL * 1000LL; // 10 ms
+
+static cass::Host::Ptr create_host(const std::string& ip) {
+  cass::Host::Ptr host(new cass::Host(cass::Address(ip, 9042), false));
+  host->set_up();
+  return host;
+}
+
+TEST(CircuitBreakerUnitTest, Disabled) {
+  cass::Host::Ptr host(create_host("127.0.0.1"));
+  for (int i = 0; i < 100; ++i) {
+    host->record_outcome(true);
+  }
+  EXPECT_TRUE(host->allow_request());
+}
+
+TEST(CircuitBreakerUnitTest, OpenAndClose) {
+  cass::Host::Ptr host(create_host("127.0.0.1"));
+  host->enable_circuit_breaker(0.5, 4, WINDOW_NS, OPEN_NS);
+
+  // Not enough requests to open the breaker
+  host->record_outcome(true);
+  host->record_outcome(true);
+  host->record_outcome(true);
+  EXPECT_TRUE(host->allow_request());
+
+  // Failures are below the threshold
+  host->record_outcome(false);
+  host->record_outcome(false);
+  host->record_outcome(false);
+  host->record_outcome(false);
+  EXPECT_TRUE(host->allow_request());
+
+  host->record_outcome(true);
+  EXPECT_FALSE(host->allow_request());
+
+  // A single probe is allowed after the open period; a failure reopens
+  uv_sleep(20);
+  EXPECT_TRUE(host->allow_request());
+  EXPECT_FALSE(host->allow_request());
+  host->record_outcome(true);
+  EXPECT_FALSE(host->allow_request());
+
+  // A successful probe closes the breaker
+  uv_sleep(20);
+  EXPECT_TRUE(host->allow_request());
+  host->record_outcome(false);
+  EXPECT_TRUE(host->allow_request());
+  EXPECT_TRUE(host->allow_request());
+}
+
+TEST(CircuitBreakerUnitTest, QueryPlan) {
+  cass::HostMap hosts;
+  cass::Host::Ptr host1(create_host("127.0.0.1"));
+  cass::Host::Ptr host2(create_host("127.0.0.2"));
+  cass::Host::Ptr host3(create_host("127.0.0.3"));
+  hosts[host1->address()] = host1;
+  hosts[host2->address()] = host2;
+  hosts[host3->address()] = host3;
+
+  cass::CircuitBreakerPolicy::Settings settings;
+  settings.min_requests = 1;
+  settings.open_ns = WINDOW_NS;
+
+  cass::CircuitBreakerPolicy policy(new cass::RoundRobinPolicy(), settings);
+  policy.init(host1, hosts, NULL);
+
+  host1->record_outcome(true);
+
+  cass::ScopedPtr<cass::QueryPlan> qp(policy.new_query_plan("ks", NULL));
+  EXPECT_EQ(host2, qp->compute_next());
+  EXPECT_EQ(host3, qp->compute_next());
+  EXPECT_EQ(host1, qp->compute_next());
+  EXPECT_FALSE(qp->compute_next());
+}
@@ -0,0 +1,118 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "atomic.hpp"
+#include "epoch_ptr.hpp"
+
+#include <uv.h>
+
+#define NUM_READERS 4
+#define NUM_STORES 20000
+
+class Value : public cass::RefCounted<Value> {
+public:
+  typedef cass::SharedRefPtr<Value> Ptr;
+
+  Value(int value, cass::Atomic<int>* count)
+    : value(value)
+    , alive(true)
+    , count_(count) {
+    count_->fetch_add(1);
+  }
+
+  ~Value() {
+    alive = false;
+    count_->fetch_sub(1);
+  }
+
+  const int value;
+  volatile bool alive;
+
+private:
+  cass::Atomic<int>* count_;
+};
+
+struct ReaderState {
+  cass::EpochPtr<Value>* ptr;
+  cass::Atomic<bool>* is_done;
+  bool is_valid;
+};
+
+static void read(void* arg) {
+  ReaderState* state = static_cast<ReaderState*>(arg);
+  int last = -1;
+  while (!state->is_done->load()) {
+    Value::Ptr value(state->ptr->load());
+    // Values are published in order and must still be alive
+    if (!value->alive || value->value < last) {
+      state->is_valid = false;
+      return;
+    }
+    last = value->value;
+  }
+}
+
+TEST(EpochPtrUnitTest, Simple) {
+  cass::Atomic<int> count(0);
+  {
+    cass::EpochPtr<Value> ptr(Value::Ptr(new Value(1, &count)));
+    EXPECT_EQ(1, ptr.load()->value);
+
+    Value::Ptr loaded(ptr.load());
+    ptr.store(Value::Ptr(new Value(2, &count)));
+    EXPECT_EQ(2, ptr.load()->value);
+
+    // A loaded value outlives its replacement
+    EXPECT_EQ(1, loaded->value);
+    EXPECT_EQ(2, count.load());
+    loaded.reset();
+    EXPECT_EQ(1, count.load());
+  }
+  EXPECT_EQ(0, count.load());
+}
+
+TEST(EpochPtrUnitTest, ConcurrentReaders) {
+  cass::Atomic<int> count(0);
+  cass::Atomic<bool> is_done(false);
+  {
+    cass::EpochPtr<Value> ptr(Value::Ptr(new Value(0, &count)));
+
+    uv_thread_t threads[NUM_READERS];
+    ReaderState states[NUM_READERS];
+    for (int i = 0; i < NUM_READERS; ++i) {
+      states[i].ptr = &ptr;
+      states[i].is_done = &is_done;
+      states[i].is_valid = true;
+      uv_thread_create(&threads[i], read, &states[i]);
+    }
+
+    for (int i = 1; i <= NUM_STORES; ++i) {
+      ptr.store(Value::Ptr(new Value(i, &count)));
+    }
+
+    is_done.store(true);
+    for (int i = 0; i < NUM_READERS; ++i) {
+      uv_thread_join(&threads[i]);
+      EXPECT_TRUE(states[i].is_valid);
+    }
+
+    EXPECT_EQ(NUM_STORES, ptr.load()->value);
+    EXPECT_EQ(1, count.load());
+  }
+  EXPECT_EQ(0, count.load());
+}
@@ -0,0 +1,96 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "buffer.hpp"
+#include "constants.hpp"
+#include "statement.hpp"
+
+static void on_release(void* data) {
+  ++*static_cast<int*>(data);
+}
+
+TEST(ExternalBufferUnitTest, Reference) {
+  const char data[] = "0123456789012345678901234567890123456789";
+  int released = 0;
+
+  {
+    cass::Buffer buf(new cass::ExternalBuffer(data, on_release, &released), sizeof(data));
+    EXPECT_TRUE(buf.is_external());
+    EXPECT_EQ(data, buf.data());
+    EXPECT_EQ(sizeof(data), buf.size());
+
+    cass::Buffer copy(buf);
+    EXPECT_EQ(data, copy.data());
+
+    cass::Buffer assigned(4);
+    assigned = buf;
+    EXPECT_EQ(data, assigned.data());
+
+    assigned = cass::Buffer(64); // Drops a reference
+    EXPECT_FALSE(assigned.is_external());
+    EXPECT_EQ(0, released);
+  }
+
+  EXPECT_EQ(1, released);
+}
+
+TEST(ExternalBufferUnitTest, BindStatement) {
+  const cass_byte_t data[] = { 1, 2, 3, 4, 5 };
+  int released = 0;
+
+  CassStatement* statement = cass_statement_new("INSERT", 1);
+  EXPECT_EQ(CASS_OK, cass_statement_bind_bytes_external(statement, 0,
+                                                        data, sizeof(data),
+                                                        on_release, &released));
+
+  const cass::AbstractData::Element& element = statement->from()->elements()[0];
+
+  // The value is encoded by reference
+  cass::BufferVec bufs;
+  EXPECT_EQ(sizeof(int32_t) + sizeof(data),
+            element.get_buffers(CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION, &bufs));
+  ASSERT_EQ(2u, bufs.size());
+  int32_t length = 0;
+  cass::decode_int32(bufs[0].data(), length);
+  EXPECT_EQ(static_cast<int32_t>(sizeof(data)), length);
+  EXPECT_EQ(reinterpret_cast<const char*>(data), bufs[1].data());
+
+  // A contiguous copy is used for lookups
+  cass::Buffer copy(element.get_buffer(CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION));
+  ASSERT_EQ(sizeof(int32_t) + sizeof(data), copy.size());
+  EXPECT_EQ(0, memcmp(copy.data() + sizeof(int32_t), data, sizeof(data)));
+
+  cass_statement_free(statement);
+  EXPECT_EQ(0, released); // Still referenced by the encoded buffers
+
+  bufs.clear();
+  EXPECT_EQ(1, released);
+}
+
+TEST(ExternalBufferUnitTest, BindInvalidIndex) {
+  const cass_byte_t data[] = { 1, 2, 3 };
+  int released = 0;
+
+  CassStatement* statement = cass_statement_new("INSERT", 1);
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+            cass_statement_bind_bytes_external(statement, 1,
+                                               data, sizeof(data),
+                                               on_release, &released));
+  EXPECT_EQ(1, released);
+  cass_statement_free(statement);
+}
@@ -0,0 +1,101 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "cassandra.h"
+#include "event_thread.hpp"
+
+struct TestExternalLoop : public cass::EventThread<int> {
+  TestExternalLoop()
+    : sum(0)
+    , is_after_run(false) { }
+
+  virtual void on_event(const int& event) {
+    sum += event;
+  }
+
+  virtual void on_after_run() {
+    is_after_run = true;
+  }
+
+  int sum;
+  bool is_after_run;
+};
+
+static void on_future_set(CassFuture* future, void* data) {
+  *static_cast<bool*>(data) = true;
+}
+
+TEST(ExternalEventLoopUnitTest, RunOnce)
+{
+  TestExternalLoop thread;
+  thread.set_run_externally(true);
+  ASSERT_EQ(0, thread.init(16));
+
+  EXPECT_FALSE(thread.is_running());
+  EXPECT_EQ(-1, thread.backend_fd());
+  EXPECT_FALSE(thread.run_once(true));
+
+  ASSERT_EQ(0, thread.run());
+  EXPECT_TRUE(thread.is_running());
+#ifndef _WIN32
+  EXPECT_GE(thread.backend_fd(), 0);
+#endif
+
+  for (int i = 1; i <= 10; ++i) {
+    EXPECT_TRUE(thread.send_event_async(i));
+  }
+  EXPECT_EQ(0, thread.sum); // Nothing runs until the loop is run
+  EXPECT_TRUE(thread.run_once(true));
+  EXPECT_EQ(55, thread.sum);
+
+  thread.close_handles();
+  while (thread.run_once(true)) { }
+  EXPECT_TRUE(thread.is_after_run);
+  EXPECT_FALSE(thread.is_running());
+}
+
+TEST(ExternalEventLoopUnitTest, SessionConnectError)
+{
+  CassCluster* cluster = cass_cluster_new();
+  // Nothing is listening on this port so the connection is refused
+  cass_cluster_set_contact_points(cluster, "127.0.0.1");
+  cass_cluster_set_port(cluster, 1);
+  cass_cluster_set_connect_timeout(cluster, 1000);
+  EXPECT_EQ(CASS_OK, cass_cluster_set_external_event_loop(cluster, cass_true));
+
+  CassSession* session = cass_session_new();
+  EXPECT_EQ(-1, cass_session_event_loop_fd(session));
+
+  bool is_set = false;
+  CassFuture* future = cass_session_connect(session, cluster);
+  EXPECT_EQ(CASS_OK, cass_future_set_callback(future, on_future_set, &is_set));
+
+  // The connection attempt only makes progress when the loop is run
+  EXPECT_FALSE(cass_future_ready(future));
+  // The session closes itself after a connection error so the loop can
+  // finish in the same iteration that completes the future.
+  while (!is_set && cass_session_event_loop_run(session, cass_false)) { }
+  EXPECT_TRUE(is_set);
+  EXPECT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, cass_future_error_code(future));
+  cass_future_free(future);
+
+  // Runs the loop until the session is closed
+  cass_session_free(session);
+  cass_cluster_free(cluster);
+}
@@ -0,0 +1,119 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "cassandra.h"
+#include "eytzinger_index.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+#include <stdio.h>
+#include <uv.h>
+
+static std::vector<int64_t> create_ring(size_t size, cass::Random* random) {
+  std::vector<int64_t> ring;
+  ring.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    ring.push_back(static_cast<int64_t>(random->next(CASS_UINT64_MAX)));
+  }
+  std::sort(ring.begin(), ring.end());
+  return ring;
+}
+
+TEST(EytzingerIndexUnitTest, Empty) {
+  cass::EytzingerIndex<int64_t> index;
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(0u, index.upper_bound(0));
+
+  index.build(std::vector<int64_t>());
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(0u, index.upper_bound(0));
+}
+
+TEST(EytzingerIndexUnitTest, UpperBound) {
+  // Every size up to a few complete trees plus duplicate values
+  for (size_t size = 1; size <= 70; ++size) {
+    std::vector<int64_t> sorted;
+    for (size_t i = 0; i < size; ++i) {
+      sorted.push_back(static_cast<int64_t>(i / 2) * 10);
+    }
+
+    cass::EytzingerIndex<int64_t> index;
+    index.build(sorted);
+    ASSERT_EQ(size, index.size());
+
+    for (int64_t value = -5; value <= static_cast<int64_t>(size) * 5 + 5; ++value) {
+      size_t expected = std::upper_bound(sorted.begin(), sorted.end(), value) - sorted.begin();
+      ASSERT_EQ(expected, index.upper_bound(value))
+          << "size " << size << " value " << value;
+    }
+  }
+}
+
+TEST(EytzingerIndexUnitTest, RandomRing) {
+  cass::Random random;
+  std::vector<int64_t> ring(create_ring(25000, &random));
+
+  cass::EytzingerIndex<int64_t> index;
+  index.build(ring);
+
+  for (int i = 0; i < 10000; ++i) {
+    int64_t token = static_cast<int64_t>(random.next(CASS_UINT64_MAX));
+    size_t expected = std::upper_bound(ring.begin(), ring.end(), token) - ring.begin();
+    ASSERT_EQ(expected, index.upper_bound(token));
+  }
+}
+
+// Compares lookups per second of the ring index to a binary search over the
+// sorted ring for increasing ring sizes. Run using:
+// cassandra-unit-tests --gtest_filter=*Benchmark* --gtest_also_run_disabled_tests
+TEST(EytzingerIndexUnitTest, DISABLED_Benchmark) {
+  const size_t num_lookups = 1000000;
+  cass::Random random;
+
+  std::vector<int64_t> tokens;
+  tokens.reserve(num_lookups);
+  for (size_t i = 0; i < num_lookups; ++i) {
+    tokens.push_back(static_cast<int64_t>(random.next(CASS_UINT64_MAX)));
+  }
+
+  printf("%12s %20s %20s\n", "ring size", "binary search/s", "eytzinger/s");
+  for (size_t size = 256; size <= 4 * 1024 * 1024; size *= 4) {
+    std::vector<int64_t> ring(create_ring(size, &random));
+    cass::EytzingerIndex<int64_t> index;
+    index.build(ring);
+
+    size_t sum = 0;
+    uint64_t start = uv_hrtime();
+    for (size_t i = 0; i < num_lookups; ++i) {
+      sum += std::upper_bound(ring.begin(), ring.end(), tokens[i]) - ring.begin();
+    }
+    uint64_t binary_search_ns = uv_hrtime() - start;
+
+    start = uv_hrtime();
+    for (size_t i = 0; i < num_lookups; ++i) {
+      sum -= index.upper_bound(tokens[i]);
+    }
+    uint64_t eytzinger_ns = uv_hrtime() - start;
+
+    EXPECT_EQ(0u, sum);
+    printf("%12u %20.0f %20.0f\n",
+           static_cast<unsigned int>(size),
+           num_lookups * 1e9 / binary_search_ns,
+           num_lookups * 1e9 / eytzinger_ns);
+  }
+}
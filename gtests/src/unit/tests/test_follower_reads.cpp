@@ -0,0 +1,118 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "dc_aware_policy.hpp"
+#include "partition_aware_policy.hpp"
+
+static cass::Host::Ptr create_host(const std::string& ip,
+                                   const std::string& rack,
+                                   const std::string& dc,
+                                   int64_t latency_ns = -1) {
+  cass::Host::Ptr host(new cass::Host(cass::Address(ip, 9042), false));
+  host->set_rack_and_dc(rack, dc);
+  host->set_up();
+  if (latency_ns >= 0) {
+    host->enable_latency_tracking(100LL * 1000LL * 1000LL, 0);
+    host->update_latency(latency_ns);
+  }
+  return host;
+}
+
+TEST(FollowerReadsUnitTest, SingleReplica) {
+  cass::DCAwarePolicy policy("dc1", 0, false);
+  cass::HostVec replicas;
+  replicas.push_back(create_host("127.0.0.1", "rack1", "dc1"));
+
+  cass::PartitionAwarePolicy::order_for_follower_read(&policy, "rack1", true, &replicas);
+  ASSERT_EQ(1u, replicas.size());
+  EXPECT_EQ(cass::Address("127.0.0.1", 9042), replicas[0]->address());
+}
+
+TEST(FollowerReadsUnitTest, LocalRackThenLocalDcThenLeader) {
+  cass::DCAwarePolicy policy("dc1", 0, false);
+  cass::HostVec replicas;
+  replicas.push_back(create_host("127.0.0.1", "rack1", "dc1")); // Leader
+  replicas.push_back(create_host("127.0.0.2", "rack1", "dc2")); // Ignored
+  replicas.push_back(create_host("127.0.0.3", "rack2", "dc1"));
+  replicas.push_back(create_host("127.0.0.4", "rack1", "dc1"));
+
+  cass::PartitionAwarePolicy::order_for_follower_read(&policy, "rack1", true, &replicas);
+  ASSERT_EQ(3u, replicas.size());
+  EXPECT_EQ(cass::Address("127.0.0.4", 9042), replicas[0]->address());
+  EXPECT_EQ(cass::Address("127.0.0.3", 9042), replicas[1]->address());
+  EXPECT_EQ(cass::Address("127.0.0.1", 9042), replicas[2]->address());
+}
+
+TEST(FollowerReadsUnitTest, RemoteFollowersLeftToChildPolicy) {
+  cass::DCAwarePolicy policy("dc1", 1, false);
+  cass::Host::Ptr remote(create_host("127.0.0.2", "rack1", "dc2"));
+  policy.on_add(remote);
+  ASSERT_EQ(CASS_HOST_DISTANCE_REMOTE, policy.distance(remote));
+
+  cass::HostVec replicas;
+  replicas.push_back(create_host("127.0.0.1", "rack1", "dc1")); // Leader
+  replicas.push_back(remote);
+  replicas.push_back(create_host("127.0.0.3", "rack1", "dc1"));
+
+  cass::PartitionAwarePolicy::order_for_follower_read(&policy, "rack1", true, &replicas);
+  ASSERT_EQ(2u, replicas.size());
+  EXPECT_EQ(cass::Address("127.0.0.3", 9042), replicas[0]->address());
+  EXPECT_EQ(cass::Address("127.0.0.1", 9042), replicas[1]->address());
+}
+
+TEST(FollowerReadsUnitTest, IgnoredLeader) {
+  cass::DCAwarePolicy policy("dc1", 0, false);
+  cass::HostVec replicas;
+  replicas.push_back(create_host("127.0.0.1", "rack1", "dc2")); // Leader
+  replicas.push_back(create_host("127.0.0.2", "rack1", "dc1"));
+
+  cass::PartitionAwarePolicy::order_for_follower_read(&policy, "rack1", true, &replicas);
+  ASSERT_EQ(1u, replicas.size());
+  EXPECT_EQ(cass::Address("127.0.0.2", 9042), replicas[0]->address());
+}
+
+TEST(FollowerReadsUnitTest, MissingLeader) {
+  cass::DCAwarePolicy policy("dc1", 0, false);
+  cass::HostVec replicas;
+  // The leader isn't a known host so all the replicas are followers
+  replicas.push_back(create_host("127.0.0.2", "rack2", "dc1"));
+  replicas.push_back(create_host("127.0.0.3", "rack1", "dc1"));
+
+  cass::PartitionAwarePolicy::order_for_follower_read(&policy, "rack1", false, &replicas);
+  ASSERT_EQ(2u, replicas.size());
+  EXPECT_EQ(cass::Address("127.0.0.3", 9042), replicas[0]->address());
+  EXPECT_EQ(cass::Address("127.0.0.2", 9042), replicas[1]->address());
+}
+
+TEST(FollowerReadsUnitTest, OrderedByLatency) {
+  cass::DCAwarePolicy policy("dc1", 0, false);
+  cass::HostVec replicas;
+  replicas.push_back(create_host("127.0.0.1", "rack1", "dc1", 1000)); // Leader
+  replicas.push_back(create_host("127.0.0.2", "rack2", "dc1"));
+  replicas.push_back(create_host("127.0.0.3", "rack2", "dc1", 3000));
+  replicas.push_back(create_host("127.0.0.4", "rack2", "dc1", 2000));
+
+  // No local rack, so the followers are only ordered by latency with
+  // unmeasured hosts last
+  cass::PartitionAwarePolicy::order_for_follower_read(&policy, "", true, &replicas);
+  ASSERT_EQ(4u, replicas.size());
+  EXPECT_EQ(cass::Address("127.0.0.4", 9042), replicas[0]->address());
+  EXPECT_EQ(cass::Address("127.0.0.3", 9042), replicas[1]->address());
+  EXPECT_EQ(cass::Address("127.0.0.2", 9042), replicas[2]->address());
+  EXPECT_EQ(cass::Address("127.0.0.1", 9042), replicas[3]->address());
+}
@@ -0,0 +1,146 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "atomic.hpp"
+#include "host.hpp"
+#include "host_id_set.hpp"
+#include "round_robin_policy.hpp"
+#include "whitelist_policy.hpp"
+
+#include <stdio.h>
+#include <uv.h>
+
+#define NUM_HOSTS 2000
+
+static cass::Host::Ptr create_host(const char* ip) {
+  cass::Address address;
+  cass::Address::from_string(ip, 9042, &address);
+  return cass::Host::Ptr(new cass::Host(address, false));
+}
+
+TEST(HostIdSetUnitTest, Simple) {
+  cass::HostIdSet set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_FALSE(set.contains(0));
+  EXPECT_FALSE(set.contains(1000));
+
+  set.add(0);
+  set.add(63);
+  set.add(64);
+  set.add(1000);
+  set.add(1000);
+  EXPECT_EQ(4u, set.size());
+  EXPECT_TRUE(set.contains(0));
+  EXPECT_TRUE(set.contains(63));
+  EXPECT_TRUE(set.contains(64));
+  EXPECT_TRUE(set.contains(1000));
+  EXPECT_FALSE(set.contains(1));
+  EXPECT_FALSE(set.contains(999));
+
+  set.remove(63);
+  set.remove(63);
+  set.remove(5000);
+  EXPECT_EQ(3u, set.size());
+  EXPECT_FALSE(set.contains(63));
+
+  set.clear();
+  EXPECT_TRUE(set.empty());
+  EXPECT_FALSE(set.contains(0));
+}
+
+TEST(HostIdSetUnitTest, HostIds) {
+  cass::Host::Ptr host1(create_host("127.0.0.1"));
+  cass::Host::Ptr host2(create_host("127.0.0.2"));
+  EXPECT_NE(host1->id(), host2->id());
+  EXPECT_EQ("127.0.0.1", host1->address_string());
+
+  // The IDs of freed hosts are reused
+  uint32_t id = host1->id();
+  host1.reset();
+  cass::Host::Ptr host3(create_host("127.0.0.3"));
+  EXPECT_EQ(id, host3->id());
+
+  cass::HostIdSet set;
+  set.add(host2->id());
+  EXPECT_TRUE(set.contains(host2->id()));
+  EXPECT_FALSE(set.contains(host3->id()));
+}
+
+struct DistanceState {
+  const cass::ListPolicy* policy;
+  cass::Host::Ptr host;
+  cass::Atomic<bool>* is_started;
+  cass::Atomic<bool>* is_done;
+  bool is_valid;
+};
+
+static void check_distance(void* arg) {
+  DistanceState* state = static_cast<DistanceState*>(arg);
+  state->is_started->store(true);
+  while (!state->is_done->load()) {
+    if (state->policy->distance(state->host) != CASS_HOST_DISTANCE_LOCAL) {
+      state->is_valid = false;
+      return;
+    }
+  }
+}
+
+TEST(HostIdSetUnitTest, DistanceDuringAdd) {
+  cass::ContactPointList whitelist;
+  std::vector<cass::Host::Ptr> hosts;
+  for (int i = 0; i < NUM_HOSTS; ++i) {
+    char ip[32];
+    sprintf(ip, "127.0.%d.%d", i / 250, i % 250 + 1);
+    whitelist.push_back(ip);
+    hosts.push_back(create_host(ip));
+  }
+
+  cass::WhitelistPolicy policy(new cass::RoundRobinPolicy(), whitelist);
+  cass::HostMap initial;
+  initial[hosts[0]->address()] = hosts[0];
+  cass::Random random;
+  policy.init(hosts[0], initial, &random);
+
+  cass::Atomic<bool> is_started(false);
+  cass::Atomic<bool> is_done(false);
+  DistanceState state;
+  state.policy = &policy;
+  state.host = hosts[0];
+  state.is_started = &is_started;
+  state.is_done = &is_done;
+  state.is_valid = true;
+
+  uv_thread_t thread;
+  uv_thread_create(&thread, check_distance, &state);
+  while (!is_started.load()) { }
+
+  // Adding hosts grows the bitset while the other thread reads it
+  for (int i = 1; i < NUM_HOSTS; ++i) {
+    policy.on_add(hosts[i]);
+  }
+  for (int i = NUM_HOSTS - 1; i > 0; --i) {
+    policy.on_remove(hosts[i]);
+  }
+
+  is_done.store(true);
+  uv_thread_join(&thread);
+
+  EXPECT_TRUE(state.is_valid);
+  EXPECT_EQ(CASS_HOST_DISTANCE_LOCAL, policy.distance(hosts[0]));
+  EXPECT_EQ(CASS_HOST_DISTANCE_IGNORE, policy.distance(hosts[1]));
+}
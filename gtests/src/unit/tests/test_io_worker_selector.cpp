@@ -0,0 +1,167 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "io_worker_selector.hpp"
+
+namespace {
+
+// A bounded queue that's only drained by the test
+struct TestQueue {
+  explicit TestQueue(size_t capacity)
+    : capacity(capacity) { }
+
+  bool enqueue(int request) {
+    if (requests.size() >= capacity) return false;
+    requests.push_back(request);
+    return true;
+  }
+
+  size_t capacity;
+  std::vector<int> requests;
+};
+
+// Counts its requests the same way as the I/O worker
+class TestWorker {
+public:
+  explicit TestWorker(size_t capacity = 16)
+    : queue_(capacity) { }
+
+  int outstanding_request_count() const {
+    return outstanding_requests_.count();
+  }
+
+  bool execute(int request) {
+    return outstanding_requests_.enqueue(&queue_, request);
+  }
+
+  // Runs and finishes the oldest queued request
+  void finish() {
+    queue_.requests.erase(queue_.requests.begin());
+    outstanding_requests_.finish();
+  }
+
+  const std::vector<int>& requests() const { return queue_.requests; }
+
+private:
+  TestQueue queue_;
+  cass::OutstandingRequests outstanding_requests_;
+};
+
+typedef cass::IOWorkerSelector<TestWorker*> Selector;
+
+} // namespace
+
+TEST(IOWorkerSelectorUnitTest, TiesRotate) {
+  TestWorker workers[3];
+  Selector::WorkerVec vec;
+  for (size_t i = 0; i < 3; ++i) vec.push_back(&workers[i]);
+  Selector selector;
+
+  // Idle workers are used round-robin
+  EXPECT_EQ(0u, selector.select(vec));
+  EXPECT_EQ(1u, selector.select(vec));
+  EXPECT_EQ(2u, selector.select(vec));
+  EXPECT_EQ(0u, selector.select(vec));
+
+  // As are workers with the same load
+  selector.reset();
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_TRUE(selector.execute(vec, i));
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(2u, workers[i].requests().size());
+    EXPECT_EQ(static_cast<int>(i), workers[i].requests()[0]);
+    EXPECT_EQ(static_cast<int>(i + 3), workers[i].requests()[1]);
+  }
+}
+
+TEST(IOWorkerSelectorUnitTest, StalledWorkerSkipped) {
+  TestWorker workers[3];
+  Selector::WorkerVec vec;
+  for (size_t i = 0; i < 3; ++i) vec.push_back(&workers[i]);
+  Selector selector;
+
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(selector.execute(vec, i));
+  }
+
+  // The first worker is stalled while the others keep finishing requests
+  for (int i = 3; i < 12; ++i) {
+    workers[1].finish();
+    workers[2].finish();
+    ASSERT_TRUE(selector.execute(vec, i));
+    ASSERT_TRUE(selector.execute(vec, i));
+  }
+  EXPECT_EQ(1u, workers[0].requests().size());
+  EXPECT_EQ(1, workers[0].outstanding_request_count());
+
+  // It's used again once it catches up
+  workers[0].finish();
+  EXPECT_EQ(0, workers[0].outstanding_request_count());
+  EXPECT_EQ(0u, selector.select(vec));
+}
+
+TEST(IOWorkerSelectorUnitTest, QueueFull) {
+  TestWorker full(1);
+  TestWorker other;
+  Selector::WorkerVec vec;
+  vec.push_back(&full);
+  vec.push_back(&other);
+  Selector selector;
+
+  ASSERT_TRUE(full.execute(0));
+  EXPECT_EQ(1, full.outstanding_request_count());
+
+  // The count is taken back when the request can't be queued
+  EXPECT_FALSE(full.execute(1));
+  EXPECT_EQ(1, full.outstanding_request_count());
+
+  // The request goes to the next worker when the least loaded worker is
+  // full
+  other.execute(2);
+  ASSERT_TRUE(selector.execute(vec, 3));
+  EXPECT_EQ(1, full.outstanding_request_count());
+  EXPECT_EQ(2, other.outstanding_request_count());
+
+  // The request isn't counted anywhere if none of the workers can take it
+  Selector::WorkerVec full_vec(1, &full);
+  EXPECT_FALSE(selector.execute(full_vec, 4));
+  EXPECT_EQ(1, full.outstanding_request_count());
+}
+
+TEST(IOWorkerSelectorUnitTest, RequestFinished) {
+  TestWorker workers[2];
+  Selector::WorkerVec vec;
+  vec.push_back(&workers[0]);
+  vec.push_back(&workers[1]);
+  Selector selector;
+
+  ASSERT_TRUE(selector.execute(vec, 0));
+  ASSERT_TRUE(selector.execute(vec, 1));
+  ASSERT_TRUE(selector.execute(vec, 2));
+  EXPECT_EQ(2, workers[0].outstanding_request_count());
+  EXPECT_EQ(1, workers[1].outstanding_request_count());
+
+  workers[0].finish();
+  workers[0].finish();
+  EXPECT_EQ(0, workers[0].outstanding_request_count());
+
+  // The next request goes to the worker whose requests finished even though
+  // it's the other worker's turn
+  EXPECT_EQ(0u, selector.select(vec));
+}
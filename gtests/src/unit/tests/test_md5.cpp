@@ -18,6 +18,11 @@
 
 #include "md5.hpp"
 
+#include <uv.h>
+
+#include <string>
+#include <vector>
+
 static bool hash_equal(uint8_t* hash, const char* hash_str) {
   const char* p = hash_str;
   for (size_t i = 0; i < 16; ++i) {
@@ -36,7 +41,25 @@ static bool check_hash(const char* data, const char* hash_str) {
   m.update(reinterpret_cast<const uint8_t*>(data), strlen(data));
   uint8_t hash[16];
   m.final(hash);
-  return hash_equal(hash, hash_str);
+
+  uint8_t one_shot_hash[16];
+  cass::Md5::hash(reinterpret_cast<const uint8_t*>(data), strlen(data), one_shot_hash);
+
+  return hash_equal(hash, hash_str) && hash_equal(one_shot_hash, hash_str);
+}
+
+static std::string create_message(size_t size, size_t seed) {
+  std::string message(size, '\0');
+  for (size_t i = 0; i < size; ++i) {
+    message[i] = static_cast<char>((i * 31 + seed * 7) & 0xFF);
+  }
+  return message;
+}
+
+static void streaming_hash(const std::string& message, uint8_t* result) {
+  cass::Md5 m;
+  m.update(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+  m.final(result);
 }
 
 TEST(Md5UnitTest, Simple) {
@@ -64,3 +87,79 @@ TEST(Md5UnitTest, Simple) {
 
   EXPECT_TRUE(check_hash(big_str, "15355dec7c48faeb01b46366d90be0be"));
 }
+
+TEST(Md5UnitTest, HashMany) {
+  // Single block messages, messages at the padding boundaries and multiple
+  // block messages, in counts that aren't multiples of the SIMD lane count
+  std::vector<std::string> messages;
+  for (size_t size = 0; size <= 130; ++size) {
+    messages.push_back(create_message(size, messages.size()));
+    messages.push_back(create_message(size % 20, messages.size()));
+  }
+
+  for (size_t count = 0; count <= messages.size(); count += 37) {
+    std::vector<const uint8_t*> data;
+    std::vector<size_t> sizes;
+    for (size_t i = 0; i < count; ++i) {
+      data.push_back(reinterpret_cast<const uint8_t*>(messages[i].data()));
+      sizes.push_back(messages[i].size());
+    }
+
+    std::vector<uint8_t> results(16 * count + 1);
+    cass::Md5::hash_many(count > 0 ? &data[0] : NULL,
+                         count > 0 ? &sizes[0] : NULL,
+                         count, &results[0]);
+
+    for (size_t i = 0; i < count; ++i) {
+      uint8_t expected[16];
+      streaming_hash(messages[i], expected);
+      EXPECT_EQ(0, memcmp(expected, &results[16 * i], 16))
+          << "Message " << i << " of size " << messages[i].size();
+    }
+  }
+}
+
+// Compares the throughput of the streaming, one-shot and multi-buffer
+// hashes of routing key sized messages. Run using:
+// cassandra-unit-tests --gtest_filter=*Benchmark* --gtest_also_run_disabled_tests
+TEST(Md5UnitTest, DISABLED_Benchmark) {
+  const size_t num_messages = 1000000;
+
+  printf("%8s %20s %20s %20s\n", "size", "streaming/s", "one-shot/s", "multi-buffer/s");
+  const size_t message_sizes[] = { 8, 16, 32, 55, 100 };
+  for (size_t s = 0; s < sizeof(message_sizes) / sizeof(message_sizes[0]); ++s) {
+    std::vector<std::string> messages;
+    std::vector<const uint8_t*> data;
+    std::vector<size_t> sizes;
+    for (size_t i = 0; i < num_messages; ++i) {
+      messages.push_back(create_message(message_sizes[s], i));
+    }
+    for (size_t i = 0; i < num_messages; ++i) {
+      data.push_back(reinterpret_cast<const uint8_t*>(messages[i].data()));
+      sizes.push_back(messages[i].size());
+    }
+    std::vector<uint8_t> results(16 * num_messages);
+
+    uint64_t start = uv_hrtime();
+    for (size_t i = 0; i < num_messages; ++i) {
+      streaming_hash(messages[i], &results[16 * i]);
+    }
+    uint64_t streaming_ns = uv_hrtime() - start;
+
+    start = uv_hrtime();
+    for (size_t i = 0; i < num_messages; ++i) {
+      cass::Md5::hash(data[i], sizes[i], &results[16 * i]);
+    }
+    uint64_t one_shot_ns = uv_hrtime() - start;
+
+    start = uv_hrtime();
+    cass::Md5::hash_many(&data[0], &sizes[0], num_messages, &results[0]);
+    uint64_t multi_buffer_ns = uv_hrtime() - start;
+
+    printf("%8u %20.0f %20.0f %20.0f\n",
+           static_cast<unsigned int>(message_sizes[s]),
+           num_messages * 1e9 / streaming_ns,
+           num_messages * 1e9 / one_shot_ns,
+           num_messages * 1e9 / multi_buffer_ns);
+  }
+}
@@ -0,0 +1,121 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "page_sizer.hpp"
+
+#define MS (1000ULL * 1000ULL)
+
+static cass::PageSizer::Settings settings(uint64_t target_page_bytes,
+                                          uint64_t target_latency_ns = 0) {
+  cass::PageSizer::Settings settings;
+  settings.target_page_bytes = target_page_bytes;
+  settings.target_latency_ns = target_latency_ns;
+  settings.min_page_size = 10;
+  settings.max_page_size = 100000;
+  return settings;
+}
+
+TEST(PageSizerUnitTest, TargetBytes) {
+  cass::PageSizer sizer(settings(1024 * 1024), 5000);
+  EXPECT_EQ(5000, sizer.page_size());
+
+  // Wide rows: 5000 rows of 10KB are much larger than the target
+  sizer.update(5000, 5000 * 10 * 1024, 0);
+  EXPECT_EQ(102, sizer.page_size());
+
+  // Narrow rows: the page size grows, at most doubling each page
+  sizer.update(102, 102 * 10, 0);
+  EXPECT_EQ(204, sizer.page_size());
+  for (int i = 0; i < 20; ++i) {
+    sizer.update(sizer.page_size(), sizer.page_size() * 10, 0);
+  }
+  EXPECT_EQ(100000, sizer.page_size()); // Maximum
+}
+
+TEST(PageSizerUnitTest, TargetLatency) {
+  cass::PageSizer sizer(settings(1024 * 1024 * 1024, 100 * MS), 1000);
+
+  // 1000 rows in 400ms
+  sizer.update(1000, 1000 * 100, 400 * MS);
+  EXPECT_EQ(250, sizer.page_size());
+
+  // Results without a size (cached) only use the latency
+  sizer.update(250, 0, 50 * MS);
+  EXPECT_EQ(500, sizer.page_size());
+
+  sizer.update(10, 1000, 10000 * MS);
+  EXPECT_EQ(10, sizer.page_size()); // Minimum
+}
+
+TEST(PageSizerUnitTest, Budget) {
+  cass::PagingBudget::Ptr budget(new cass::PagingBudget(150 * 1000));
+
+  // 100 bytes per row
+  cass::PageSizer first(settings(100 * 1000), 1000);
+  cass::PageSizer second(settings(100 * 1000), 1000);
+
+  cass::PagingReservation first_reservation;
+  EXPECT_EQ(1000, first.reserve(budget, &first_reservation));
+  EXPECT_EQ(100001u, budget->in_use());
+
+  // Only part of the page fits in the budget. The smaller page size is only
+  // used by this execution.
+  cass::PagingReservation second_reservation;
+  EXPECT_EQ(499, second.reserve(budget, &second_reservation));
+  EXPECT_EQ(1000, second.page_size());
+  EXPECT_EQ(150000u, budget->in_use());
+
+  // Receiving the page releases its reservation
+  first_reservation.release();
+  second_reservation.release();
+  EXPECT_EQ(0u, budget->in_use());
+
+  // The minimum page size is used when the budget is exhausted
+  budget->reserve(150 * 1000, 0);
+  EXPECT_EQ(10, second.reserve(budget, &second_reservation));
+  EXPECT_EQ(151001u, budget->in_use());
+  second_reservation.release();
+  budget->release(150 * 1000);
+  EXPECT_EQ(0u, budget->in_use());
+}
+
+TEST(PageSizerUnitTest, Reservation) {
+  cass::PagingBudget::Ptr budget(new cass::PagingBudget(1000));
+  cass::PageSizer sizer(settings(100 * 1000), 1000);
+
+  {
+    cass::PagingReservation reservation;
+    EXPECT_EQ(10, sizer.reserve(budget, &reservation));
+    EXPECT_EQ(1001u, budget->in_use());
+
+    // Concurrent executions of the same statement reserve separately
+    cass::PagingReservation other;
+    EXPECT_EQ(10, sizer.reserve(budget, &other));
+    EXPECT_EQ(2002u, budget->in_use());
+
+    // Taking over a reservation (e.g. by a request handler) keeps it
+    cass::PagingReservation taken;
+    taken.take(&other);
+    EXPECT_EQ(0u, other.reserved());
+    EXPECT_EQ(1001u, taken.reserved());
+    EXPECT_EQ(2002u, budget->in_use());
+  }
+
+  // Reservations are released when they're destroyed
+  EXPECT_EQ(0u, budget->in_use());
+}
@@ -0,0 +1,160 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "execute_request.hpp"
+#include "partition_stats.hpp"
+#include "test_prepared_utils.hpp"
+
+static cass::PartitionStats::Sample create_sample(const std::string& table,
+                                                  int64_t token,
+                                                  int32_t tablet_start = -1,
+                                                  int32_t tablet_end = -1) {
+  cass::PartitionStats::Sample sample;
+  sample.table = table;
+  sample.token = token;
+  if (tablet_start >= 0) {
+    sample.has_tablet = true;
+    sample.tablet_start = tablet_start;
+    sample.tablet_end = tablet_end;
+  }
+  return sample;
+}
+
+TEST(PartitionStatsUnitTest, Sampling) {
+  cass::PartitionStats stats(4, 10);
+  int sampled = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (stats.should_sample()) sampled++;
+  }
+  EXPECT_EQ(25, sampled);
+}
+
+TEST(PartitionStatsUnitTest, TopPartitions) {
+  cass::PartitionStats stats(1, 10);
+  for (int i = 0; i < 3; ++i) {
+    stats.record(create_sample("ks.t1", 1), 100, 1000);
+  }
+  stats.record(create_sample("ks.t1", 2), 10, 3000);
+  for (int i = 0; i < 2; ++i) {
+    stats.record(create_sample("ks.t2", 1), 50, 2000);
+  }
+
+  cass::PartitionStats::EntryVec entries;
+  stats.top_partitions(&entries);
+  ASSERT_EQ(3u, entries.size());
+
+  EXPECT_EQ("ks.t1", entries[0].table);
+  EXPECT_EQ(1, entries[0].start);
+  EXPECT_EQ(3u, entries[0].count);
+  EXPECT_EQ(0u, entries[0].error);
+  EXPECT_EQ(300u, entries[0].bytes);
+  EXPECT_EQ(1000u, entries[0].mean_latency_ns());
+
+  EXPECT_EQ("ks.t2", entries[1].table);
+  EXPECT_EQ(2u, entries[1].count);
+
+  EXPECT_EQ("ks.t1", entries[2].table);
+  EXPECT_EQ(2, entries[2].start);
+  EXPECT_EQ(1u, entries[2].count);
+
+  // No tablets are known
+  stats.top_tablets(&entries);
+  EXPECT_TRUE(entries.empty());
+}
+
+TEST(PartitionStatsUnitTest, Tablets) {
+  cass::PartitionStats stats(1, 10);
+  stats.record(create_sample("ks.t", 0x10, 0x0, 0x8000), 0, 0);
+  stats.record(create_sample("ks.t", 0x20, 0x0, 0x8000), 0, 0);
+  stats.record(create_sample("ks.t", 0x9000, 0x8000, 0x10000), 0, 0);
+
+  cass::PartitionStats::EntryVec entries;
+  stats.top_tablets(&entries);
+  ASSERT_EQ(2u, entries.size());
+  EXPECT_EQ(0x0, entries[0].start);
+  EXPECT_EQ(0x8000, entries[0].end);
+  EXPECT_EQ(2u, entries[0].count);
+  EXPECT_EQ(0x8000, entries[1].start);
+  EXPECT_EQ(0x10000, entries[1].end);
+  EXPECT_EQ(1u, entries[1].count);
+}
+
+TEST(PartitionStatsUnitTest, BoundedEntries) {
+  cass::PartitionStats stats(1, 2);
+  for (int i = 0; i < 5; ++i) {
+    stats.record(create_sample("ks.t", 1), 0, 0);
+  }
+  stats.record(create_sample("ks.t", 2), 0, 0);
+
+  // Replaces the entry with the lowest count
+  stats.record(create_sample("ks.t", 3), 0, 10);
+
+  cass::PartitionStats::EntryVec entries;
+  stats.top_partitions(&entries);
+  ASSERT_EQ(2u, entries.size());
+  EXPECT_EQ(1, entries[0].start);
+  EXPECT_EQ(5u, entries[0].count);
+  EXPECT_EQ(3, entries[1].start);
+  EXPECT_EQ(2u, entries[1].count);
+  EXPECT_EQ(1u, entries[1].error);
+  EXPECT_EQ(10u, entries[1].mean_latency_ns());
+
+  stats.reset();
+  stats.top_partitions(&entries);
+  EXPECT_TRUE(entries.empty());
+}
+
+TEST(PartitionStatsUnitTest, SamplePartitioner) {
+  ColumnMetadataVec columns;
+  columns.push_back(ColumnMetadata("key", cass::DataType::ConstPtr(
+                                     new cass::DataType(CASS_VALUE_TYPE_VARCHAR))));
+  cass::Prepared::ConstPtr prepared(create_prepared("id", columns,
+                                                    std::vector<uint16_t>(1, 0),
+                                                    "ks", "t"));
+  cass::SharedRefPtr<cass::ExecuteRequest> request(new cass::ExecuteRequest(prepared.get()));
+  cass_statement_bind_string(CassStatement::to(request.get()), 0, "abc");
+
+  cass::TableSplitMetadata::MapPtr partitions(new cass::TableSplitMetadata::Map());
+  cass::Metadata::SchemaSnapshot schema(
+        CASS_PREPARED_PROTOCOL_VERSION, cass::VersionNumber(3, 0, 0),
+        cass::Metadata::PublishedSchema::Ptr(
+          new cass::Metadata::PublishedSchema(0, cass::KeyspaceMetadata::Map(),
+                                              partitions)));
+
+  std::string routing_key;
+  ASSERT_TRUE(request->get_routing_key(&routing_key));
+
+  // The token is found using the token map's partitioner
+  cass::ScopedPtr<cass::TokenMap> murmur3(
+        cass::TokenMap::from_partitioner(cass::Murmur3Partitioner::name()));
+  cass::PartitionStats::Sample sample;
+  ASSERT_TRUE(cass::PartitionStats::make_sample(request.get(), schema,
+                                                murmur3.get(), &sample));
+  EXPECT_EQ("ks.t", sample.table);
+  EXPECT_EQ(cass::Murmur3Partitioner::hash(routing_key), sample.token);
+  EXPECT_FALSE(sample.has_tablet);
+
+  // Partitioners without 64-bit tokens and unknown partitioners aren't
+  // sampled
+  cass::ScopedPtr<cass::TokenMap> random(
+        cass::TokenMap::from_partitioner(cass::RandomPartitioner::name()));
+  EXPECT_FALSE(cass::PartitionStats::make_sample(request.get(), schema,
+                                                 random.get(), &sample));
+  EXPECT_FALSE(cass::PartitionStats::make_sample(request.get(), schema,
+                                                 NULL, &sample));
+}
@@ -0,0 +1,145 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "persistent_map.hpp"
+#include "random.hpp"
+
+#include <map>
+#include <sstream>
+#include <string>
+
+typedef cass::PersistentMap<std::string, int> Map;
+typedef std::map<std::string, int> ExpectedMap;
+
+static std::string key(int i) {
+  std::ostringstream ss;
+  ss << "key" << i;
+  return ss.str();
+}
+
+static void expect_equal(const ExpectedMap& expected, const Map& map) {
+  ASSERT_EQ(expected.size(), map.size());
+  Map::const_iterator i = map.begin();
+  for (ExpectedMap::const_iterator j = expected.begin(); j != expected.end(); ++j, ++i) {
+    ASSERT_TRUE(i != map.end());
+    EXPECT_EQ(j->first, i->first);
+    EXPECT_EQ(j->second, i->second);
+  }
+  EXPECT_TRUE(i == map.end());
+}
+
+TEST(PersistentMapUnitTest, Empty) {
+  Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.begin() == map.end());
+  EXPECT_TRUE(map.find("abc") == map.end());
+  EXPECT_TRUE(map.find_mutable("abc") == NULL);
+  EXPECT_EQ(0u, map.erase("abc"));
+}
+
+TEST(PersistentMapUnitTest, InsertFindErase) {
+  Map map;
+  EXPECT_TRUE(map.insert("b", 2));
+  EXPECT_TRUE(map.insert("a", 1));
+  EXPECT_FALSE(map.insert("a", 100));
+  map["c"] = 3;
+  map["a"] += 10;
+
+  ASSERT_EQ(3u, map.size());
+  EXPECT_EQ(11, map.find("a")->second);
+  EXPECT_EQ("b", map.find("b")->first);
+  EXPECT_TRUE(map.find("d") == map.end());
+
+  // Iteration continues in order from a found entry
+  Map::const_iterator i = map.find("b");
+  ++i;
+  ASSERT_TRUE(i != map.end());
+  EXPECT_EQ("c", i->first);
+  EXPECT_TRUE(++i == map.end());
+
+  EXPECT_EQ(1u, map.erase("b"));
+  EXPECT_EQ(0u, map.erase("b"));
+  EXPECT_EQ(2u, map.size());
+  EXPECT_TRUE(map.find("b") == map.end());
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(PersistentMapUnitTest, Random) {
+  cass::Random random;
+  Map map;
+  ExpectedMap expected;
+
+  for (int i = 0; i < 10000; ++i) {
+    std::string k(key(static_cast<int>(random.next(500))));
+    switch (random.next(3)) {
+      case 0:
+        map[k] = i;
+        expected[k] = i;
+        break;
+      case 1:
+        EXPECT_EQ(expected.erase(k), map.erase(k));
+        break;
+      default:
+        EXPECT_EQ(expected.find(k) != expected.end(), map.find(k) != map.end());
+        break;
+    }
+  }
+
+  expect_equal(expected, map);
+}
+
+TEST(PersistentMapUnitTest, Snapshots) {
+  cass::Random random;
+  Map map;
+  ExpectedMap expected;
+
+  std::vector<Map> snapshots;
+  std::vector<ExpectedMap> expected_snapshots;
+
+  for (int i = 0; i < 2000; ++i) {
+    std::string k(key(static_cast<int>(random.next(200))));
+    if (random.next(4) == 0) {
+      map.erase(k);
+      expected.erase(k);
+    } else {
+      map[k] = i;
+      expected[k] = i;
+    }
+
+    if (i % 100 == 0) {
+      snapshots.push_back(map);
+      expected_snapshots.push_back(expected);
+    }
+  }
+
+  // Updates to the map must not be visible in the earlier copies
+  expect_equal(expected, map);
+  for (size_t i = 0; i < snapshots.size(); ++i) {
+    expect_equal(expected_snapshots[i], snapshots[i]);
+  }
+
+  // Nor must updates to a copy be visible in the map
+  Map copy(map);
+  copy.clear();
+  *map.find_mutable(expected.begin()->first) = -1;
+  expected.begin()->second = -1;
+  expect_equal(expected, map);
+  EXPECT_TRUE(copy.empty());
+}
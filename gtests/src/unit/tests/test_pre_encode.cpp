@@ -0,0 +1,117 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "config.hpp"
+#include "prepared.hpp"
+#include "query_request.hpp"
+#include "request_callback.hpp"
+
+class TestRequestCallback : public cass::RequestCallback {
+public:
+  TestRequestCallback(const cass::RequestWrapper& wrapper)
+    : cass::RequestCallback(wrapper) { }
+
+  std::string encode_frame(int version, size_t* num_bufs = NULL) {
+    cass::BufferVec bufs;
+    int32_t length = encode(version, 0x00, &bufs);
+    std::string frame;
+    for (cass::BufferVec::const_iterator i = bufs.begin(),
+         end = bufs.end(); i != end; ++i) {
+      frame.append(i->data(), i->size());
+    }
+    EXPECT_EQ(static_cast<size_t>(length), frame.size());
+    if (num_bufs) *num_bufs = bufs.size();
+    return frame;
+  }
+
+private:
+  virtual void on_start() { }
+  virtual void on_retry_current_host() { }
+  virtual void on_retry_next_host() { }
+  virtual void on_set(cass::ResponseMessage* response) { }
+  virtual void on_error(CassError code, const std::string& message) { }
+  virtual void on_cancel() { }
+};
+
+static cass::Request::ConstPtr create_request() {
+  cass::QueryRequest* request = new cass::QueryRequest("SELECT * FROM test", 1);
+  request->set(0, cass::CassString("abc", 3));
+  request->set_consistency(CASS_CONSISTENCY_QUORUM);
+  request->set_timestamp(1234);
+  return cass::Request::ConstPtr(request);
+}
+
+TEST(PreEncodeUnitTest, SameAsWriteTimeEncoding) {
+  cass::Request::ConstPtr request(create_request());
+
+  cass::RequestWrapper wrapper(request);
+  TestRequestCallback expected(wrapper);
+
+  ASSERT_TRUE(wrapper.pre_encode(4));
+  ASSERT_TRUE(wrapper.encoded_body());
+  TestRequestCallback actual(wrapper);
+
+  EXPECT_EQ(expected.encode_frame(4), actual.encode_frame(4));
+}
+
+TEST(PreEncodeUnitTest, ReencodeOnVersionOrConsistencyChange) {
+  cass::Request::ConstPtr request(create_request());
+
+  cass::RequestWrapper wrapper(request);
+  TestRequestCallback expected(wrapper);
+
+  ASSERT_TRUE(wrapper.pre_encode(4));
+  TestRequestCallback actual(wrapper);
+
+  // Protocol downgrade
+  EXPECT_EQ(expected.encode_frame(3), actual.encode_frame(3));
+
+  // Retry with a different consistency
+  expected.set_retry_consistency(CASS_CONSISTENCY_ONE);
+  actual.set_retry_consistency(CASS_CONSISTENCY_ONE);
+  EXPECT_EQ(expected.encode_frame(4), actual.encode_frame(4));
+}
+
+TEST(PreEncodeUnitTest, SessionKeyspace) {
+  cass::Config config;
+  cass::PreparedMetadata prepared_metadata;
+  cass::Request::ConstPtr request(create_request());
+
+  cass::RequestWrapper wrapper(request);
+  wrapper.init(config, "session_keyspace", prepared_metadata);
+  TestRequestCallback expected(wrapper);
+
+  ASSERT_TRUE(wrapper.pre_encode(CASS_PROTOCOL_VERSION_V5));
+  TestRequestCallback actual(wrapper);
+
+  // Only protocol versions with per-request keyspaces send the keyspace
+  std::string frame(actual.encode_frame(CASS_PROTOCOL_VERSION_V5));
+  EXPECT_EQ(expected.encode_frame(CASS_PROTOCOL_VERSION_V5), frame);
+  EXPECT_NE(std::string::npos, frame.find("session_keyspace"));
+  EXPECT_EQ(std::string::npos, actual.encode_frame(4).find("session_keyspace"));
+
+  // The request's keyspace takes precedence
+  cass::QueryRequest* query = new cass::QueryRequest("SELECT * FROM test");
+  query->set_keyspace("request_keyspace");
+  cass::Request::ConstPtr other_request(query);
+  cass::RequestWrapper other(other_request);
+  other.init(config, "session_keyspace", prepared_metadata);
+  frame = TestRequestCallback(other).encode_frame(CASS_PROTOCOL_VERSION_V5);
+  EXPECT_NE(std::string::npos, frame.find("request_keyspace"));
+  EXPECT_EQ(std::string::npos, frame.find("session_keyspace"));
+}
@@ -0,0 +1,221 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "execute_request.hpp"
+#include "partition_aware_policy.hpp"
+#include "query_request.hpp"
+#include "replica_lookup.hpp"
+#include "session.hpp"
+#include "test_prepared_utils.hpp"
+
+#include <list>
+
+namespace {
+
+const char* KEYS[] = { "a", "b", "c", "abc", "def", "test" };
+const size_t NUM_KEYS = sizeof(KEYS) / sizeof(KEYS[0]);
+
+cass::Prepared::ConstPtr create_prepared() {
+  ColumnMetadataVec columns;
+  columns.push_back(ColumnMetadata("key", cass::DataType::ConstPtr(
+                                     new cass::DataType(CASS_VALUE_TYPE_VARCHAR))));
+  columns.push_back(ColumnMetadata("value", cass::DataType::ConstPtr(
+                                     new cass::DataType(CASS_VALUE_TYPE_INT))));
+  return create_prepared("id", columns, std::vector<uint16_t>(1, 0), "ks", "t");
+}
+
+cass::Metadata::SchemaSnapshot create_schema(const cass::TableSplitMetadata::MapPtr& partitions) {
+  return cass::Metadata::SchemaSnapshot(
+        CASS_PREPARED_PROTOCOL_VERSION, cass::VersionNumber(3, 0, 0),
+        cass::Metadata::PublishedSchema::Ptr(
+          new cass::Metadata::PublishedSchema(0, cass::KeyspaceMetadata::Map(), partitions)));
+}
+
+cass::Metadata::SchemaSnapshot create_schema() {
+  cass::TableSplitMetadata::MapPtr partitions(new cass::TableSplitMetadata::Map());
+  return create_schema(partitions);
+}
+
+struct Statements {
+  Statements(const cass::Prepared::ConstPtr& prepared) {
+    for (size_t i = 0; i < NUM_KEYS; ++i) {
+      cass::SharedRefPtr<cass::ExecuteRequest> request(new cass::ExecuteRequest(prepared.get()));
+      cass_statement_bind_string(CassStatement::to(request.get()), 0, KEYS[i]);
+      requests.push_back(request);
+      pointers.push_back(request.get());
+    }
+  }
+
+  std::vector<cass::SharedRefPtr<cass::ExecuteRequest> > requests;
+  std::vector<const cass::ExecuteRequest*> pointers;
+};
+
+template <class Partitioner>
+void add_host(const cass::Host::Ptr& host,
+              typename Partitioner::Token token,
+              cass::TokenMap* token_map) {
+  TokenCollectionBuilder builder;
+  builder.append_token(token);
+  token_map->add_host(host, builder.finish());
+}
+
+// Verifies that the replicas are the token map's replicas
+void verify_replicas(const cass::ReplicaLookup& lookup,
+                     const cass::TokenMap* token_map) {
+  ASSERT_EQ(NUM_KEYS, lookup.row_count());
+  for (size_t i = 0; i < NUM_KEYS; ++i) {
+    const cass::ReplicaLookup::Row& row = lookup.row(i);
+    EXPECT_EQ(CASS_OK, row.error);
+    const cass::CopyOnWriteHostVec& expected = token_map->get_replicas("ks", KEYS[i]);
+    ASSERT_TRUE(expected && expected->size() == 1);
+    ASSERT_EQ(1u, row.replica_count);
+    EXPECT_EQ(expected->front()->address_string(),
+              lookup.host(lookup.replicas(row)[0]).to_string());
+  }
+}
+
+} // namespace
+
+TEST(ReplicaLookupUnitTest, Murmur3) {
+  cass::ScopedPtr<cass::TokenMap> token_map(
+        cass::TokenMap::from_partitioner(cass::Murmur3Partitioner::name()));
+  add_keyspace_simple("ks", 1, token_map.get());
+  add_host<cass::Murmur3Partitioner>(create_host("127.0.0.1"), CASS_INT64_MIN / 2, token_map.get());
+  add_host<cass::Murmur3Partitioner>(create_host("127.0.0.2"), 0, token_map.get());
+  add_host<cass::Murmur3Partitioner>(create_host("127.0.0.3"), CASS_INT64_MAX / 2, token_map.get());
+  token_map->build();
+
+  cass::Prepared::ConstPtr prepared(create_prepared());
+  Statements statements(prepared);
+  cass::ReplicaLookup lookup;
+  lookup.lookup(create_schema(), token_map.get(), &statements.pointers[0], NUM_KEYS);
+
+  verify_replicas(lookup, token_map.get());
+  for (size_t i = 0; i < NUM_KEYS; ++i) {
+    const cass::ReplicaLookup::Row& row = lookup.row(i);
+    EXPECT_TRUE(row.has_token);
+    EXPECT_EQ(cass::Murmur3Partitioner::hash(KEYS[i]), row.token);
+  }
+}
+
+TEST(ReplicaLookupUnitTest, Random) {
+  cass::ScopedPtr<cass::TokenMap> token_map(
+        cass::TokenMap::from_partitioner(cass::RandomPartitioner::name()));
+  add_keyspace_simple("ks", 1, token_map.get());
+  add_host<cass::RandomPartitioner>(create_host("127.0.0.1"),
+                                    create_random_token("42535295865117307932921825928971026432"),
+                                    token_map.get());
+  add_host<cass::RandomPartitioner>(create_host("127.0.0.2"),
+                                    create_random_token("85070591730234615865843651857942052864"),
+                                    token_map.get());
+  add_host<cass::RandomPartitioner>(create_host("127.0.0.3"),
+                                    create_random_token("127605887595351923798765477786913079296"),
+                                    token_map.get());
+  token_map->build();
+
+  cass::Prepared::ConstPtr prepared(create_prepared());
+  Statements statements(prepared);
+  cass::ReplicaLookup lookup;
+  lookup.lookup(create_schema(), token_map.get(), &statements.pointers[0], NUM_KEYS);
+
+  // The replicas use the cluster's partitioner, but its tokens don't fit in
+  // 64 bits
+  verify_replicas(lookup, token_map.get());
+  for (size_t i = 0; i < NUM_KEYS; ++i) {
+    EXPECT_FALSE(lookup.row(i).has_token);
+  }
+}
+
+TEST(ReplicaLookupUnitTest, Partitions) {
+  cass::PartitionMetadata partition(0, 0x10000);
+  partition.host_ips_.push_back("127.0.0.5"); // Leader
+  partition.host_ips_.push_back("127.0.0.6");
+  std::list<cass::PartitionMetadata> source;
+  source.push_back(partition);
+
+  cass::TableSplitMetadata::MapPtr partitions(new cass::TableSplitMetadata::Map());
+  (*partitions)["ks.t"] = cass::TableSplitMetadata(source);
+
+  cass::Prepared::ConstPtr prepared(create_prepared());
+  Statements statements(prepared);
+  cass::ReplicaLookup lookup;
+  lookup.lookup(create_schema(partitions), NULL, &statements.pointers[0], NUM_KEYS);
+
+  ASSERT_EQ(NUM_KEYS, lookup.row_count());
+  ASSERT_EQ(2u, lookup.host_count());
+  for (size_t i = 0; i < NUM_KEYS; ++i) {
+    const cass::ReplicaLookup::Row& row = lookup.row(i);
+    EXPECT_EQ(CASS_OK, row.error);
+
+    int32_t hash_key = 0;
+    cass::PartitionAwarePolicy::get_hash_key(statements.pointers[i], &hash_key);
+    EXPECT_TRUE(row.has_token);
+    EXPECT_EQ(cass::PartitionAwarePolicy::to_yb_hash_code(hash_key), row.token);
+
+    ASSERT_EQ(2u, row.replica_count);
+    EXPECT_EQ("127.0.0.5", lookup.host(lookup.replicas(row)[0]).to_string());
+    EXPECT_EQ("127.0.0.6", lookup.host(lookup.replicas(row)[1]).to_string());
+  }
+}
+
+TEST(ReplicaLookupUnitTest, InvalidStatements) {
+  cass::Prepared::ConstPtr prepared(create_prepared());
+  Statements statements(prepared);
+
+  // Unset and null partition keys
+  statements.requests[0].reset(new cass::ExecuteRequest(prepared.get()));
+  statements.pointers[0] = statements.requests[0].get();
+  cass_statement_bind_null(CassStatement::to(statements.requests[1].get()), 0);
+
+  CassSession* session = cass_session_new();
+
+  std::vector<const CassStatement*> cass_statements;
+  for (size_t i = 0; i < NUM_KEYS; ++i) {
+    cass_statements.push_back(CassStatement::to(statements.requests[i].get()));
+  }
+
+  // The session isn't connected so there's no token map
+  CassReplicaLookup* lookup = NULL;
+  ASSERT_EQ(CASS_OK, cass_session_lookup_replicas(session, &cass_statements[0],
+                                                  NUM_KEYS, &lookup));
+  ASSERT_EQ(NUM_KEYS, cass_replica_lookup_row_count(lookup));
+
+  cass_int64_t token = 0;
+  const size_t* host_indices = NULL;
+  size_t host_indices_count = 0;
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_replica_lookup_row(lookup, 0, &token, &host_indices, &host_indices_count));
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_replica_lookup_row(lookup, 1, &token, &host_indices, &host_indices_count));
+  EXPECT_EQ(CASS_ERROR_LIB_NOT_IMPLEMENTED,
+            cass_replica_lookup_row(lookup, 2, &token, &host_indices, &host_indices_count));
+  EXPECT_EQ(CASS_OK,
+            cass_replica_lookup_row(lookup, 2, NULL, &host_indices, &host_indices_count));
+  EXPECT_EQ(0u, host_indices_count);
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+            cass_replica_lookup_row(lookup, NUM_KEYS, NULL, &host_indices, &host_indices_count));
+  cass_replica_lookup_free(lookup);
+
+  // Only bound statements can be looked up
+  cass::SharedRefPtr<cass::QueryRequest> query(new cass::QueryRequest("SELECT", 1));
+  cass_statements[0] = CassStatement::to(query.get());
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_session_lookup_replicas(session, &cass_statements[0], NUM_KEYS, &lookup));
+
+  cass_session_free(session);
+}
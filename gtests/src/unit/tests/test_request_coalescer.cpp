@@ -0,0 +1,111 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "execute_request.hpp"
+#include "request_coalescer.hpp"
+#include "result_response.hpp"
+#include "test_prepared_utils.hpp"
+
+TEST(RequestCoalescerUnitTest, Coalesce) {
+  cass::RequestCoalescer::Ptr coalescer(new cass::RequestCoalescer());
+  cass::ResponseFuture::Ptr future1(new cass::ResponseFuture());
+  cass::ResponseFuture::Ptr future2(new cass::ResponseFuture());
+  cass::ResponseFuture::Ptr future3(new cass::ResponseFuture());
+
+  cass::ResponseFuture::Ptr leader(coalescer->add("key", future1));
+  ASSERT_TRUE(leader);
+  EXPECT_FALSE(coalescer->add("key", future2));
+  cass::ResponseFuture::Ptr other(coalescer->add("other", future3));
+  EXPECT_TRUE(other);
+  EXPECT_EQ(2u, coalescer->in_flight());
+  EXPECT_EQ(1u, coalescer->coalesced());
+
+  cass::Address address("127.0.0.1", 9042);
+  cass::Response::Ptr response(new cass::ResultResponse());
+  leader->set_response(address, response);
+
+  ASSERT_TRUE(future1->ready());
+  ASSERT_TRUE(future2->ready());
+  EXPECT_FALSE(future3->ready());
+  EXPECT_EQ(response.get(), future1->response().get());
+  EXPECT_EQ(response.get(), future2->response().get());
+  EXPECT_EQ(address, future2->address());
+  EXPECT_EQ(1u, coalescer->in_flight());
+
+  // A finished request is no longer shared
+  cass::ResponseFuture::Ptr future4(new cass::ResponseFuture());
+  cass::ResponseFuture::Ptr next(coalescer->add("key", future4));
+  EXPECT_TRUE(next);
+
+  other->set_error(CASS_ERROR_LIB_REQUEST_CANCELLED, "Request was cancelled");
+  next->set_error(CASS_ERROR_LIB_REQUEST_CANCELLED, "Request was cancelled");
+  EXPECT_EQ(0u, coalescer->in_flight());
+}
+
+TEST(RequestCoalescerUnitTest, Error) {
+  cass::RequestCoalescer::Ptr coalescer(new cass::RequestCoalescer());
+  cass::ResponseFuture::Ptr future1(new cass::ResponseFuture());
+  cass::ResponseFuture::Ptr future2(new cass::ResponseFuture());
+
+  cass::ResponseFuture::Ptr leader(coalescer->add("key", future1));
+  ASSERT_TRUE(leader);
+  EXPECT_FALSE(coalescer->add("key", future2));
+
+  leader->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Request timed out");
+
+  ASSERT_TRUE(future1->error() != NULL);
+  ASSERT_TRUE(future2->error() != NULL);
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, future2->error()->code);
+  EXPECT_EQ("Request timed out", future2->error()->message);
+}
+
+TEST(RequestCoalescerUnitTest, Coalescable) {
+  cass::DataType::ConstPtr int_data_type(new cass::DataType(CASS_VALUE_TYPE_INT));
+  ColumnMetadataVec columns(1, ColumnMetadata("key", int_data_type));
+  cass::Prepared::ConstPtr read(create_prepared("read", columns,
+                                                std::vector<uint16_t>(1, 0),
+                                                "keyspace", "table", columns));
+  cass::Prepared::ConstPtr write(create_prepared("write", columns,
+                                                 std::vector<uint16_t>(1, 0)));
+
+  cass::SharedRefPtr<cass::ExecuteRequest> request(new cass::ExecuteRequest(read.get()));
+  EXPECT_FALSE(cass::RequestCoalescer::is_coalescable(request.get()));
+  request->set_is_idempotent(true);
+  EXPECT_TRUE(cass::RequestCoalescer::is_coalescable(request.get()));
+
+  // Statements that don't return rows aren't coalesced
+  cass::SharedRefPtr<cass::ExecuteRequest> no_rows(new cass::ExecuteRequest(write.get()));
+  no_rows->set_is_idempotent(true);
+  EXPECT_FALSE(cass::RequestCoalescer::is_coalescable(no_rows.get()));
+
+  // Nor are statements with settings that aren't part of the key
+  cass::SharedRefPtr<cass::ExecuteRequest> timeout(new cass::ExecuteRequest(read.get()));
+  timeout->set_is_idempotent(true);
+  timeout->set_request_timeout_ms(1000);
+  EXPECT_FALSE(cass::RequestCoalescer::is_coalescable(timeout.get()));
+
+  cass::SharedRefPtr<cass::ExecuteRequest> retry_policy(new cass::ExecuteRequest(read.get()));
+  retry_policy->set_is_idempotent(true);
+  retry_policy->set_retry_policy(new cass::DefaultRetryPolicy());
+  EXPECT_FALSE(cass::RequestCoalescer::is_coalescable(retry_policy.get()));
+
+  cass::SharedRefPtr<cass::ExecuteRequest> custom_payload(new cass::ExecuteRequest(read.get()));
+  custom_payload->set_is_idempotent(true);
+  custom_payload->set_custom_payload(new cass::CustomPayload());
+  EXPECT_FALSE(cass::RequestCoalescer::is_coalescable(custom_payload.get()));
+}
@@ -0,0 +1,100 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "constants.hpp"
+#include "response.hpp"
+#include "result_response.hpp"
+#include "serialization.hpp"
+
+#include <vector>
+
+class DiscardStreamFilter : public cass::ResponseMessage::Filter {
+public:
+  DiscardStreamFilter(int16_t stream)
+    : stream_(stream) { }
+
+  virtual bool is_discarded(int16_t stream) const {
+    return stream == stream_;
+  }
+
+private:
+  int16_t stream_;
+};
+
+// Builds a v4 "void" result frame
+static std::vector<char> void_result_frame(int16_t stream) {
+  std::vector<char> frame(CASS_HEADER_SIZE_V3 + sizeof(int32_t));
+  char* pos = &frame[0];
+  pos = cass::encode_byte(pos, 0x84); // Response, version 4
+  pos = cass::encode_byte(pos, 0); // Flags
+  cass::encode_int16(pos, stream);
+  pos += sizeof(int16_t);
+  pos = cass::encode_byte(pos, CQL_OPCODE_RESULT);
+  cass::encode_int32(pos, sizeof(int32_t));
+  pos += sizeof(int32_t);
+  cass::encode_int32(pos, CASS_RESULT_KIND_VOID);
+  return frame;
+}
+
+TEST(ResponseMessageUnitTest, Decode)
+{
+  DiscardStreamFilter filter(1);
+  std::vector<char> frame(void_result_frame(2));
+
+  cass::ResponseMessage message(&filter);
+  EXPECT_EQ(message.decode(&frame[0], frame.size()), static_cast<ssize_t>(frame.size()));
+  ASSERT_TRUE(message.is_body_ready());
+  EXPECT_FALSE(message.is_body_discarded());
+  EXPECT_EQ(message.stream(), 2);
+  ASSERT_TRUE(message.response_body());
+  EXPECT_EQ(static_cast<cass::ResultResponse*>(message.response_body().get())->kind(),
+            CASS_RESULT_KIND_VOID);
+}
+
+TEST(ResponseMessageUnitTest, DiscardBody)
+{
+  DiscardStreamFilter filter(1);
+  std::vector<char> frame(void_result_frame(1));
+
+  // Add a trailing byte to verify only the frame is consumed
+  frame.push_back(static_cast<char>(0x84));
+
+  cass::ResponseMessage message(&filter);
+  EXPECT_EQ(message.decode(&frame[0], frame.size()), static_cast<ssize_t>(frame.size() - 1));
+  ASSERT_TRUE(message.is_body_ready());
+  EXPECT_TRUE(message.is_body_discarded());
+  EXPECT_EQ(message.stream(), 1);
+  EXPECT_EQ(message.opcode(), CQL_OPCODE_RESULT);
+  EXPECT_FALSE(message.response_body());
+}
+
+TEST(ResponseMessageUnitTest, DiscardBodyPartial)
+{
+  DiscardStreamFilter filter(1);
+  std::vector<char> frame(void_result_frame(1));
+
+  // Decode the frame a byte at a time
+  cass::ResponseMessage message(&filter);
+  for (size_t i = 0; i < frame.size(); ++i) {
+    EXPECT_FALSE(message.is_body_ready());
+    EXPECT_EQ(message.decode(&frame[i], 1), 1);
+  }
+  ASSERT_TRUE(message.is_body_ready());
+  EXPECT_TRUE(message.is_body_discarded());
+  EXPECT_FALSE(message.response_body());
+}
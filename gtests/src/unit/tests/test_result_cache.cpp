@@ -0,0 +1,125 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "execute_request.hpp"
+#include "result_cache.hpp"
+#include "result_response.hpp"
+#include "test_prepared_utils.hpp"
+
+#include <sstream>
+
+static std::string key(int i) {
+  std::ostringstream ss;
+  ss << "key" << i;
+  return ss.str();
+}
+
+TEST(ResultCacheUnitTest, GetAndPut) {
+  cass::ResultCache cache(16, 60 * 1000);
+  cass::Address address("127.0.0.1", 9042);
+  cass::Response::Ptr response(new cass::ResultResponse());
+
+  cass::Address cached_address;
+  cass::Response::Ptr cached;
+  EXPECT_FALSE(cache.get("key", &cached_address, &cached));
+
+  cache.put("key", "ks", "table", address, response);
+  EXPECT_TRUE(cache.get("key", &cached_address, &cached));
+  EXPECT_EQ(response.get(), cached.get());
+  EXPECT_EQ(address, cached_address);
+
+  EXPECT_EQ(1u, cache.hits());
+  EXPECT_EQ(1u, cache.misses());
+}
+
+TEST(ResultCacheUnitTest, Expiration) {
+  cass::ResultCache cache(16, 10);
+  cass::Response::Ptr response(new cass::ResultResponse());
+
+  cache.put("key", "ks", "table", cass::Address(), response);
+  uv_sleep(20);
+
+  cass::Address address;
+  cass::Response::Ptr cached;
+  EXPECT_FALSE(cache.get("key", &address, &cached));
+}
+
+TEST(ResultCacheUnitTest, Eviction) {
+  cass::ResultCache cache(16, 60 * 1000);
+  cass::Response::Ptr response(new cass::ResultResponse());
+
+  for (int i = 0; i < 1000; ++i) {
+    cache.put(key(i), "ks", "table", cass::Address(), response);
+  }
+  EXPECT_LE(cache.size(), 16u);
+  EXPECT_EQ(1000u - cache.size(), cache.evictions());
+
+  // The most recent entry is never evicted
+  cass::Address address;
+  cass::Response::Ptr cached;
+  EXPECT_TRUE(cache.get(key(999), &address, &cached));
+  EXPECT_FALSE(cache.get(key(0), &address, &cached));
+}
+
+TEST(ResultCacheUnitTest, Invalidate) {
+  cass::ResultCache cache(16, 60 * 1000);
+  cass::Response::Ptr response(new cass::ResultResponse());
+
+  cache.put("a", "ks1", "table1", cass::Address(), response);
+  cache.put("b", "ks1", "table2", cass::Address(), response);
+  cache.put("c", "ks2", "table1", cass::Address(), response);
+
+  cache.invalidate("ks1", "table1");
+  EXPECT_EQ(2u, cache.size());
+
+  cache.invalidate("ks1", "");
+  EXPECT_EQ(1u, cache.size());
+
+  cass::Address address;
+  cass::Response::Ptr cached;
+  EXPECT_TRUE(cache.get("c", &address, &cached));
+}
+
+TEST(ResultCacheUnitTest, KeyUnsetAndNull) {
+  cass::DataType::ConstPtr int_data_type(new cass::DataType(CASS_VALUE_TYPE_INT));
+  ColumnMetadataVec columns;
+  for (int i = 0; i < 8; ++i) {
+    columns.push_back(ColumnMetadata(key(i), int_data_type));
+  }
+  cass::Prepared::ConstPtr prepared(create_prepared("id", columns,
+                                                    std::vector<uint16_t>(1, 0)));
+
+  // Four unset values followed by four nulls and four nulls followed by four
+  // unset values
+  cass::SharedRefPtr<cass::ExecuteRequest> first(new cass::ExecuteRequest(prepared.get()));
+  cass::SharedRefPtr<cass::ExecuteRequest> second(new cass::ExecuteRequest(prepared.get()));
+  for (size_t i = 0; i < 4; ++i) {
+    cass_statement_bind_null(CassStatement::to(first.get()), i + 4);
+    cass_statement_bind_null(CassStatement::to(second.get()), i);
+  }
+
+  std::string first_key, second_key;
+  ASSERT_TRUE(cass::ResultCache::make_key(first.get(), first->page_size(), &first_key));
+  ASSERT_TRUE(cass::ResultCache::make_key(second.get(), second->page_size(), &second_key));
+  EXPECT_NE(first_key, second_key);
+
+  cass_statement_bind_int32(CassStatement::to(first.get()), 0, 1);
+  std::string bound_key;
+  ASSERT_TRUE(cass::ResultCache::make_key(first.get(), first->page_size(), &bound_key));
+  EXPECT_NE(first_key, bound_key);
+}
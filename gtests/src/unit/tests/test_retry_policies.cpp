@@ -217,3 +217,120 @@ TEST(RetryPoliciesUnitTest, Logging)
   cass_log_set_level(CASS_LOG_INFO);
   check_default(logging_policy);
 }
+
+TEST(RetryPoliciesUnitTest, Budget)
+{
+  cass::SharedRefPtr<cass::DefaultRetryPolicy> policy(new cass::DefaultRetryPolicy());
+  cass::BudgetRetryPolicy::Settings settings;
+  settings.retry_ratio = 0.5;
+  settings.max_tokens = 2;
+  cass::BudgetRetryPolicy budget_policy(policy, settings);
+  check_default(budget_policy);
+
+  cass::Address host1("127.0.0.1", 9042);
+  cass::Address host2("127.0.0.2", 9042);
+
+  // The buckets start full
+  EXPECT_TRUE(budget_policy.acquire_retry(host1));
+  EXPECT_TRUE(budget_policy.acquire_retry(host1));
+  EXPECT_FALSE(budget_policy.acquire_retry(host1));
+
+  // The host's bucket isn't empty, but the session's bucket is
+  EXPECT_FALSE(budget_policy.acquire_retry(host2));
+
+  // Two successful requests earn a single retry
+  budget_policy.on_success(host1);
+  EXPECT_FALSE(budget_policy.acquire_retry(host1));
+  budget_policy.on_success(host1);
+  EXPECT_TRUE(budget_policy.acquire_retry(host1));
+  EXPECT_FALSE(budget_policy.acquire_retry(host1));
+
+  // Successes on another host only refill that host's bucket (it's capped)
+  for (int i = 0; i < 10; ++i) {
+    budget_policy.on_success(host2);
+  }
+  EXPECT_FALSE(budget_policy.acquire_retry(host1));
+  EXPECT_TRUE(budget_policy.acquire_retry(host2));
+  EXPECT_TRUE(budget_policy.acquire_retry(host2));
+  EXPECT_FALSE(budget_policy.acquire_retry(host2));
+
+  // A new instance (used by a new session) gets its own budget
+  cass::RetryPolicy::Ptr instance(budget_policy.new_instance());
+  EXPECT_EQ(RetryPolicy::BUDGET, instance->type());
+  EXPECT_TRUE(instance->acquire_retry(host1));
+}
+
+TEST(RetryPoliciesUnitTest, BudgetRemovedHost)
+{
+  cass::SharedRefPtr<cass::DefaultRetryPolicy> policy(new cass::DefaultRetryPolicy());
+  cass::BudgetRetryPolicy::Settings settings;
+  settings.max_tokens = 2;
+  cass::BudgetRetryPolicy budget_policy(policy, settings);
+
+  cass::Address host1("127.0.0.1", 9042);
+  cass::Address host2("127.0.0.2", 9042);
+
+  EXPECT_TRUE(budget_policy.acquire_retry(host1));
+  EXPECT_TRUE(budget_policy.acquire_retry(host1));
+
+  // Refill the session's bucket, but not host1's
+  for (int i = 0; i < 100; ++i) {
+    budget_policy.on_success(host2);
+  }
+  EXPECT_FALSE(budget_policy.acquire_retry(host1));
+
+  // The bucket of a removed host is dropped so a host that's added with the
+  // same address starts with a full bucket
+  budget_policy.on_host_removed(host1);
+  EXPECT_TRUE(budget_policy.acquire_retry(host1));
+  EXPECT_TRUE(budget_policy.acquire_retry(host1));
+}
+
+TEST(RetryPoliciesUnitTest, HasRetryBudget)
+{
+  // Retries are only counted by the retry budget metrics when a budget is
+  // used, so they stay at zero for the other policies
+  cass::SharedRefPtr<cass::DefaultRetryPolicy> default_policy(new cass::DefaultRetryPolicy());
+  cass::SharedRefPtr<cass::DowngradingConsistencyRetryPolicy> downgrading_policy(
+        new cass::DowngradingConsistencyRetryPolicy());
+  cass::FallthroughRetryPolicy fallthrough_policy;
+  EXPECT_FALSE(default_policy->has_retry_budget());
+  EXPECT_FALSE(downgrading_policy->has_retry_budget());
+  EXPECT_FALSE(fallthrough_policy.has_retry_budget());
+  EXPECT_FALSE(cass::LoggingRetryPolicy(default_policy).has_retry_budget());
+  EXPECT_FALSE(cass::LoggingRetryPolicy(downgrading_policy).has_retry_budget());
+
+  cass::RetryPolicy::Ptr budget_policy(new cass::BudgetRetryPolicy(default_policy));
+  EXPECT_TRUE(budget_policy->has_retry_budget());
+  EXPECT_TRUE(cass::LoggingRetryPolicy(budget_policy).has_retry_budget());
+}
+
+TEST(RetryPoliciesUnitTest, BudgetBackoff)
+{
+  cass::SharedRefPtr<cass::DefaultRetryPolicy> policy(new cass::DefaultRetryPolicy());
+
+  // No backoff by default
+  cass::BudgetRetryPolicy no_backoff_policy(policy);
+  EXPECT_EQ(0u, no_backoff_policy.retry_delay_ms(0));
+  EXPECT_EQ(0u, no_backoff_policy.retry_delay_ms(3));
+
+  cass::BudgetRetryPolicy::Settings settings;
+  settings.base_delay_ms = 10;
+  settings.max_delay_ms = 100;
+  cass::BudgetRetryPolicy budget_policy(policy, settings);
+
+  for (int i = 0; i < 100; ++i) {
+    uint64_t delay = budget_policy.retry_delay_ms(0);
+    EXPECT_GE(delay, 5u);
+    EXPECT_LE(delay, 10u);
+
+    delay = budget_policy.retry_delay_ms(2);
+    EXPECT_GE(delay, 20u);
+    EXPECT_LE(delay, 40u);
+
+    // Capped at the max delay
+    delay = budget_policy.retry_delay_ms(10);
+    EXPECT_GE(delay, 50u);
+    EXPECT_LE(delay, 100u);
+  }
+}
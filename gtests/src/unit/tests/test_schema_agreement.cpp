@@ -0,0 +1,284 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "schema_agreement_scheduler.hpp"
+
+namespace {
+
+struct TestWaiter {
+  TestWaiter(int id, uint64_t start_ms, std::vector<int>* responses)
+    : id(id)
+    , start_ms(start_ms)
+    , cancelled(false)
+    , responses(responses) { }
+
+  bool is_cancelled() const { return cancelled; }
+  void set_response() const { responses->push_back(id); }
+
+  int id;
+  uint64_t start_ms;
+  bool cancelled;
+  std::vector<int>* responses;
+};
+
+typedef cass::SchemaAgreementScheduler<TestWaiter> Scheduler;
+
+// Records the checks and timers so they can be completed by the test
+class TestHandler : public Scheduler::Handler {
+public:
+  TestHandler()
+    : timer_starts(0)
+    , timer_stops(0)
+    , timer_delay_ms(0) { }
+
+  virtual void on_check_schema_agreement(Scheduler::WaiterVec* waiters) {
+    checks.push_back(Scheduler::WaiterVec());
+    checks.back().swap(*waiters);
+  }
+
+  virtual void on_start_schema_agreement_timer(uint64_t delay_ms) {
+    timer_starts++;
+    timer_delay_ms = delay_ms;
+  }
+
+  virtual void on_stop_schema_agreement_timer() {
+    timer_stops++;
+  }
+
+  std::vector<Scheduler::WaiterVec> checks;
+  int timer_starts;
+  int timer_stops;
+  uint64_t timer_delay_ms;
+};
+
+} // namespace
+
+TEST(SchemaAgreementUnitTest, Agreement) {
+  TestHandler handler;
+  Scheduler scheduler(&handler);
+  std::vector<int> responses;
+
+  scheduler.add(TestWaiter(1, 0, &responses));
+  ASSERT_EQ(1u, handler.checks.size());
+  ASSERT_EQ(1u, handler.checks[0].size());
+  EXPECT_TRUE(scheduler.is_checking());
+
+  scheduler.on_checked(true, false, 5, false, &handler.checks[0]);
+  ASSERT_EQ(1u, responses.size());
+  EXPECT_EQ(1, responses[0]);
+  EXPECT_FALSE(scheduler.is_checking());
+  EXPECT_FALSE(scheduler.is_timer_running());
+  EXPECT_EQ(1u, handler.checks.size());
+}
+
+TEST(SchemaAgreementUnitTest, WaitersDuringCheck) {
+  TestHandler handler;
+  Scheduler scheduler(&handler);
+  std::vector<int> responses;
+
+  scheduler.add(TestWaiter(1, 0, &responses));
+
+  // Waiters that arrive during a check don't start their own check
+  scheduler.add(TestWaiter(2, 1, &responses));
+  scheduler.add(TestWaiter(3, 2, &responses));
+  ASSERT_EQ(1u, handler.checks.size());
+  EXPECT_EQ(2u, scheduler.waiter_count());
+
+  // They're checked as soon as the current check finishes, along with the
+  // waiters that still need to wait
+  scheduler.on_checked(false, false, 5, false, &handler.checks[0]);
+  EXPECT_TRUE(responses.empty());
+  EXPECT_EQ(0, handler.timer_starts);
+  ASSERT_EQ(2u, handler.checks.size());
+  ASSERT_EQ(3u, handler.checks[1].size());
+
+  scheduler.on_checked(true, false, 10, false, &handler.checks[1]);
+  ASSERT_EQ(3u, responses.size());
+  EXPECT_EQ(0u, scheduler.waiter_count());
+}
+
+TEST(SchemaAgreementUnitTest, Backoff) {
+  TestHandler handler;
+  Scheduler scheduler(&handler);
+  std::vector<int> responses;
+
+  scheduler.add(TestWaiter(1, 0, &responses));
+
+  const uint64_t delays[] = { 10, 20, 40, 80, 160, 200, 200 };
+  for (size_t i = 0; i < sizeof(delays) / sizeof(delays[0]); ++i) {
+    ASSERT_EQ(i + 1, handler.checks.size());
+    scheduler.on_checked(false, false, i, false, &handler.checks.back());
+    EXPECT_TRUE(scheduler.is_timer_running());
+    EXPECT_EQ(delays[i], handler.timer_delay_ms);
+    scheduler.on_timer();
+    EXPECT_FALSE(scheduler.is_timer_running());
+  }
+  EXPECT_TRUE(responses.empty());
+
+  // A new waiter checks right away and resets the backoff
+  scheduler.on_checked(false, false, 100, false, &handler.checks.back());
+  EXPECT_TRUE(scheduler.is_timer_running());
+  scheduler.add(TestWaiter(2, 100, &responses));
+  EXPECT_FALSE(scheduler.is_timer_running());
+  EXPECT_EQ(1, handler.timer_stops);
+  ASSERT_EQ(2u, handler.checks.back().size());
+
+  scheduler.on_checked(false, false, 101, false, &handler.checks.back());
+  EXPECT_EQ(static_cast<uint64_t>(Scheduler::MIN_RETRY_MS), handler.timer_delay_ms);
+}
+
+TEST(SchemaAgreementUnitTest, MaxWait) {
+  TestHandler handler;
+  Scheduler scheduler(&handler);
+  std::vector<int> responses;
+
+  scheduler.add(TestWaiter(1, 0, &responses));
+  scheduler.add(TestWaiter(2, 1, &responses));
+  scheduler.on_checked(false, false, 1, false, &handler.checks.back());
+  ASSERT_EQ(2u, handler.checks.back().size());
+
+  // Each waiter's maximum wait is tracked from when it started waiting
+  scheduler.on_checked(false, false, Scheduler::MAX_WAIT_MS, false, &handler.checks.back());
+  ASSERT_EQ(1u, responses.size());
+  EXPECT_EQ(1, responses[0]);
+  EXPECT_EQ(1u, scheduler.waiter_count());
+  EXPECT_TRUE(scheduler.is_timer_running());
+
+  scheduler.on_timer();
+  scheduler.on_checked(false, false, 1 + Scheduler::MAX_WAIT_MS, false,
+                       &handler.checks.back());
+  ASSERT_EQ(2u, responses.size());
+  EXPECT_EQ(2, responses[1]);
+  EXPECT_EQ(0u, scheduler.waiter_count());
+  EXPECT_FALSE(scheduler.is_timer_running());
+}
+
+TEST(SchemaAgreementUnitTest, Error) {
+  TestHandler handler;
+  Scheduler scheduler(&handler);
+  std::vector<int> responses;
+
+  scheduler.add(TestWaiter(1, 0, &responses));
+  scheduler.add(TestWaiter(2, 0, &responses));
+  scheduler.on_checked(false, false, 1, false, &handler.checks.back());
+  ASSERT_EQ(2u, handler.checks.back().size());
+
+  // The responses are returned without waiting any longer
+  scheduler.on_checked(false, true, 2, false, &handler.checks.back());
+  EXPECT_EQ(2u, responses.size());
+  EXPECT_EQ(0u, scheduler.waiter_count());
+  EXPECT_FALSE(scheduler.is_checking());
+  EXPECT_FALSE(scheduler.is_timer_running());
+}
+
+TEST(SchemaAgreementUnitTest, Cancelled) {
+  TestHandler handler;
+  Scheduler scheduler(&handler);
+  std::vector<int> responses;
+
+  scheduler.add(TestWaiter(1, 0, &responses));
+  scheduler.add(TestWaiter(2, 0, &responses));
+  scheduler.on_checked(false, false, 1, false, &handler.checks.back());
+  ASSERT_EQ(2u, handler.checks.back().size());
+
+  // Cancelled waiters stop waiting without a response
+  handler.checks.back()[0].cancelled = true;
+  scheduler.on_checked(false, false, 2, false, &handler.checks.back());
+  EXPECT_TRUE(responses.empty());
+  EXPECT_EQ(1u, scheduler.waiter_count());
+
+  scheduler.on_timer();
+  handler.checks.back()[0].cancelled = true;
+  scheduler.on_checked(true, false, 3, false, &handler.checks.back());
+  EXPECT_TRUE(responses.empty());
+  EXPECT_EQ(0u, scheduler.waiter_count());
+  EXPECT_FALSE(scheduler.is_timer_running());
+}
+
+TEST(SchemaAgreementUnitTest, SchemaChangeEvent) {
+  TestHandler handler;
+  Scheduler scheduler(&handler);
+  std::vector<int> responses;
+
+  // An event while a retry is pending checks right away
+  scheduler.add(TestWaiter(1, 0, &responses));
+  scheduler.on_checked(false, false, 1, false, &handler.checks.back());
+  EXPECT_TRUE(scheduler.is_timer_running());
+  scheduler.on_schema_change_event();
+  EXPECT_FALSE(scheduler.is_timer_running());
+  EXPECT_EQ(1, handler.timer_stops);
+  EXPECT_EQ(2u, handler.checks.size());
+
+  // An event during a check starts the next check as soon as it finishes
+  scheduler.on_schema_change_event();
+  EXPECT_EQ(2u, handler.checks.size());
+  scheduler.on_checked(false, false, 2, false, &handler.checks.back());
+  EXPECT_FALSE(scheduler.is_timer_running());
+  EXPECT_EQ(3u, handler.checks.size());
+
+  // The event only applies to the check that was running
+  scheduler.on_checked(false, false, 3, false, &handler.checks.back());
+  EXPECT_TRUE(scheduler.is_timer_running());
+  EXPECT_EQ(3u, handler.checks.size());
+
+  // Events without waiters are ignored
+  scheduler.on_timer();
+  scheduler.on_checked(true, false, 4, false, &handler.checks.back());
+  EXPECT_EQ(1u, responses.size());
+  scheduler.on_schema_change_event();
+  EXPECT_EQ(4u, handler.checks.size());
+  EXPECT_FALSE(scheduler.is_checking());
+}
+
+TEST(SchemaAgreementUnitTest, CloseDuringCheck) {
+  TestHandler handler;
+  Scheduler scheduler(&handler);
+  std::vector<int> responses;
+
+  scheduler.add(TestWaiter(1, 0, &responses));
+  scheduler.add(TestWaiter(2, 0, &responses));
+
+  // No more checks are scheduled once the connection is closing
+  scheduler.on_checked(false, false, 1, true, &handler.checks.back());
+  EXPECT_EQ(1u, handler.checks.size());
+  EXPECT_FALSE(scheduler.is_checking());
+  EXPECT_FALSE(scheduler.is_timer_running());
+  EXPECT_EQ(2u, scheduler.waiter_count());
+  EXPECT_TRUE(responses.empty());
+
+  // The remaining waiters are returned when it's closed
+  scheduler.close();
+  EXPECT_EQ(2u, responses.size());
+  EXPECT_EQ(0u, scheduler.waiter_count());
+}
+
+TEST(SchemaAgreementUnitTest, CloseDuringRetry) {
+  TestHandler handler;
+  Scheduler scheduler(&handler);
+  std::vector<int> responses;
+
+  scheduler.add(TestWaiter(1, 0, &responses));
+  scheduler.on_checked(false, false, 1, false, &handler.checks.back());
+  EXPECT_TRUE(scheduler.is_timer_running());
+
+  scheduler.close();
+  EXPECT_FALSE(scheduler.is_timer_running());
+  EXPECT_EQ(1, handler.timer_stops);
+  ASSERT_EQ(1u, responses.size());
+  EXPECT_EQ(1, responses[0]);
+}
@@ -0,0 +1,150 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "protocol.hpp"
+#include "segment.hpp"
+
+#include <string>
+
+static cass::Buffer create_frame(size_t size, char fill) {
+  cass::Buffer frame(size);
+  memset(frame.data(), fill, size);
+  return frame;
+}
+
+static std::string concat(const cass::BufferVec& buffers) {
+  std::string result;
+  for (cass::BufferVec::const_iterator i = buffers.begin(); i != buffers.end(); ++i) {
+    result.append(i->data(), i->size());
+  }
+  return result;
+}
+
+// Decodes segments from "data" in chunks of "chunk_size" bytes and returns
+// the concatenated payloads
+static bool decode(const std::string& data, size_t chunk_size,
+                   std::string* payloads, int* segment_count) {
+  cass::SegmentDecoder decoder;
+  size_t pos = 0;
+  *segment_count = 0;
+  while (pos < data.size()) {
+    size_t size = std::min(chunk_size, data.size() - pos);
+    const char* input = data.data() + pos;
+    while (size > 0) {
+      ssize_t consumed = decoder.decode(input, size);
+      if (consumed <= 0) return false;
+      if (decoder.is_payload_ready()) {
+        payloads->append(decoder.payload(), decoder.payload_size());
+        (*segment_count)++;
+      }
+      input += consumed;
+      size -= consumed;
+      pos += consumed;
+    }
+  }
+  return true;
+}
+
+TEST(SegmentUnitTest, SmallFramesArePacked) {
+  cass::BufferVec frames;
+  cass::Segment::FrameSizeVec frame_sizes;
+  for (int i = 0; i < 100; ++i) {
+    // Each frame is a header and a body buffer
+    frames.push_back(create_frame(9, 'h'));
+    frames.push_back(create_frame(100 + i, static_cast<char>('a' + i % 26)));
+    frame_sizes.push_back(9 + 100 + i);
+  }
+
+  cass::BufferVec segments;
+  cass::Segment::encode(frames, frame_sizes, &segments);
+  ASSERT_EQ(1u, segments.size());
+
+  std::string payloads;
+  int segment_count;
+  ASSERT_TRUE(decode(concat(segments), 1024 * 1024, &payloads, &segment_count));
+  EXPECT_EQ(1, segment_count);
+  EXPECT_EQ(concat(frames), payloads);
+}
+
+TEST(SegmentUnitTest, LargeFramesAreSplit) {
+  const size_t max_size = cass::Segment::MAX_PAYLOAD_SIZE;
+
+  cass::BufferVec frames;
+  cass::Segment::FrameSizeVec frame_sizes;
+  frames.push_back(create_frame(1000, 'a'));
+  frame_sizes.push_back(1000);
+  frames.push_back(create_frame(2 * max_size + 10, 'b'));
+  frame_sizes.push_back(2 * max_size + 10);
+  frames.push_back(create_frame(max_size, 'c'));
+  frame_sizes.push_back(max_size);
+
+  cass::BufferVec segments;
+  cass::Segment::encode(frames, frame_sizes, &segments);
+
+  // The small frame, three segments for the large frame and a full segment
+  ASSERT_EQ(5u, segments.size());
+
+  std::string data(concat(segments));
+  std::string payloads;
+  int segment_count;
+
+  // Segments that span reads and reads that contain several segments
+  const size_t chunk_sizes[] = { 1, 7, 4096, 200000 };
+  for (size_t i = 0; i < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); ++i) {
+    payloads.clear();
+    ASSERT_TRUE(decode(data, chunk_sizes[i], &payloads, &segment_count));
+    EXPECT_EQ(5, segment_count);
+    EXPECT_TRUE(concat(frames) == payloads);
+  }
+}
+
+TEST(SegmentUnitTest, InvalidChecksums) {
+  cass::BufferVec frames;
+  cass::Segment::FrameSizeVec frame_sizes;
+  frames.push_back(create_frame(64, 'a'));
+  frame_sizes.push_back(64);
+
+  cass::BufferVec segments;
+  cass::Segment::encode(frames, frame_sizes, &segments);
+  std::string data(concat(segments));
+
+  std::string payloads;
+  int segment_count;
+  ASSERT_TRUE(decode(data, data.size(), &payloads, &segment_count));
+
+  std::string corrupted(data);
+  corrupted[1] ^= 0x01; // Header
+  EXPECT_FALSE(decode(corrupted, corrupted.size(), &payloads, &segment_count));
+  EXPECT_FALSE(decode(corrupted, 1, &payloads, &segment_count));
+
+  corrupted = data;
+  corrupted[cass::Segment::HEADER_SIZE + 10] ^= 0x01; // Payload
+  EXPECT_FALSE(decode(corrupted, corrupted.size(), &payloads, &segment_count));
+  EXPECT_FALSE(decode(corrupted, 3, &payloads, &segment_count));
+}
+
+TEST(SegmentUnitTest, SupportsSegments) {
+  EXPECT_FALSE(cass::supports_segments(CASS_PROTOCOL_VERSION_V4, cass::VersionNumber(4, 0, 0)));
+  EXPECT_TRUE(cass::supports_segments(CASS_PROTOCOL_VERSION_V5, cass::VersionNumber(4, 0, 0)));
+
+  // The beta protocol v5 of Cassandra v3.x doesn't use segments
+  EXPECT_FALSE(cass::supports_segments(CASS_PROTOCOL_VERSION_V5, cass::VersionNumber(3, 11, 2)));
+
+  // Unknown server version
+  EXPECT_FALSE(cass::supports_segments(CASS_PROTOCOL_VERSION_V5, cass::VersionNumber()));
+}
@@ -0,0 +1,123 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include <gtest/gtest.h>
+
+#include "atomic.hpp"
+#include "event_thread.hpp"
+#include "shared_io_threads.hpp"
+
+struct TestAttachedThread : public cass::EventThread<int> {
+  TestAttachedThread()
+    : sum(0)
+    , is_closed(false) { }
+
+  virtual void on_event(const int& event) {
+    sum.fetch_add(event);
+  }
+
+  virtual void on_handles_closed() {
+    is_closed.store(true);
+  }
+
+  static int on_init(void* data) {
+    return static_cast<TestAttachedThread*>(data)->init(16);
+  }
+
+  static int on_close(void* data) {
+    static_cast<TestAttachedThread*>(data)->close_handles();
+    return 0;
+  }
+
+  cass::Atomic<int> sum;
+  cass::Atomic<bool> is_closed;
+};
+
+static int get_thread_id(void* data) {
+  *static_cast<uv_thread_t*>(data) = uv_thread_self();
+  return 42;
+}
+
+template <class T>
+static void wait_for(const cass::Atomic<T>& value, T expected) {
+  for (int i = 0; i < 1000 && value.load() != expected; ++i) {
+    uv_sleep(1);
+  }
+}
+
+TEST(SharedIOThreadsUnitTest, RunTask)
+{
+  cass::SharedIOThreads shared_io_threads(2);
+  ASSERT_EQ(0, shared_io_threads.init());
+  EXPECT_EQ(2u, shared_io_threads.num_threads());
+
+  uv_thread_t self = uv_thread_self();
+  uv_thread_t thread_id0, thread_id1;
+  EXPECT_EQ(42, shared_io_threads.run_task(0, get_thread_id, &thread_id0));
+  EXPECT_EQ(42, shared_io_threads.run_task(1, get_thread_id, &thread_id1));
+  EXPECT_FALSE(uv_thread_equal(&self, &thread_id0));
+  EXPECT_FALSE(uv_thread_equal(&self, &thread_id1));
+  EXPECT_FALSE(uv_thread_equal(&thread_id0, &thread_id1));
+}
+
+TEST(SharedIOThreadsUnitTest, NextThreadIndex)
+{
+  cass::SharedIOThreads shared_io_threads(2);
+  ASSERT_EQ(0, shared_io_threads.init());
+
+  EXPECT_EQ(0u, shared_io_threads.next_thread_index());
+  EXPECT_EQ(1u, shared_io_threads.next_thread_index());
+  EXPECT_EQ(0u, shared_io_threads.next_thread_index());
+}
+
+TEST(SharedIOThreadsUnitTest, AttachedThread)
+{
+  cass::SharedIOThreads shared_io_threads(1);
+  ASSERT_EQ(0, shared_io_threads.init());
+
+  TestAttachedThread first, second;
+  first.attach(shared_io_threads.loop(0));
+  second.attach(shared_io_threads.loop(0));
+  EXPECT_TRUE(first.is_attached());
+  EXPECT_EQ(shared_io_threads.loop(0), first.loop());
+  ASSERT_EQ(0, shared_io_threads.run_task(0, TestAttachedThread::on_init, &first));
+  ASSERT_EQ(0, shared_io_threads.run_task(0, TestAttachedThread::on_init, &second));
+
+  // Attached threads don't create threads of their own
+  EXPECT_EQ(0, first.run());
+  first.join();
+
+  for (int i = 1; i <= 10; ++i) {
+    EXPECT_TRUE(first.send_event_async(i));
+    EXPECT_TRUE(second.send_event_async(2 * i));
+  }
+
+  wait_for(first.sum, 55);
+  wait_for(second.sum, 110);
+  EXPECT_EQ(55, first.sum.load());
+  EXPECT_EQ(110, second.sum.load());
+
+  // Closing one attached thread doesn't stop the shared loop
+  ASSERT_EQ(0, shared_io_threads.run_task(0, TestAttachedThread::on_close, &first));
+  wait_for(first.is_closed, true);
+  EXPECT_TRUE(first.is_closed.load());
+  EXPECT_FALSE(second.is_closed.load());
+
+  ASSERT_EQ(0, shared_io_threads.run_task(0, TestAttachedThread::on_close, &second));
+  wait_for(second.is_closed, true);
+  EXPECT_TRUE(second.is_closed.load());
+}
@@ -0,0 +1,134 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "statement_metrics.hpp"
+
+TEST(StatementMetricsUnitTest, Record) {
+  cass::StatementMetrics metrics(1, 10);
+
+  cass::StatementMetrics::Entry::Ptr select(metrics.get("id1", "SELECT"));
+  cass::StatementMetrics::Entry::Ptr insert(metrics.get("id2", "INSERT"));
+  EXPECT_EQ(select.get(), metrics.get("id1", "SELECT").get());
+  EXPECT_EQ(2u, metrics.size());
+
+  select->record_response(1000 * 1000, 10, 100); // 1 ms
+  select->record_response(3000 * 1000, 5, 50); // 3 ms
+  select->record_error();
+  insert->record_response(2000 * 1000, 0, 10);
+
+  cass::StatementMetrics::SnapshotVec snapshots;
+  metrics.snapshot(&snapshots);
+  ASSERT_EQ(2u, snapshots.size());
+
+  EXPECT_EQ("id1", snapshots[0].prepared_id);
+  EXPECT_EQ("SELECT", snapshots[0].query);
+  EXPECT_EQ(2u, snapshots[0].requests);
+  EXPECT_EQ(1u, snapshots[0].errors);
+  EXPECT_EQ(15u, snapshots[0].rows);
+  EXPECT_EQ(150u, snapshots[0].bytes);
+  EXPECT_NEAR(1000, snapshots[0].latencies.min, 10);
+  EXPECT_NEAR(3000, snapshots[0].latencies.max, 30);
+
+  EXPECT_EQ("id2", snapshots[1].prepared_id);
+  EXPECT_EQ(1u, snapshots[1].requests);
+  EXPECT_EQ(0u, snapshots[1].errors);
+}
+
+TEST(StatementMetricsUnitTest, MaxStatements) {
+  cass::StatementMetrics metrics(1, 2);
+
+  cass::StatementMetrics::Entry::Ptr id1(metrics.get("id1", "query1"));
+  id1->record_response(1000, 0, 0);
+  id1->record_response(1000, 0, 0);
+  cass::StatementMetrics::Entry::Ptr id2(metrics.get("id2", "query2"));
+  id2->record_response(1000, 0, 0);
+
+  // Replaces the statement with the fewest requests
+  metrics.get("id3", "query3");
+  EXPECT_EQ(2u, metrics.size());
+
+  cass::StatementMetrics::SnapshotVec snapshots;
+  metrics.snapshot(&snapshots);
+  ASSERT_EQ(2u, snapshots.size());
+  EXPECT_EQ("id1", snapshots[0].prepared_id);
+  EXPECT_EQ("id3", snapshots[1].prepared_id);
+}
+
+TEST(StatementMetricsUnitTest, SampledAdmission) {
+  cass::StatementMetrics metrics(1, 2);
+
+  cass::StatementMetrics::Entry::Ptr id1(metrics.get("id1", "query1"));
+  id1->record_response(1000, 0, 0);
+  id1->record_response(1000, 0, 0);
+  id1->record_response(1000, 0, 0);
+  cass::StatementMetrics::Entry::Ptr id2(metrics.get("id2", "query2"));
+  id2->record_response(1000, 0, 0);
+  id2->record_response(1000, 0, 0);
+
+  // The first untracked statement replaces the statement with the fewest
+  // requests and inherits its requests
+  cass::StatementMetrics::Entry::Ptr id3(metrics.get("id3", "query3"));
+  ASSERT_TRUE(id3);
+  EXPECT_EQ(0u, id3->requests());
+  EXPECT_EQ(2u, id3->estimated_requests());
+  id3->record_response(1000, 0, 0);
+  id3->record_response(1000, 0, 0);
+
+  // Only one in every interval of untracked executions is admitted
+  for (uint64_t i = 1; i < cass::StatementMetrics::ADMISSION_INTERVAL; ++i) {
+    EXPECT_FALSE(metrics.get("id4", "query4"));
+  }
+  EXPECT_EQ(id3.get(), metrics.get("id3", "query3").get());
+
+  // The next admission evicts "id1" even though it has more requests than
+  // "id3" because "id3" inherited the requests of "id2"
+  cass::StatementMetrics::Entry::Ptr id4(metrics.get("id4", "query4"));
+  ASSERT_TRUE(id4);
+  EXPECT_EQ(3u, id4->estimated_requests());
+  EXPECT_EQ(2u, metrics.size());
+
+  cass::StatementMetrics::SnapshotVec snapshots;
+  metrics.snapshot(&snapshots);
+  ASSERT_EQ(2u, snapshots.size());
+  EXPECT_EQ("id3", snapshots[0].prepared_id);
+  EXPECT_EQ(2u, snapshots[0].requests);
+  EXPECT_EQ("id4", snapshots[1].prepared_id);
+  EXPECT_EQ(0u, snapshots[1].requests);
+}
+
+TEST(StatementMetricsUnitTest, Iterator) {
+  cass::StatementMetrics metrics(1, 10);
+  metrics.get("id1", "SELECT")->record_response(1000 * 1000, 1, 1);
+
+  CassIterator* iterator = CassIterator::to(new cass::StatementMetricsIterator(metrics));
+  EXPECT_EQ(CASS_ITERATOR_TYPE_STATEMENT_METRICS, cass_iterator_type(iterator));
+
+  CassStatementMetrics output;
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+            cass_iterator_get_statement_metrics(iterator, &output));
+
+  ASSERT_TRUE(cass_iterator_next(iterator));
+  ASSERT_EQ(CASS_OK, cass_iterator_get_statement_metrics(iterator, &output));
+  EXPECT_EQ("SELECT", std::string(output.query, output.query_length));
+  EXPECT_EQ("id1", std::string(reinterpret_cast<const char*>(output.prepared_id),
+                               output.prepared_id_size));
+  EXPECT_EQ(1u, output.requests);
+
+  EXPECT_FALSE(cass_iterator_next(iterator));
+  cass_iterator_free(iterator);
+}
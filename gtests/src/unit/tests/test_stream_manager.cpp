@@ -82,3 +82,23 @@ TEST(StreamManagerUnitTest, Release)
     ASSERT_LT(streams.acquire(streams.max_streams()), 0);
   }
 }
+
+TEST(StreamManagerUnitTest, GetPending)
+{
+  cass::StreamManager<int> streams(3);
+
+  int stream = streams.acquire(42);
+  ASSERT_GE(stream, 0);
+
+  // Verify the item is returned without releasing the stream
+  int item = -1;
+  EXPECT_TRUE(streams.get_pending(stream, item));
+  EXPECT_EQ(item, 42);
+  EXPECT_EQ(streams.pending_streams(), 1u);
+
+  item = -1;
+  EXPECT_TRUE(streams.get_pending_and_release(stream, item));
+  EXPECT_EQ(item, 42);
+  EXPECT_FALSE(streams.get_pending(stream, item));
+  EXPECT_EQ(streams.pending_streams(), 0u);
+}
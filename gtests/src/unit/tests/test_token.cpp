@@ -22,6 +22,7 @@
 
 #include <ctype.h>
 #include <stdio.h>
+#include <vector>
 
 namespace {
 
@@ -357,6 +358,39 @@ TEST(TokenUnitTest, RandomHash)
   EXPECT_EQ(to_string(cass::RandomPartitioner::hash("xyz")), "61893731502141497228477852773302439842");
 }
 
+TEST(TokenUnitTest, RandomHashMany)
+{
+  // The sampled tokens of RandomHash and a key that spans two MD5 blocks,
+  // repeated so that the count isn't a multiple of the SIMD lane count
+  const char* keys[] = { "a", "b", "c", "d", "abc", "xyz",
+    "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef" };
+  const char* expected[] = {
+    "16955237001963240173058271559858726497",
+    "144992942750327304334463589818972416113",
+    "99079589977253916124855502156832923443",
+    "166860289390734216023086131251507064403",
+    "148866708576779697295343134153845407886",
+    "61893731502141497228477852773302439842",
+    NULL
+  };
+  const size_t count = sizeof(keys) / sizeof(keys[0]);
+
+  std::vector<cass::StringRef> refs;
+  for (size_t n = 0; n < 3 * count; ++n) {
+    refs.push_back(keys[n % count]);
+  }
+
+  std::vector<cass::RandomPartitioner::Token> tokens(refs.size());
+  cass::RandomPartitioner::hash_many(&refs[0], refs.size(), &tokens[0]);
+
+  for (size_t i = 0; i < refs.size(); ++i) {
+    if (expected[i % count] != NULL) {
+      EXPECT_EQ(expected[i % count], to_string(tokens[i]));
+    }
+    EXPECT_TRUE(cass::RandomPartitioner::hash(refs[i]) == tokens[i]);
+  }
+}
+
 TEST(TokenUnitTest, RandomFromString)
 {
   EXPECT_EQ(to_string(cass::RandomPartitioner::from_string("0")), "0");
@@ -20,6 +20,11 @@
 
 #include "test_token_map_utils.hpp"
 
+#include "atomic.hpp"
+#include "scoped_lock.hpp"
+
+#include <uv.h>
+
 namespace {
 
 template <class Partitioner>
@@ -70,8 +75,138 @@ struct TestTokenMap {
   }
 };
 
+// Rebuilds a token map and publishes snapshots of it the same way the
+// session does
+struct SnapshotRebuilder {
+  SnapshotRebuilder()
+    : token_map(cass::TokenMap::from_partitioner(cass::Murmur3Partitioner::name()))
+    , is_done(false) {
+    uv_mutex_init(&mutex);
+  }
+
+  ~SnapshotRebuilder() {
+    uv_mutex_destroy(&mutex);
+  }
+
+  void publish() {
+    cass::TokenMapSnapshot::ConstPtr copy(new cass::TokenMapSnapshot(*token_map));
+    cass::ScopedMutex l(&mutex);
+    snapshot = copy;
+  }
+
+  cass::TokenMapSnapshot::ConstPtr get() {
+    cass::ScopedMutex l(&mutex);
+    return snapshot;
+  }
+
+  static void rebuild(void* arg) {
+    SnapshotRebuilder* rebuilder = static_cast<SnapshotRebuilder*>(arg);
+    cass::Host::Ptr host(create_host("1.0.0.2"));
+    TokenCollectionBuilder builder;
+    builder.append_token(static_cast<int64_t>(0));
+    const cass::Value* tokens = builder.finish();
+    for (int i = 0; i < 200; ++i) {
+      rebuilder->token_map->update_host_and_build(host, tokens);
+      rebuilder->publish();
+      rebuilder->token_map->remove_host_and_build(host);
+      rebuilder->publish();
+    }
+    rebuilder->is_done.store(true);
+  }
+
+  cass::ScopedPtr<cass::TokenMap> token_map;
+  cass::TokenMapSnapshot::ConstPtr snapshot;
+  uv_mutex_t mutex;
+  cass::Atomic<bool> is_done;
+};
+
 } // namespace
 
+TEST(TokenMapUnitTest, Snapshot)
+{
+  TestTokenMap<cass::Murmur3Partitioner> test_snapshot;
+
+  test_snapshot.tokens[CASS_INT64_MIN / 2] = create_host("1.0.0.1");
+  test_snapshot.build("ks", 3);
+
+  cass::TokenMapSnapshot::ConstPtr snapshot(
+        new cass::TokenMapSnapshot(*test_snapshot.token_map));
+
+  // Later rebuilds don't change the snapshot
+  cass::Host::Ptr host(create_host("1.0.0.2"));
+  TokenCollectionBuilder builder;
+  builder.append_token(static_cast<int64_t>(0));
+  test_snapshot.token_map->update_host_and_build(host, builder.finish());
+
+  const cass::CopyOnWriteHostVec& replicas = snapshot->token_map()->get_replicas("ks", "abc");
+  ASSERT_TRUE(replicas && replicas->size() == 1);
+  EXPECT_EQ(cass::Address("1.0.0.1", 9042), replicas->front()->address());
+
+  const cass::CopyOnWriteHostVec& updated =
+      test_snapshot.token_map->get_replicas("ks", "abc");
+  ASSERT_TRUE(updated && updated->size() == 2);
+}
+
+TEST(TokenMapUnitTest, SnapshotDuringRebuild)
+{
+  SnapshotRebuilder rebuilder;
+  add_keyspace_simple("ks", 3, rebuilder.token_map.get());
+  TokenCollectionBuilder builder;
+  builder.append_token(CASS_INT64_MIN / 2);
+  rebuilder.token_map->add_host(create_host("1.0.0.1"), builder.finish());
+  rebuilder.token_map->build();
+  rebuilder.publish();
+
+  uv_thread_t thread;
+  ASSERT_EQ(0, uv_thread_create(&thread, SnapshotRebuilder::rebuild, &rebuilder));
+
+  // Look up replicas in the snapshots while the token map is rebuilt
+  const std::string keys[] = { "test", "abc", "def", "a", "b", "c", "d" };
+  const size_t count = sizeof(keys) / sizeof(keys[0]);
+  int lookups = 0;
+  while (!rebuilder.is_done.load() || lookups == 0) {
+    cass::TokenMapSnapshot::ConstPtr snapshot(rebuilder.get());
+    std::vector<cass::CopyOnWriteHostVec> replicas;
+    int64_t tokens[count];
+    ASSERT_TRUE(snapshot->token_map()->get_tokens_and_replicas("ks", keys, count, tokens, &replicas));
+    ASSERT_EQ(count, replicas.size());
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_TRUE(replicas[i]);
+      ASSERT_TRUE(replicas[i]->size() == 1 || replicas[i]->size() == 2);
+      EXPECT_EQ(replicas[0]->size(), replicas[i]->size());
+    }
+    ++lookups;
+  }
+
+  uv_thread_join(&thread);
+}
+
+TEST(TokenMapUnitTest, RandomTokensAndReplicas)
+{
+  TestTokenMap<cass::RandomPartitioner> test_random;
+
+  test_random.tokens[create_random_token("42535295865117307932921825928971026432")] = create_host("1.0.0.1");
+  test_random.tokens[create_random_token("85070591730234615865843651857942052864")] = create_host("1.0.0.2");
+  test_random.tokens[create_random_token("127605887595351923798765477786913079296")] = create_host("1.0.0.3");
+  test_random.build("ks", 1);
+
+  // Enough keys of different lengths to be hashed several at a time
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < 37; ++i) {
+    keys.push_back(std::string(i * 3, 'a' + i % 26));
+  }
+
+  std::vector<cass::CopyOnWriteHostVec> replicas;
+  int64_t tokens[1];
+  EXPECT_FALSE(test_random.token_map->get_tokens_and_replicas("ks", &keys[0], keys.size(),
+                                                              tokens, &replicas));
+  ASSERT_EQ(keys.size(), replicas.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_TRUE(replicas[i] && replicas[i]->size() == 1);
+    EXPECT_EQ(test_random.get_replica(keys[i])->address(), replicas[i]->front()->address());
+  }
+}
+
 TEST(TokenMapUnitTest, Murmur3)
 {
   TestTokenMap<cass::Murmur3Partitioner> test_murmur3;
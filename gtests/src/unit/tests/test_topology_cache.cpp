@@ -0,0 +1,123 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "topology_cache.hpp"
+
+#include <cstdio>
+
+static cass::TopologyCache create_cache() {
+  cass::TopologyCache cache;
+
+  cass::TopologyCache::HostEntry host;
+  host.address = "127.0.0.1";
+  host.port = 9042;
+  host.dc = "dc1";
+  host.rack = "rack1";
+  host.release_version = "3.9.0";
+  cache.hosts().push_back(host);
+  host.address = "127.0.0.2";
+  host.rack = "rack2";
+  cache.hosts().push_back(host);
+
+  std::list<cass::PartitionMetadata> partitions;
+  cass::PartitionMetadata partition(0x8000, 0x10000);
+  partition.host_ips_.push_back("127.0.0.2");
+  partition.host_ips_.push_back("127.0.0.1");
+  partitions.push_back(partition);
+  partition = cass::PartitionMetadata(0, 0x8000);
+  partition.host_ips_.push_back("127.0.0.1");
+  partitions.push_back(partition);
+  cache.partitions()["ks.table"] = cass::TableSplitMetadata(partitions);
+
+  return cache;
+}
+
+TEST(TopologyCacheUnitTest, EncodeDecode) {
+  std::string data;
+  create_cache().encode(&data);
+
+  cass::TopologyCache cache;
+  ASSERT_TRUE(cache.decode(data.data(), data.size()));
+
+  ASSERT_EQ(2u, cache.hosts().size());
+  EXPECT_EQ("127.0.0.1", cache.hosts()[0].address);
+  EXPECT_EQ(9042, cache.hosts()[0].port);
+  EXPECT_EQ("dc1", cache.hosts()[0].dc);
+  EXPECT_EQ("rack1", cache.hosts()[0].rack);
+  EXPECT_EQ("3.9.0", cache.hosts()[0].release_version);
+  EXPECT_EQ("rack2", cache.hosts()[1].rack);
+
+  ASSERT_EQ(1u, cache.partitions().size());
+  const cass::TableSplitMetadata& table = cache.partitions()["ks.table"];
+  ASSERT_EQ(2u, table.partitions().size());
+
+  const cass::PartitionMetadata::IpList* hosts = table.get_hosts(0x9000);
+  ASSERT_TRUE(hosts != NULL);
+  ASSERT_EQ(2u, hosts->size());
+  EXPECT_EQ("127.0.0.2", hosts->front());
+
+  hosts = table.get_hosts(0x100);
+  ASSERT_TRUE(hosts != NULL);
+  ASSERT_EQ(1u, hosts->size());
+  EXPECT_EQ("127.0.0.1", hosts->front());
+}
+
+TEST(TopologyCacheUnitTest, DecodeInvalid) {
+  std::string data;
+  create_cache().encode(&data);
+
+  cass::TopologyCache cache;
+
+  // Truncated
+  EXPECT_FALSE(cache.decode(data.data(), data.size() - 1));
+  EXPECT_FALSE(cache.decode(data.data(), 4));
+
+  // Corrupted payload
+  std::string corrupted(data);
+  corrupted[corrupted.size() / 2] ^= 0x01;
+  EXPECT_FALSE(cache.decode(corrupted.data(), corrupted.size()));
+
+  // Different magic
+  corrupted = data;
+  corrupted[0] = 'X';
+  EXPECT_FALSE(cache.decode(corrupted.data(), corrupted.size()));
+
+  // Different version
+  corrupted = data;
+  corrupted[5] = static_cast<char>(cass::TopologyCache::VERSION + 1);
+  EXPECT_FALSE(cache.decode(corrupted.data(), corrupted.size()));
+
+  EXPECT_TRUE(cache.empty());
+  EXPECT_TRUE(cache.decode(data.data(), data.size()));
+}
+
+TEST(TopologyCacheUnitTest, SaveLoad) {
+  const std::string path("test_topology_cache.bin");
+  std::remove(path.c_str());
+
+  cass::TopologyCache cache;
+  EXPECT_FALSE(cache.load(path));
+
+  ASSERT_TRUE(create_cache().save(path));
+  ASSERT_TRUE(create_cache().save(path)); // Replace an existing file
+  ASSERT_TRUE(cache.load(path));
+  EXPECT_EQ(2u, cache.hosts().size());
+  EXPECT_EQ(1u, cache.partitions().size());
+
+  std::remove(path.c_str());
+}
@@ -418,6 +418,35 @@ typedef struct CassUuidGen_ CassUuidGen;
  */
 typedef struct CassTimestampGen_ CassTimestampGen;
 
+/**
+ * A group of I/O threads that can be shared by multiple sessions.
+ *
+ * @struct CassSharedIoThreads
+ */
+typedef struct CassSharedIoThreads_ CassSharedIoThreads;
+
+/**
+ * The tokens and replicas of a group of bound statements.
+ *
+ * @struct CassReplicaLookup
+ */
+typedef struct CassReplicaLookup_ CassReplicaLookup;
+
+/**
+ * A copy of the session's most frequently requested partitions or tablets.
+ *
+ * @struct CassPartitionStats
+ */
+typedef struct CassPartitionStats_ CassPartitionStats;
+
+/**
+ * A loader that writes rows from a prepared INSERT in batches grouped by
+ * replica.
+ *
+ * @struct CassBulkLoader
+ */
+typedef struct CassBulkLoader_ CassBulkLoader;
+
 /**
  * @struct CassRetryPolicy
  */
@@ -468,6 +497,97 @@ typedef struct CassMetrics_ {
 
 } CassMetrics;
 
+/**
+ * A snapshot of the session's retry budget metrics.
+ *
+ * @struct CassRetryBudgetMetrics
+ *
+ * @see cass_retry_policy_budget_new()
+ */
+typedef struct CassRetryBudgetMetrics_ {
+  cass_uint64_t allowed; /**< Retries allowed by the retry policy's budget */
+  cass_uint64_t denied; /**< Retries denied because the retry budget was exhausted */
+} CassRetryBudgetMetrics;
+
+/**
+ * A snapshot of the session's result cache metrics.
+ *
+ * @struct CassResultCacheMetrics
+ *
+ * @see cass_cluster_set_result_cache()
+ */
+typedef struct CassResultCacheMetrics_ {
+  cass_uint64_t hits; /**< Requests served from the result cache */
+  cass_uint64_t misses; /**< Cacheable requests sent to the cluster */
+  cass_uint64_t evictions; /**< Results evicted because the cache was full */
+} CassResultCacheMetrics;
+
+/**
+ * The traffic statistics of a partition or a tablet.
+ *
+ * @struct CassPartitionStatsEntry
+ */
+typedef struct CassPartitionStatsEntry_ {
+  const char* table; /**< The full table name (keyspace.table) */
+  size_t table_length; /**< The length of the table name */
+  cass_int64_t start; /**< The partition token or the tablet's start hash code */
+  cass_int64_t end; /**< The partition token or the tablet's end hash code (exclusive) */
+  cass_uint64_t requests; /**< Estimated number of requests */
+  cass_uint64_t error; /**< Maximum overestimation of the number of requests */
+  cass_uint64_t bytes; /**< Estimated number of response bytes */
+  cass_uint64_t mean_latency; /**< Mean latency in microseconds */
+} CassPartitionStatsEntry;
+
+/**
+ * The progress of a bulk load.
+ *
+ * @struct CassBulkLoaderStats
+ */
+typedef struct CassBulkLoaderStats_ {
+  cass_uint64_t rows; /**< Rows written */
+  cass_uint64_t batches; /**< Batches written */
+  cass_uint64_t failed_rows; /**< Rows that couldn't be written (including rows without a partition key) */
+  cass_uint64_t failed_batches; /**< Batches that couldn't be written */
+  cass_uint64_t retries; /**< Batches that were retried */
+  cass_uint64_t elapsed_ms; /**< Time since the start of the load in milliseconds */
+  cass_double_t rows_per_second; /**< Mean rate of written rows */
+} CassBulkLoaderStats;
+
+/**
+ * A snapshot of a prepared statement's performance/diagnostic metrics.
+ *
+ * @struct CassStatementMetrics
+ */
+typedef struct CassStatementMetrics_ {
+  const cass_byte_t* prepared_id; /**< The prepared statement's ID */
+  size_t prepared_id_size; /**< The size of the prepared statement's ID */
+  const char* query; /**< The prepared statement's query */
+  size_t query_length; /**< The length of the prepared statement's query */
+
+  struct {
+    cass_uint64_t min; /**< Minimum in microseconds */
+    cass_uint64_t max; /**< Maximum in microseconds */
+    cass_uint64_t mean; /**< Mean in microseconds */
+    cass_uint64_t stddev; /**< Standard deviation in microseconds */
+    cass_uint64_t median; /**< Median in microseconds */
+    cass_uint64_t percentile_75th; /**< 75th percentile in microseconds */
+    cass_uint64_t percentile_95th; /**< 95th percentile in microseconds */
+    cass_uint64_t percentile_98th; /**< 98th percentile in microseconds */
+    cass_uint64_t percentile_99th; /**< 99the percentile in microseconds */
+    cass_uint64_t percentile_999th; /**< 99.9th percentile in microseconds */
+  } latencies; /**< Latencies of the successful requests */
+
+  cass_uint64_t requests; /**< The number of successful requests */
+  cass_uint64_t errors; /**< The number of failed requests */
+  cass_uint64_t rows; /**< The number of rows returned */
+  cass_uint64_t bytes; /**< The number of response bytes received */
+} CassStatementMetrics;
+
+typedef enum CassPartitionStatsType_ {
+  CASS_PARTITION_STATS_TYPE_PARTITION,
+  CASS_PARTITION_STATS_TYPE_TABLET
+} CassPartitionStatsType;
+
 typedef enum CassConsistency_ {
   CASS_CONSISTENCY_UNKNOWN      = 0xFFFF,
   CASS_CONSISTENCY_ANY          = 0x0000,
@@ -616,7 +736,8 @@ typedef enum CassIteratorType_ {
   CASS_ITERATOR_TYPE_AGGREGATE_META,
   CASS_ITERATOR_TYPE_COLUMN_META,
   CASS_ITERATOR_TYPE_INDEX_META,
-  CASS_ITERATOR_TYPE_MATERIALIZED_VIEW_META
+  CASS_ITERATOR_TYPE_MATERIALIZED_VIEW_META,
+  CASS_ITERATOR_TYPE_STATEMENT_METRICS
 } CassIteratorType;
 
 #define CASS_LOG_LEVEL_MAPPING(XX) \
@@ -698,6 +819,7 @@ typedef enum  CassErrorSource_ {
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_NOT_ENOUGH_DATA, 31, "Not enough data") \
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_INVALID_STATE, 32, "Invalid state") \
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_NO_CUSTOM_PAYLOAD, 33, "No custom payload") \
+  XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_REQUEST_CANCELLED, 34, "Request cancelled") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_SERVER_ERROR, 0x0000, "Server error") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_PROTOCOL_ERROR, 0x000A, "Protocol error") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_BAD_CREDENTIALS, 0x0100, "Bad credentials") \
@@ -783,6 +905,41 @@ typedef struct CassLogMessage_ {
 typedef void (*CassLogCallback)(const CassLogMessage* message,
                                 void* data);
 
+/**
+ * A callback that's used to release memory that was bound by reference.
+ *
+ * @param[in] data user defined data provided when the memory was bound.
+ *
+ * @see cass_statement_bind_bytes_external()
+ */
+typedef void (*CassBufferReleaseCallback)(void* data);
+
+/**
+ * A callback that's used to produce the rows of a bulk load.
+ *
+ * @param[in] statement A statement bound from the loader's prepared
+ * statement. The row's values must be bound to it.
+ * @param[in] data user defined data provided when the load was started.
+ * @return cass_true if a row was bound, cass_false when there are no more
+ * rows. The statement is discarded in that case.
+ *
+ * @see cass_bulk_loader_run()
+ */
+typedef cass_bool_t (*CassBulkLoaderRowCallback)(CassStatement* statement,
+                                                 void* data);
+
+/**
+ * A callback that's notified when a bulk load's batch completes.
+ *
+ * @param[in] stats The progress of the load.
+ * @param[in] data user defined data provided when the callback
+ * was registered.
+ *
+ * @see cass_bulk_loader_set_progress_callback()
+ */
+typedef void (*CassBulkLoaderProgressCallback)(const CassBulkLoaderStats* stats,
+                                               void* data);
+
 /**
  * An authenticator.
  *
@@ -1433,6 +1590,52 @@ cass_cluster_set_partition_aware_routing(CassCluster* cluster,
                                          cass_bool_t enabled,
                                          cass_int32_t refresh_frequency_secs);
 
+/**
+ * Configures partition-aware routing to serve single replica reads from
+ * followers. Reads of prepared statements executed with a consistency of
+ * CASS_CONSISTENCY_ONE or CASS_CONSISTENCY_LOCAL_ONE are routed to the
+ * follower replicas in the local rack first, then to the other local
+ * followers ordered by measured latency, and finally to the leader. All
+ * other requests are still routed to the leader first.
+ *
+ * <b>Important:</b> Follower reads may return stale data.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @param[in] local_rack The rack of the client. Use NULL or an empty string
+ * to order the local followers by latency only.
+ *
+ * @see cass_cluster_set_partition_aware_routing()
+ */
+CASS_EXPORT void
+cass_cluster_set_partition_aware_follower_reads(CassCluster* cluster,
+                                                cass_bool_t enabled,
+                                                const char* local_rack);
+
+/**
+ * Same as cass_cluster_set_partition_aware_follower_reads(), but with lengths
+ * for string parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @param[in] local_rack
+ * @param[in] local_rack_length
+ * @return same as cass_cluster_set_partition_aware_follower_reads()
+ *
+ * @see cass_cluster_set_partition_aware_follower_reads()
+ */
+CASS_EXPORT void
+cass_cluster_set_partition_aware_follower_reads_n(CassCluster* cluster,
+                                                  cass_bool_t enabled,
+                                                  const char* local_rack,
+                                                  size_t local_rack_length);
+
 /**
  * Configures the cluster to use token-aware request routing or not.
  *
@@ -1509,6 +1712,59 @@ cass_cluster_set_latency_aware_routing_settings(CassCluster* cluster,
                                                 cass_uint64_t update_rate_ms,
                                                 cass_uint64_t min_measured);
 
+/**
+ * Configures the cluster to use a per-host circuit breaker or not.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * This routing policy is a top-level routing policy. It tracks the outcome
+ * of requests sent to each host and, when the ratio of failures (timeouts,
+ * overloaded and server errors) within a window exceeds a threshold, opens
+ * the host's circuit breaker. Hosts with an open breaker are moved to the
+ * end of the query plan. After the open period a single probe request is
+ * routed to the host; a successful probe closes the breaker.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ *
+ * @see cass_cluster_set_circuit_breaker_settings()
+ */
+CASS_EXPORT void
+cass_cluster_set_circuit_breaker(CassCluster* cluster,
+                                 cass_bool_t enabled);
+
+/**
+ * Configures the settings for the per-host circuit breaker.
+ *
+ * <b>Defaults:</b>
+ *
+ * <ul>
+ *   <li>failure_threshold: 0.5</li>
+ *   <li>min_requests: 20</li>
+ *   <li>window_ms: 10,000 milliseconds (10 seconds)</li>
+ *   <li>open_ms: 5,000 milliseconds (5 seconds)</li>
+ * </ul>
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] failure_threshold The ratio of failed requests to total requests
+ * within a window that opens the breaker.
+ * @param[in] min_requests The minimum number of requests within a window
+ * before the breaker can open.
+ * @param[in] window_ms The duration of the window used to count requests.
+ * @param[in] open_ms The amount of time a host is avoided before a probe
+ * request is allowed through.
+ */
+CASS_EXPORT void
+cass_cluster_set_circuit_breaker_settings(CassCluster* cluster,
+                                          cass_double_t failure_threshold,
+                                          cass_uint64_t min_requests,
+                                          cass_uint64_t window_ms,
+                                          cass_uint64_t open_ms);
+
 /**
  * Sets/Appends whitelist hosts. The first call sets the whitelist hosts and
  * any subsequent calls appends additional hosts. Passing an empty string will
@@ -1711,6 +1967,36 @@ CASS_EXPORT void
 cass_cluster_set_timestamp_gen(CassCluster* cluster,
                                CassTimestampGen* timestamp_gen);
 
+/**
+ * Sets the shared I/O threads. The I/O workers of sessions connected using
+ * this cluster are run on the shared threads instead of creating their
+ * own threads. Sessions using the same shared threads share them so the
+ * number of I/O threads per process doesn't grow with the number of
+ * sessions.
+ *
+ * <b>Note:</b> Only the I/O workers are shared. Each session still runs
+ * its own session thread, which handles the control connection, and keeps
+ * its own connection pools, so every session adds one thread and its own
+ * connections to each host.
+ *
+ * <b>Note:</b> The I/O worker count of a session is still controlled by
+ * cass_cluster_set_num_threads_io(). Its workers are distributed across
+ * the shared threads.
+ *
+ * <b>Default:</b> NULL (each session creates its own I/O threads)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] shared_io_threads Shared I/O threads or NULL to use per-session
+ * I/O threads
+ *
+ * @see cass_shared_io_threads_new()
+ */
+CASS_EXPORT void
+cass_cluster_set_shared_io_threads(CassCluster* cluster,
+                                   CassSharedIoThreads* shared_io_threads);
+
 /**
  * Sets the amount of time between heartbeat messages and controls the amount
  * of time the connection must be idle before sending heartbeat messages. This
@@ -1911,6 +2197,254 @@ CASS_EXPORT CassError
 cass_cluster_set_no_compact(CassCluster* cluster,
                             cass_bool_t enabled);
 
+/**
+ * Enables running the sessions' event loop on the application's thread.
+ * Sessions connected using this cluster don't create any threads of their
+ * own. Instead, the application drives the session's loop using
+ * cass_session_event_loop_run() from its own reactor, for example when
+ * the file descriptor returned by cass_session_event_loop_fd() is readable
+ * or when the timeout returned by cass_session_event_loop_timeout()
+ * expires.
+ *
+ * Requests are dispatched directly on the calling thread and future
+ * callbacks are run by cass_session_event_loop_run() on the same thread,
+ * without handing them off to another thread.
+ *
+ * <b>Important:</b> All calls on the session (connecting, executing,
+ * closing) must be made from the thread that runs the loop. Futures must
+ * not be waited on from that thread, use cass_future_set_callback() or
+ * cass_future_ready() instead. The application should ignore SIGPIPE.
+ *
+ * <b>Note:</b> A single I/O worker is used and the value set using
+ * cass_cluster_set_num_threads_io() and cass_cluster_set_shared_io_threads()
+ * are ignored.
+ *
+ * <b>Default:</b> cass_false
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_session_event_loop_run()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_external_event_loop(CassCluster* cluster,
+                                     cass_bool_t enabled);
+
+/**
+ * Enables encoding requests on the thread that executes them.
+ *
+ * By default requests are encoded by the I/O threads right before they're
+ * written to a connection. When enabled, the frame body is encoded by
+ * cass_session_execute() and cass_session_execute_batch() on the calling
+ * thread, so the encoding work is spread across the application's threads
+ * and the I/O threads only write the bytes. The frame header (including
+ * the stream ID) is still written by the I/O threads.
+ *
+ * A request is re-encoded by the I/O threads only if the protocol version
+ * used by its connection differs from the session's (e.g. after a protocol
+ * downgrade) or if the retry policy changes its consistency.
+ *
+ * <b>Default:</b> cass_false
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred
+ */
+CASS_EXPORT CassError
+cass_cluster_set_pre_encode_requests(CassCluster* cluster,
+                                     cass_bool_t enabled);
+
+/**
+ * Enables the session's result cache for prepared reads. Bound statements
+ * that opt in using cass_statement_set_use_result_cache() are served from
+ * the cache, without a request to the cluster, when a result for the same
+ * prepared statement and bound values was received within the TTL.
+ *
+ * <b>Default:</b> 0 (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] max_entries The maximum number of cached results. The oldest
+ * results are evicted first when the cache is full. Use 0 to disable the
+ * cache.
+ * @param[in] ttl_ms The amount of time a result is served from the cache.
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_result_cache_invalidation()
+ * @see cass_session_get_result_cache_metrics()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_result_cache(CassCluster* cluster,
+                              unsigned max_entries,
+                              cass_uint64_t ttl_ms);
+
+/**
+ * Enables removing a table's cached results when a schema change event is
+ * received for the table (or its keyspace).
+ *
+ * <b>Default:</b> cass_true
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred
+ */
+CASS_EXPORT CassError
+cass_cluster_set_result_cache_invalidation(CassCluster* cluster,
+                                           cass_bool_t enabled);
+
+/**
+ * Enables coalescing identical reads that are in flight at the same time.
+ *
+ * Idempotent bound statements that return rows are coalesced when they use
+ * the same prepared statement, bound values, consistency, page size and
+ * paging state. Only the first of these requests is sent to the cluster and
+ * the futures of all of them are set from its response (or error).
+ * Statements with their own request timeout, retry policy or custom payload
+ * are never coalesced.
+ *
+ * <b>Note:</b> Cancelling the future of a coalesced request doesn't cancel
+ * the request sent to the cluster.
+ *
+ * <b>Default:</b> cass_false
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_statement_set_is_idempotent()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_request_coalescing(CassCluster* cluster,
+                                    cass_bool_t enabled);
+
+/**
+ * Sets a limit on the memory used by the pages of statements with adaptive
+ * paging. The expected size of a statement's next page is reserved when the
+ * statement is executed and released when the page is received or the
+ * request fails. When the budget is exhausted the page size of the
+ * execution is reduced (down to the statement's minimum page size).
+ *
+ * <b>Default:</b> 0 (unlimited)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] bytes
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_statement_set_adaptive_paging()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_paging_memory_budget(CassCluster* cluster,
+                                      cass_uint64_t bytes);
+
+/**
+ * Enables sampling the traffic of the session's partitions and tablets to
+ * find the most frequently requested ones.
+ *
+ * One in every sample_rate requests of bound statements (or batches of bound
+ * statements) is recorded by its partition token and, when the partitions of
+ * the table are known (partition-aware routing), by its tablet. Requests
+ * that fail, including timeouts, are recorded too. Without partition-aware
+ * routing the token is found using the cluster's partitioner, which
+ * requires token-aware routing and a partitioner with 64-bit tokens
+ * (Murmur3Partitioner). Only the top_k most frequent partitions and tablets
+ * are kept so the memory used is bounded and their counts are estimates.
+ *
+ * <b>Default:</b> 0 (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] sample_rate The number of requests per sampled request. Use 0
+ * to disable the statistics.
+ * @param[in] top_k The maximum number of partitions (and tablets) tracked.
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_BAD_PARAMS if
+ * top_k is 0 and the statistics are enabled.
+ *
+ * @see cass_session_get_partition_stats()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_partition_stats(CassCluster* cluster,
+                                 unsigned sample_rate,
+                                 unsigned top_k);
+
+/**
+ * Enables collecting latency, throughput and error metrics for each
+ * prepared statement executed by the session.
+ *
+ * <b>Default:</b> 0 (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] max_statements The maximum number of prepared statements
+ * tracked. When the limit is reached only a sample of the untracked
+ * statements' executions replace the statement with the fewest requests so
+ * that frequently executed statements end up being tracked. Use 0 to disable
+ * the metrics.
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_iterator_statement_metrics_from_session()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_statement_metrics(CassCluster* cluster,
+                                   unsigned max_statements);
+
+/**
+ * Sets the path of a file used to persist the cluster's topology (hosts,
+ * their datacenters and racks, and the partition map) between sessions.
+ *
+ * When the file exists and is valid, the session loads it while connecting:
+ * the cached hosts are added as contact points, the cached partition map is
+ * used for partition-aware routing and the session is connected as soon as
+ * the control connection has refreshed the hosts. The schema and the
+ * partition map are then refreshed in the background, and hosts that are no
+ * longer part of the cluster are removed. The file is rewritten every time
+ * the partition map is refreshed.
+ *
+ * <b>Important:</b> Until the background refresh completes, requests may be
+ * routed using a stale partition map and schema metadata may be incomplete.
+ *
+ * <b>Default:</b> NULL (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] path The file path. Use NULL or an empty string to disable
+ * the cache.
+ */
+CASS_EXPORT void
+cass_cluster_set_topology_cache(CassCluster* cluster,
+                                const char* path);
+
+/**
+ * Same as cass_cluster_set_topology_cache(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] path
+ * @param[in] path_length
+ *
+ * @see cass_cluster_set_topology_cache()
+ */
+CASS_EXPORT void
+cass_cluster_set_topology_cache_n(CassCluster* cluster,
+                                  const char* path,
+                                  size_t path_length);
+
 /***********************************************************************************
  *
  * Session
@@ -2111,6 +2645,37 @@ cass_session_execute_batch(CassSession* session,
 CASS_EXPORT const CassSchemaMeta*
 cass_session_get_schema_meta(const CassSession* session);
 
+/**
+ * Looks up the token and replicas of the partition key values bound to
+ * each statement in a single call. This can be used to group work by
+ * replica, for example to pin partitions to worker threads or to build
+ * per-node batches.
+ *
+ * When the partitions of a statement's table are known (partition-aware
+ * routing) the token is the YugaByte hash code of the partition key and the
+ * replicas are the hosts of the key's partition, leader first. Otherwise,
+ * the token and the replicas are found using the cluster's partitioner and
+ * the statement keyspace's replication strategy. This requires token-aware
+ * routing. Tokens are only returned for the Murmur3Partitioner.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statements An array of bound statements. Statements created
+ * from the same prepared statement should be adjacent.
+ * @param[in] statement_count
+ * @param[out] output A lookup result that must be freed.
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_BAD_PARAMS if one
+ * of the statements is not a bound statement.
+ *
+ * @see cass_replica_lookup_free()
+ */
+CASS_EXPORT CassError
+cass_session_lookup_replicas(const CassSession* session,
+                             const CassStatement* const* statements,
+                             size_t statement_count,
+                             CassReplicaLookup** output);
+
 /**
  * Gets a copy of this session's performance/diagnostic metrics.
  *
@@ -2123,6 +2688,118 @@ CASS_EXPORT void
 cass_session_get_metrics(const CassSession* session,
                          CassMetrics* output);
 
+/**
+ * Gets a copy of this session's retry budget metrics. Only the retries of
+ * requests that use a retry budget policy are counted, so the counters are
+ * zero if no retry budget policy is used.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_retry_policy_budget_new()
+ */
+CASS_EXPORT void
+cass_session_get_retry_budget_metrics(const CassSession* session,
+                                      CassRetryBudgetMetrics* output);
+
+/**
+ * Gets a copy of this session's result cache metrics. The counters are zero
+ * if the result cache is disabled.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_result_cache()
+ */
+CASS_EXPORT void
+cass_session_get_result_cache_metrics(const CassSession* session,
+                                      CassResultCacheMetrics* output);
+
+/**
+ * Gets a copy of the session's most frequently requested partitions or
+ * tablets, ordered from the most requested to the least requested.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] type
+ * @return The statistics that must be freed, or NULL if the statistics are
+ * not enabled.
+ *
+ * @see cass_cluster_set_partition_stats()
+ * @see cass_partition_stats_free()
+ */
+CASS_EXPORT CassPartitionStats*
+cass_session_get_partition_stats(const CassSession* session,
+                                 CassPartitionStatsType type);
+
+/**
+ * Clears the session's partition and tablet statistics.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ */
+CASS_EXPORT void
+cass_session_reset_partition_stats(CassSession* session);
+
+/**
+ * Gets the file descriptor of the session's event loop backend. The
+ * application should call cass_session_event_loop_run() when it's readable.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return The file descriptor or -1 if the session doesn't use an external
+ * event loop or if it isn't connected (or connecting).
+ *
+ * @see cass_cluster_set_external_event_loop()
+ */
+CASS_EXPORT int
+cass_session_event_loop_fd(CassSession* session);
+
+/**
+ * Gets the amount of time, in milliseconds, before the session's event loop
+ * must be run again to process its timers.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return The timeout, 0 if the loop should be run immediately or -1 if
+ * there's no timeout.
+ *
+ * @see cass_cluster_set_external_event_loop()
+ */
+CASS_EXPORT int
+cass_session_event_loop_timeout(CassSession* session);
+
+/**
+ * Runs a single iteration of the session's event loop on the calling
+ * thread. This processes the pending I/O, timers and requests, and runs
+ * the callbacks of the futures that were completed.
+ *
+ * <b>Note:</b> cass_session_free() runs the loop itself until the session
+ * is closed.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] nowait If cass_true then this doesn't block waiting for I/O,
+ * otherwise it blocks until there's at least one event to process.
+ * @return cass_true if the loop is still running, cass_false once the
+ * session has been completely closed or if the session doesn't use an
+ * external event loop.
+ *
+ * @see cass_cluster_set_external_event_loop()
+ */
+CASS_EXPORT cass_bool_t
+cass_session_event_loop_run(CassSession* session,
+                            cass_bool_t nowait);
+
 /***********************************************************************************
  *
  * Schema Metadata
@@ -3819,6 +4496,25 @@ CASS_EXPORT cass_bool_t
 cass_future_wait_timed(CassFuture* future,
                        cass_duration_t timeout_us);
 
+/**
+ * Cancels the request associated with a response future. The future is set
+ * immediately with the error CASS_ERROR_LIB_REQUEST_CANCELLED. Executions of
+ * the request that are still queued are removed, no further speculative
+ * executions or retries are started, and its stream ID is recycled, without
+ * decoding, as soon as a late response arrives.
+ *
+ * <b>Note:</b> A request that has already been written to a host may still be
+ * applied by the server.
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] future
+ * @return CASS_OK if the request was cancelled, CASS_ERROR_LIB_INVALID_STATE if
+ * the future was already set, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_future_cancel(CassFuture* future);
+
 /**
  * Gets the result of a successful future. If the future is not ready this method will
  * wait for the future to be set.
@@ -4088,7 +4784,7 @@ cass_statement_set_serial_consistency(CassStatement* statement,
                                       CassConsistency serial_consistency);
 
 /**
- * Sets the statement's page size.
+ * Sets the statement's page size. This disables adaptive paging.
  *
  * @cassandra{2.0+}
  *
@@ -4137,12 +4833,42 @@ cass_statement_set_paging_state(CassStatement* statement,
  * @param[in] paging_state_size
  * @return CASS_OK if successful, otherwise an error occurred.
  *
- * @see cass_result_paging_state_token()
+ * @see cass_result_paging_state_token()
+ */
+CASS_EXPORT CassError
+cass_statement_set_paging_state_token(CassStatement* statement,
+                                      const char* paging_state,
+                                      size_t paging_state_size);
+
+/**
+ * Enables adaptive paging. The page size is adjusted every time the paging
+ * state is set from a result using cass_statement_set_paging_state(). It's
+ * set to the number of rows expected to fill the target page size in bytes,
+ * based on the observed bytes per row, and to receive a page within the
+ * target latency. The page size at most doubles from one page to the next.
+ *
+ * The first page uses the statement's page size, if set, otherwise 5000
+ * rows (the server's default).
+ *
+ * @cassandra{2.0+}
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] target_page_bytes
+ * @param[in] target_latency_ms Use 0 for no latency target.
+ * @param[in] min_page_size
+ * @param[in] max_page_size
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_BAD_PARAMS.
+ *
+ * @see cass_cluster_set_paging_memory_budget()
  */
 CASS_EXPORT CassError
-cass_statement_set_paging_state_token(CassStatement* statement,
-                                      const char* paging_state,
-                                      size_t paging_state_size);
+cass_statement_set_adaptive_paging(CassStatement* statement,
+                                   cass_uint64_t target_page_bytes,
+                                   cass_uint64_t target_latency_ms,
+                                   int min_page_size,
+                                   int max_page_size);
 
 /**
  * Sets the statement's timestamp.
@@ -4193,6 +4919,29 @@ CASS_EXPORT CassError
 cass_statement_set_is_idempotent(CassStatement* statement,
                                  cass_bool_t is_idempotent);
 
+/**
+ * Sets whether the results of the statement are served from, and stored in,
+ * the session's result cache. Only bound statements (created from a
+ * prepared statement) can use the result cache. Results are cached per
+ * prepared statement and bound values; they're shared by all the futures
+ * that hit the cache and must not be relied on to reflect writes made
+ * within the cache's TTL.
+ *
+ * <b>Default:</b> cass_false
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_BAD_PARAMS if the
+ * statement isn't a bound statement.
+ *
+ * @see cass_cluster_set_result_cache()
+ */
+CASS_EXPORT CassError
+cass_statement_set_use_result_cache(CassStatement* statement,
+                                    cass_bool_t enabled);
+
 /**
  * Sets the statement's retry policy.
  *
@@ -4844,6 +5593,86 @@ cass_statement_bind_bytes_by_name_n(CassStatement* statement,
                                     const cass_byte_t* value,
                                     size_t value_size);
 
+/**
+ * Binds a "blob", "varint" or "custom" to a query or bound statement at the
+ * specified index without copying it. The memory is written directly to the
+ * socket (or to the encryption layer) when the statement is executed.
+ *
+ * The memory must not be modified or freed until the release callback is
+ * called. The callback is called, on any thread, once the value is no longer
+ * referenced by the statement (or copies of it) and the requests that sent
+ * it. It's also called if binding the value fails.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] index
+ * @param[in] value
+ * @param[in] value_size
+ * @param[in] release A callback used to release the memory. Can be NULL.
+ * @param[in] data User defined data passed to the release callback.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_bytes()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bytes_external(CassStatement* statement,
+                                   size_t index,
+                                   const cass_byte_t* value,
+                                   size_t value_size,
+                                   CassBufferReleaseCallback release,
+                                   void* data);
+
+/**
+ * Binds a "blob", "varint" or "custom" by reference to all the values with
+ * the specified name.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] value
+ * @param[in] value_size
+ * @param[in] release
+ * @param[in] data
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_bytes_external()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bytes_external_by_name(CassStatement* statement,
+                                           const char* name,
+                                           const cass_byte_t* value,
+                                           size_t value_size,
+                                           CassBufferReleaseCallback release,
+                                           void* data);
+
+/**
+ * Same as cass_statement_bind_bytes_external_by_name(), but with lengths
+ * for string parameters.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] name_length
+ * @param[in] value
+ * @param[in] value_size
+ * @param[in] release
+ * @param[in] data
+ * @return same as cass_statement_bind_bytes_external_by_name()
+ *
+ * @see cass_statement_bind_bytes_external_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_bytes_external_by_name_n(CassStatement* statement,
+                                             const char* name,
+                                             size_t name_length,
+                                             const cass_byte_t* value,
+                                             size_t value_size,
+                                             CassBufferReleaseCallback release,
+                                             void* data);
+
 /**
  * Binds a "custom" to a query or bound statement at the specified index.
  *
@@ -8481,6 +9310,24 @@ cass_iterator_type(CassIterator* iterator);
 CASS_EXPORT CassIterator*
 cass_iterator_from_result(const CassResult* result);
 
+/**
+ * Creates a new iterator over a snapshot of the session's per-statement
+ * metrics, ordered from the statement with the most requests to the one
+ * with the fewest.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return A new iterator that must be freed, or NULL if the per-statement
+ * metrics are not enabled.
+ *
+ * @see cass_cluster_set_statement_metrics()
+ * @see cass_iterator_get_statement_metrics()
+ * @see cass_iterator_free()
+ */
+CASS_EXPORT CassIterator*
+cass_iterator_statement_metrics_from_session(const CassSession* session);
+
 /**
  * Creates a new iterator for the specified row. This can be
  * used to iterate over columns in a row.
@@ -9089,6 +9936,23 @@ cass_iterator_get_column_meta(const CassIterator* iterator);
 CASS_EXPORT const CassIndexMeta*
 cass_iterator_get_index_meta(const CassIterator* iterator);
 
+/**
+ * Gets the metrics of the prepared statement at the iterator's current
+ * position.
+ *
+ * Calling cass_iterator_next() will invalidate the previous
+ * value returned by this method.
+ *
+ * @public @memberof CassIterator
+ *
+ * @param[in] iterator
+ * @param[out] output
+ * @return CASS_OK if successful, otherwise error occurred
+ */
+CASS_EXPORT CassError
+cass_iterator_get_statement_metrics(const CassIterator* iterator,
+                                    CassStatementMetrics* output);
+
 /**
  * Gets the metadata field name at the iterator's current position.
  *
@@ -9745,6 +10609,320 @@ CASS_EXPORT void
 cass_timestamp_gen_free(CassTimestampGen* timestamp_gen);
 
 
+/***********************************************************************************
+ *
+ * Shared I/O threads
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new group of I/O threads with the given number of threads. The
+ * threads can be shared by multiple clusters (and their sessions) using
+ * cass_cluster_set_shared_io_threads().
+ *
+ * @public @memberof CassSharedIoThreads
+ *
+ * @param[in] num_threads The number of I/O threads. Must be greater than 0.
+ * @return Returns the shared threads that must be freed or NULL if the
+ * threads could not be started.
+ *
+ * @see cass_shared_io_threads_free()
+ */
+CASS_EXPORT CassSharedIoThreads*
+cass_shared_io_threads_new(unsigned num_threads);
+
+/**
+ * Frees shared I/O threads. The threads are stopped once the last cluster
+ * and session using them have been freed.
+ *
+ * <b>Note:</b> This must not be called from a future callback (or any
+ * other driver callback) because it can block until the threads have
+ * exited.
+ *
+ * @public @memberof CassSharedIoThreads
+ *
+ * @param[in] shared_io_threads
+ */
+CASS_EXPORT void
+cass_shared_io_threads_free(CassSharedIoThreads* shared_io_threads);
+
+/***********************************************************************************
+ *
+ * Replica lookup
+ *
+ ***********************************************************************************/
+
+/**
+ * Frees a replica lookup instance.
+ *
+ * @public @memberof CassReplicaLookup
+ *
+ * @param[in] lookup
+ */
+CASS_EXPORT void
+cass_replica_lookup_free(CassReplicaLookup* lookup);
+
+/**
+ * Gets the number of distinct hosts that are replicas of the looked up rows.
+ *
+ * @public @memberof CassReplicaLookup
+ *
+ * @param[in] lookup
+ * @return The number of hosts.
+ */
+CASS_EXPORT size_t
+cass_replica_lookup_host_count(const CassReplicaLookup* lookup);
+
+/**
+ * Gets the address of a host by index.
+ *
+ * @public @memberof CassReplicaLookup
+ *
+ * @param[in] lookup
+ * @param[in] index
+ * @param[out] output
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS.
+ */
+CASS_EXPORT CassError
+cass_replica_lookup_host(const CassReplicaLookup* lookup,
+                         size_t index,
+                         CassInet* output);
+
+/**
+ * Gets the number of rows (statements) that were looked up.
+ *
+ * @public @memberof CassReplicaLookup
+ *
+ * @param[in] lookup
+ * @return The number of rows.
+ */
+CASS_EXPORT size_t
+cass_replica_lookup_row_count(const CassReplicaLookup* lookup);
+
+/**
+ * Gets the token and the replica host indices of a row. The indices can be
+ * passed to cass_replica_lookup_host().
+ *
+ * @public @memberof CassReplicaLookup
+ *
+ * @param[in] lookup
+ * @param[in] index The index of the statement passed to
+ * cass_session_lookup_replicas().
+ * @param[out] token The row's token. Can be NULL if only the replicas are
+ * needed.
+ * @param[out] host_indices The replicas' host indices, leader (or primary
+ * replica) first. Valid until the lookup is freed.
+ * @param[out] host_indices_count
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+ * CASS_ERROR_LIB_BAD_PARAMS if the statement's routing key couldn't be
+ * determined or CASS_ERROR_LIB_NOT_IMPLEMENTED if a token is requested but
+ * the row has none. Only Murmur3Partitioner tokens and YugaByte hash codes
+ * are 64-bit integers; there are no tokens if token-aware routing is
+ * disabled.
+ */
+CASS_EXPORT CassError
+cass_replica_lookup_row(const CassReplicaLookup* lookup,
+                        size_t index,
+                        cass_int64_t* token,
+                        const size_t** host_indices,
+                        size_t* host_indices_count);
+
+
+/***********************************************************************************
+ *
+ * Partition statistics
+ *
+ ***********************************************************************************/
+
+/**
+ * Frees a partition statistics instance.
+ *
+ * @public @memberof CassPartitionStats
+ *
+ * @param[in] stats
+ */
+CASS_EXPORT void
+cass_partition_stats_free(CassPartitionStats* stats);
+
+/**
+ * Gets the number of partitions (or tablets) in the statistics.
+ *
+ * @public @memberof CassPartitionStats
+ *
+ * @param[in] stats
+ * @return The number of entries.
+ */
+CASS_EXPORT size_t
+cass_partition_stats_entry_count(const CassPartitionStats* stats);
+
+/**
+ * Gets the statistics of a partition (or tablet) by index. Index 0 is the
+ * most requested partition.
+ *
+ * @public @memberof CassPartitionStats
+ *
+ * @param[in] stats
+ * @param[in] index
+ * @param[out] output The entry's table name is valid until the statistics
+ * are freed.
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS.
+ */
+CASS_EXPORT CassError
+cass_partition_stats_entry(const CassPartitionStats* stats,
+                           size_t index,
+                           CassPartitionStatsEntry* output);
+
+
+/***********************************************************************************
+ *
+ * Bulk loader
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new bulk loader for a prepared INSERT (or UPDATE) statement.
+ *
+ * Rows are grouped into unlogged batches by the leader of their partition
+ * (partition-aware routing) or, when the leader isn't known, by partition
+ * token. Each host has a bounded number of batches in flight and batches
+ * that fail with an unavailable or overloaded error are retried. Batches
+ * that time out are only retried if their rows are idempotent.
+ *
+ * The batches use the consistency, serial consistency, timestamp, request
+ * timeout and retry policy of their first row (by default, the prepared
+ * statement's settings).
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] session A connected session. It must outlive the loader.
+ * @param[in] prepared
+ * @return Returns a bulk loader that must be freed.
+ *
+ * @see cass_bulk_loader_free()
+ */
+CASS_EXPORT CassBulkLoader*
+cass_bulk_loader_new(CassSession* session,
+                     const CassPrepared* prepared);
+
+/**
+ * Frees a bulk loader instance.
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ */
+CASS_EXPORT void
+cass_bulk_loader_free(CassBulkLoader* loader);
+
+/**
+ * Sets the maximum number of rows per batch.
+ *
+ * <b>Default:</b> 64
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ * @param[in] batch_size
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_BAD_PARAMS if the
+ * batch size is zero.
+ */
+CASS_EXPORT CassError
+cass_bulk_loader_set_batch_size(CassBulkLoader* loader,
+                                size_t batch_size);
+
+/**
+ * Sets the maximum number of batches in flight per host. Batches without a
+ * known leader share a single limit.
+ *
+ * <b>Default:</b> 16
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ * @param[in] max_in_flight
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_BAD_PARAMS if the
+ * limit is zero.
+ */
+CASS_EXPORT CassError
+cass_bulk_loader_set_max_in_flight_per_host(CassBulkLoader* loader,
+                                            size_t max_in_flight);
+
+/**
+ * Sets the number of times a failed batch is retried.
+ *
+ * <b>Default:</b> 3
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ * @param[in] max_retries
+ */
+CASS_EXPORT void
+cass_bulk_loader_set_max_retries(CassBulkLoader* loader,
+                                 unsigned max_retries);
+
+/**
+ * Sets a callback that's called in the loading thread every time a batch
+ * completes.
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ * @param[in] callback
+ * @param[in] data
+ */
+CASS_EXPORT void
+cass_bulk_loader_set_progress_callback(CassBulkLoader* loader,
+                                       CassBulkLoaderProgressCallback callback,
+                                       void* data);
+
+/**
+ * Loads the rows produced by a row callback. This blocks until all the rows
+ * are written or have failed.
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ * @param[in] callback Called until it returns cass_false.
+ * @param[in] data
+ * @return CASS_OK if all the rows were written, otherwise the error of the
+ * first batch that couldn't be written.
+ *
+ * @see cass_bulk_loader_stats()
+ * @see cass_bulk_loader_error_message()
+ */
+CASS_EXPORT CassError
+cass_bulk_loader_run(CassBulkLoader* loader,
+                     CassBulkLoaderRowCallback callback,
+                     void* data);
+
+/**
+ * Gets the statistics of the current or last load.
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ * @param[out] output
+ */
+CASS_EXPORT void
+cass_bulk_loader_stats(const CassBulkLoader* loader,
+                       CassBulkLoaderStats* output);
+
+/**
+ * Gets the error message of the first batch that couldn't be written.
+ *
+ * @public @memberof CassBulkLoader
+ *
+ * @param[in] loader
+ * @param[out] message Empty if all the rows were written.
+ * @param[out] message_length
+ */
+CASS_EXPORT void
+cass_bulk_loader_error_message(const CassBulkLoader* loader,
+                               const char** message,
+                               size_t* message_length);
+
+
 /***********************************************************************************
  *
  * Retry policies
@@ -9840,6 +11018,49 @@ cass_retry_policy_fallthrough_new();
 CASS_EXPORT CassRetryPolicy*
 cass_retry_policy_logging_new(CassRetryPolicy* child_retry_policy);
 
+/**
+ * Creates a new retry budget policy.
+ *
+ * This policy limits the retries of its child policy so that retries can't
+ * multiply the load on a cluster that's already struggling (retry storms).
+ * Retries are drawn from token buckets, one per host and one for the
+ * session, and each successful request adds retry_ratio tokens to the
+ * buckets up to max_retries tokens. A retry is denied, and the error is
+ * returned, if either bucket is empty.
+ *
+ * Retries that are allowed can also be delayed using a jittered
+ * exponential backoff: the delay starts at base_delay_ms and doubles with
+ * each retry of the request up to max_delay_ms.
+ *
+ * The retries allowed and denied are counted in the session's retry budget
+ * metrics.
+ *
+ * <b>Note:</b> Each session connected using a cluster with this policy
+ * gets its own budget.
+ *
+ * @public @memberof CassRetryPolicy
+ *
+ * @param[in] child_retry_policy
+ * @param[in] retry_ratio The number of retries earned per successful
+ * request (e.g. 0.1 allows retrying 10% of the requests).
+ * @param[in] max_retries The maximum number of retries that can be
+ * accumulated in a bucket (and the initial number of retries).
+ * @param[in] base_delay_ms The initial backoff delay. Use 0 to retry
+ * immediately.
+ * @param[in] max_delay_ms The maximum backoff delay.
+ * @return Returns a retry policy that must be freed. NULL is returned if
+ * the child_policy is a retry budget policy or if the settings are invalid.
+ *
+ * @see cass_retry_policy_free()
+ * @see cass_session_get_retry_budget_metrics()
+ */
+CASS_EXPORT CassRetryPolicy*
+cass_retry_policy_budget_new(CassRetryPolicy* child_retry_policy,
+                             cass_double_t retry_ratio,
+                             unsigned max_retries,
+                             cass_uint64_t base_delay_ms,
+                             cass_uint64_t max_delay_ms);
+
 /**
  * Frees a retry policy instance.
  *
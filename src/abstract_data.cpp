@@ -30,6 +30,12 @@ CassError AbstractData::set(size_t index, CassNull value) {
   return CASS_OK;
 }
 
+CassError AbstractData::set(size_t index, const CassExternalBytes& value) {
+  CASS_CHECK_INDEX_AND_TYPE(index, value);
+  elements_[index] = Element(value);
+  return CASS_OK;
+}
+
 CassError AbstractData::set(size_t index, const Collection* value) {
   CASS_CHECK_INDEX_AND_TYPE(index, value);
   if (value->type() == CASS_COLLECTION_TYPE_MAP &&
@@ -95,6 +101,8 @@ void AbstractData::encode_buffers(size_t pos, Buffer* buf) const {
 size_t AbstractData::Element::get_size(int version) const {
   if (type_ == COLLECTION) {
     return collection_->get_size_with_length(version);
+  } else if (type_ == EXTERNAL) {
+    return sizeof(int32_t) + buf_.size();
   } else {
     assert(type_ == BUFFER || type_ == NUL);
     return buf_.size();
@@ -105,6 +113,8 @@ size_t AbstractData::Element::copy_buffer(int version, size_t pos, Buffer* buf)
   if (type_ == COLLECTION) {
     Buffer encoded(collection_->encode_with_length(version));
     return buf->copy(pos, encoded.data(), encoded.size());
+  } else if (type_ == EXTERNAL) {
+    return buf->encode_bytes(pos, buf_.data(), static_cast<int32_t>(buf_.size()));
   } else {
     assert(type_ == BUFFER || type_ == NUL);
     return buf->copy(pos, buf_.data(), buf_.size());
@@ -114,10 +124,29 @@ size_t AbstractData::Element::copy_buffer(int version, size_t pos, Buffer* buf)
 Buffer AbstractData::Element::get_buffer(int version) const {
   if (type_ == COLLECTION) {
     return collection_->encode_with_length(version);
+  } else if (type_ == EXTERNAL) {
+    // A contiguous copy is only needed for routing keys and other lookups
+    Buffer buf(sizeof(int32_t) + buf_.size());
+    buf.encode_bytes(0, buf_.data(), static_cast<int32_t>(buf_.size()));
+    return buf;
   } else {
     assert(type_ == BUFFER || type_ == NUL);
     return buf_;
   }
 }
 
+size_t AbstractData::Element::get_buffers(int version, BufferVec* bufs) const {
+  if (type_ == EXTERNAL) {
+    Buffer length(sizeof(int32_t));
+    length.encode_int32(0, static_cast<int32_t>(buf_.size()));
+    bufs->push_back(length);
+    if (buf_.size() > 0) {
+      bufs->push_back(buf_);
+    }
+    return sizeof(int32_t) + buf_.size();
+  }
+  bufs->push_back(get_buffer(version));
+  return bufs->back().size();
+}
+
 } // namespace cass
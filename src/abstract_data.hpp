@@ -44,7 +44,8 @@ public:
       UNSET,
       NUL,
       BUFFER,
-      COLLECTION
+      COLLECTION,
+      EXTERNAL
     };
 
     Element()
@@ -62,6 +63,10 @@ public:
       : type_(COLLECTION)
       , collection_(collection) { }
 
+    Element(const CassExternalBytes& value)
+      : type_(EXTERNAL)
+      , buf_(value.buffer.get(), value.size) { }
+
     bool is_unset() const {
       return type_ == UNSET || (type_ == BUFFER && buf_.size() == 0);
     }
@@ -74,6 +79,10 @@ public:
     size_t copy_buffer(int version, size_t pos, Buffer* buf) const;
     Buffer get_buffer(int version) const;
 
+    // Appends the encoded value to the buffers without copying external
+    // values. Returns the encoded size.
+    size_t get_buffers(int version, BufferVec* bufs) const;
+
   private:
     Type type_;
     Buffer buf_;
@@ -124,6 +133,7 @@ public:
   CassError set(size_t index, const Collection* value);
   CassError set(size_t index, const Tuple* value);
   CassError set(size_t index, const UserTypeValue* value);
+  CassError set(size_t index, const CassExternalBytes& value);
 
   template<class T>
   CassError set(StringRef name, const T value) {
@@ -36,6 +36,10 @@ public:
     uv_close(reinterpret_cast<uv_handle_t*>(&async_), NULL);
   }
 
+  uv_handle_t* handle() {
+    return reinterpret_cast<uv_handle_t*>(&async_);
+  }
+
   void send() {
     uv_async_send(&async_);
   }
@@ -165,8 +165,8 @@ int BatchRequest::encode(int version, RequestCallback* callback, BufferVec* bufs
         flags |= CASS_QUERY_FLAG_DEFAULT_TIMESTAMP;
       }
 
-      if (supports_set_keyspace(version) && !keyspace().empty()) {
-        buf_size += sizeof(uint16_t) + keyspace().size();
+      if (supports_set_keyspace(version) && !callback->keyspace().empty()) {
+        buf_size += sizeof(uint16_t) + callback->keyspace().size();
         flags |= CASS_QUERY_FLAG_WITH_KEYSPACE;
       }
     }
@@ -189,8 +189,8 @@ int BatchRequest::encode(int version, RequestCallback* callback, BufferVec* bufs
         pos = buf.encode_int64(pos, callback->timestamp());
       }
 
-      if (supports_set_keyspace(version) && !keyspace().empty()) {
-        pos = buf.encode_string(pos, keyspace().data(), keyspace().size());
+      if (supports_set_keyspace(version) && !callback->keyspace().empty()) {
+        pos = buf.encode_string(pos, callback->keyspace().data(), callback->keyspace().size());
       }
     }
 
@@ -26,13 +26,45 @@
 
 namespace cass {
 
+// Application owned memory that's referenced by buffers instead of being
+// copied. The release callback is run when the last reference is removed.
+class ExternalBuffer : public RefCounted<ExternalBuffer> {
+public:
+  typedef SharedRefPtr<ExternalBuffer> Ptr;
+
+  ExternalBuffer(const char* data,
+                 CassBufferReleaseCallback callback,
+                 void* callback_data)
+    : data_(data)
+    , callback_(callback)
+    , callback_data_(callback_data) { }
+
+  ~ExternalBuffer() {
+    if (callback_ != NULL) {
+      callback_(callback_data_);
+    }
+  }
+
+  const char* data() const { return data_; }
+
+private:
+  const char* data_;
+  CassBufferReleaseCallback callback_;
+  void* callback_data_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ExternalBuffer);
+};
+
 class Buffer {
 public:
   Buffer()
-    : size_(0) { }
+    : size_(0)
+    , is_external_(false) { }
 
   Buffer(const char* data, size_t size)
-    : size_(size) {
+    : size_(size)
+    , is_external_(false) {
     if (size > FIXED_BUFFER_SIZE) {
       RefBuffer* buffer = RefBuffer::create(size);
       buffer->inc_ref();
@@ -45,7 +77,8 @@ public:
 
   explicit
   Buffer(size_t size)
-    : size_(size) {
+    : size_(size)
+    , is_external_(false) {
     if (size > FIXED_BUFFER_SIZE) {
       RefBuffer* buffer = RefBuffer::create(size);
       buffer->inc_ref();
@@ -53,8 +86,18 @@ public:
     }
   }
 
+  // References the external memory instead of copying it. The buffer is
+  // read-only.
+  Buffer(ExternalBuffer* external, size_t size)
+    : size_(size)
+    , is_external_(true) {
+    external->inc_ref();
+    data_.external = external;
+  }
+
   Buffer(const Buffer& buf)
-    : size_(0) {
+    : size_(0)
+    , is_external_(false) {
     copy(buf);
   }
 
@@ -64,9 +107,7 @@ public:
   }
 
   ~Buffer() {
-    if (size_ > FIXED_BUFFER_SIZE) {
-      data_.buffer->dec_ref();
-    }
+    release();
   }
 
   size_t encode_byte(size_t offset, uint8_t value) {
@@ -177,12 +218,18 @@ public:
   }
 
   char* data() {
+    if (is_external_) {
+      return const_cast<char*>(data_.external->data());
+    }
     return size_ > FIXED_BUFFER_SIZE
         ? static_cast<RefBuffer*>(data_.buffer)->data()
         : data_.fixed;
   }
 
   const char* data() const {
+    if (is_external_) {
+      return data_.external->data();
+    }
     return size_ > FIXED_BUFFER_SIZE
         ? static_cast<RefBuffer*>(data_.buffer)->data()
         : data_.fixed;
@@ -190,37 +237,56 @@ public:
 
   size_t size() const { return size_; }
 
+  bool is_external() const { return is_external_; }
+
 private:
   // Enough space to avoid extra allocations for most of the basic types
   static const size_t FIXED_BUFFER_SIZE = 16;
 
 private:
   void copy(const Buffer& buf) {
-    RefBuffer* temp = data_.buffer;
+    if (this == &buf) return;
 
-    if (buf.size_ > FIXED_BUFFER_SIZE) {
+    // Take the new reference before releasing the current one
+    if (buf.is_external_) {
+      buf.data_.external->inc_ref();
+    } else if (buf.size_ > FIXED_BUFFER_SIZE) {
       buf.data_.buffer->inc_ref();
+    }
+
+    release();
+
+    if (buf.is_external_) {
+      data_.external = buf.data_.external;
+    } else if (buf.size_ > FIXED_BUFFER_SIZE) {
       data_.buffer = buf.data_.buffer;
     } else if (buf.size_ > 0) {
       memcpy(data_.fixed, buf.data_.fixed, buf.size_);
     }
 
-    if (size_ > FIXED_BUFFER_SIZE) {
-      temp->dec_ref();
-    }
-
     size_ = buf.size_;
+    is_external_ = buf.is_external_;
+  }
+
+  void release() {
+    if (is_external_) {
+      data_.external->dec_ref();
+    } else if (size_ > FIXED_BUFFER_SIZE) {
+      data_.buffer->dec_ref();
+    }
   }
 
   union Data {
     char fixed[FIXED_BUFFER_SIZE];
     RefBuffer* buffer;
+    ExternalBuffer* external;
 
     Data()
       : buffer(NULL) { }
   } data_;
 
   size_t size_;
+  bool is_external_;
 };
 
 typedef std::vector<Buffer> BufferVec;
@@ -0,0 +1,331 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "bulk_loader.hpp"
+
+#include "execute_request.hpp"
+#include "get_time.hpp"
+#include "replica_lookup.hpp"
+#include "session.hpp"
+
+#include <algorithm>
+#include <string.h>
+
+// The number of batches worth of rows that are grouped at a time
+#define BULK_LOADER_CHUNK_BATCHES 16
+
+extern "C" {
+
+CassBulkLoader* cass_bulk_loader_new(CassSession* session,
+                                     const CassPrepared* prepared) {
+  return CassBulkLoader::to(new cass::BulkLoader(session, prepared));
+}
+
+void cass_bulk_loader_free(CassBulkLoader* loader) {
+  delete loader->from();
+}
+
+CassError cass_bulk_loader_set_batch_size(CassBulkLoader* loader,
+                                          size_t batch_size) {
+  if (batch_size == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  loader->set_batch_size(batch_size);
+  return CASS_OK;
+}
+
+CassError cass_bulk_loader_set_max_in_flight_per_host(CassBulkLoader* loader,
+                                                      size_t max_in_flight) {
+  if (max_in_flight == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  loader->set_max_in_flight_per_host(max_in_flight);
+  return CASS_OK;
+}
+
+void cass_bulk_loader_set_max_retries(CassBulkLoader* loader,
+                                      unsigned max_retries) {
+  loader->set_max_retries(max_retries);
+}
+
+void cass_bulk_loader_set_progress_callback(CassBulkLoader* loader,
+                                            CassBulkLoaderProgressCallback callback,
+                                            void* data) {
+  loader->set_progress_callback(callback, data);
+}
+
+CassError cass_bulk_loader_run(CassBulkLoader* loader,
+                               CassBulkLoaderRowCallback callback,
+                               void* data) {
+  return loader->run(callback, data);
+}
+
+void cass_bulk_loader_stats(const CassBulkLoader* loader,
+                            CassBulkLoaderStats* output) {
+  *output = loader->stats();
+}
+
+void cass_bulk_loader_error_message(const CassBulkLoader* loader,
+                                    const char** message,
+                                    size_t* message_length) {
+  *message = loader->error_message().data();
+  *message_length = loader->error_message().size();
+}
+
+} // extern "C"
+
+namespace cass {
+
+const size_t BulkLoader::DEFAULT_BATCH_SIZE;
+const size_t BulkLoader::DEFAULT_MAX_IN_FLIGHT_PER_HOST;
+const unsigned BulkLoader::DEFAULT_MAX_RETRIES;
+
+BatchRequest* BulkBatcher::new_batch(const Statement* statement) {
+  BatchRequest* batch = new BatchRequest(CASS_BATCH_TYPE_UNLOGGED);
+  batch->set_settings(statement->settings());
+  batch->set_timestamp(statement->timestamp());
+  return batch;
+}
+
+void BulkBatcher::add(const Address& host, int64_t token,
+                      Statement* statement, BatchVec* batches) {
+  // Rows with a leader are grouped by host only
+  Key key(host, host.is_valid() ? 0 : token);
+  Batch& batch = groups_[key];
+  if (!batch.request) {
+    batch.host = host;
+    batch.request.reset(new_batch(statement));
+  }
+  batch.request->add_statement(statement);
+  if (!statement->is_idempotent()) {
+    batch.request->set_is_idempotent(false);
+  }
+  if (++batch.row_count >= batch_size_) {
+    batches->push_back(batch);
+    groups_.erase(key);
+  }
+}
+
+void BulkBatcher::flush_partitions(BatchVec* batches) {
+  GroupMap::iterator it = groups_.begin();
+  while (it != groups_.end()) {
+    if (!it->first.first.is_valid()) {
+      batches->push_back(it->second);
+      groups_.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void BulkBatcher::flush(BatchVec* batches) {
+  for (GroupMap::const_iterator it = groups_.begin(),
+       end = groups_.end(); it != end; ++it) {
+    batches->push_back(it->second);
+  }
+  groups_.clear();
+}
+
+BulkLoader::BulkLoader(Session* session, const Prepared* prepared)
+  : session_(session)
+  , prepared_(prepared)
+  , batch_size_(DEFAULT_BATCH_SIZE)
+  , max_in_flight_per_host_(DEFAULT_MAX_IN_FLIGHT_PER_HOST)
+  , max_retries_(DEFAULT_MAX_RETRIES)
+  , progress_callback_(NULL)
+  , progress_data_(NULL)
+  , start_time_ns_(0)
+  , error_code_(CASS_OK) {
+  memset(&stats_, 0, sizeof(stats_));
+}
+
+CassError BulkLoader::run(CassBulkLoaderRowCallback callback, void* data) {
+  memset(&stats_, 0, sizeof(stats_));
+  error_code_ = CASS_OK;
+  error_message_.clear();
+  start_time_ns_ = get_time_monotonic_ns();
+
+  const size_t chunk_size = batch_size_ * BULK_LOADER_CHUNK_BATCHES;
+
+  BulkBatcher batcher(batch_size_);
+  BulkBatcher::BatchVec batches;
+  std::vector<SharedRefPtr<ExecuteRequest> > rows;
+  std::vector<const ExecuteRequest*> requests;
+  rows.reserve(chunk_size);
+  requests.reserve(chunk_size);
+
+  bool is_done = false;
+  while (!is_done) {
+    rows.clear();
+    requests.clear();
+    while (rows.size() < chunk_size) {
+      SharedRefPtr<ExecuteRequest> row(new ExecuteRequest(prepared_.get()));
+      if (!callback(CassStatement::to(row.get()), data)) {
+        is_done = true;
+        break;
+      }
+      rows.push_back(row);
+      requests.push_back(row.get());
+    }
+
+    if (!rows.empty()) {
+      // The schema and token map snapshots are reloaded for every chunk so
+      // that tablet splits, leader changes and topology changes are picked
+      // up during long loads.
+      const Session* session = session_;
+      TokenMapSnapshot::ConstPtr token_map(session->token_map_snapshot());
+      ReplicaLookup lookup;
+      lookup.lookup(session->metadata().schema_snapshot(session->protocol_version(),
+                                                        session->cassandra_version()),
+                    token_map ? token_map->token_map() : NULL,
+                    &requests[0], requests.size());
+
+      batches.clear();
+      for (size_t i = 0; i < rows.size(); ++i) {
+        const ReplicaLookup::Row& row = lookup.row(i);
+        if (row.error != CASS_OK) {
+          fail_row(row.error);
+          continue;
+        }
+        const size_t* replicas = lookup.replicas(row);
+        if (replicas != NULL) {
+          batcher.add(lookup.host(replicas[0]), 0, rows[i].get(), &batches);
+        } else if (row.has_token) {
+          batcher.add(Address(), row.token, rows[i].get(), &batches);
+        } else {
+          // Without a token the row's partition isn't known so it's written
+          // by itself rather than in a multi-partition batch.
+          BulkBatcher::Batch batch;
+          batch.request.reset(BulkBatcher::new_batch(rows[i].get()));
+          batch.request->add_statement(rows[i].get());
+          batch.row_count = 1;
+          batches.push_back(batch);
+        }
+      }
+      batcher.flush_partitions(&batches);
+      write(batches);
+    }
+  }
+
+  batches.clear();
+  batcher.flush(&batches);
+  write(batches);
+  drain();
+
+  return error_code_;
+}
+
+bool BulkLoader::is_retryable(CassError code, bool is_idempotent) {
+  switch (code) {
+    case CASS_ERROR_LIB_REQUEST_QUEUE_FULL:
+    case CASS_ERROR_LIB_WRITE_ERROR:
+    case CASS_ERROR_LIB_NO_HOSTS_AVAILABLE:
+    case CASS_ERROR_SERVER_UNAVAILABLE:
+    case CASS_ERROR_SERVER_OVERLOADED:
+    case CASS_ERROR_SERVER_IS_BOOTSTRAPPING:
+      return true;
+    case CASS_ERROR_LIB_REQUEST_TIMED_OUT:
+    case CASS_ERROR_SERVER_WRITE_TIMEOUT:
+      return is_idempotent;
+    default:
+      return false;
+  }
+}
+
+void BulkLoader::write(const BulkBatcher::BatchVec& batches) {
+  // Batches without a replica are routed by the load balancing policy so
+  // they can go to any host. They share a queue that's bounded as if it was
+  // one queue per host.
+  size_t max_in_flight_without_replica =
+      max_in_flight_per_host_ * std::max(session_->host_count(), static_cast<size_t>(1));
+
+  for (BulkBatcher::BatchVec::const_iterator it = batches.begin(),
+       end = batches.end(); it != end; ++it) {
+    InFlightQueue& queue = in_flight_[it->host];
+    size_t max_in_flight = it->host.is_valid() ? max_in_flight_per_host_
+                                               : max_in_flight_without_replica;
+    while (queue.size() >= max_in_flight) {
+      finish_oldest(&queue);
+    }
+    queue.push_back(InFlight());
+    queue.back().batch = *it;
+    execute(&queue.back());
+  }
+}
+
+void BulkLoader::fail_row(CassError code) {
+  stats_.failed_rows++;
+  if (error_code_ == CASS_OK) {
+    error_code_ = code;
+    error_message_ = "Unable to determine the partition of a row because its "
+                     "partition key isn't bound or is null";
+  }
+}
+
+void BulkLoader::execute(InFlight* in_flight) {
+  in_flight->attempts++;
+  in_flight->future = session_->execute(Request::ConstPtr(in_flight->batch.request));
+}
+
+void BulkLoader::finish_oldest(InFlightQueue* queue) {
+  InFlight in_flight(queue->front());
+  queue->pop_front();
+
+  Future::Error* error = in_flight.future->error();
+  if (error != NULL) {
+    if (in_flight.attempts <= max_retries_ &&
+        is_retryable(error->code, in_flight.batch.request->is_idempotent())) {
+      stats_.retries++;
+      queue->push_back(in_flight);
+      execute(&queue->back());
+      return;
+    }
+    stats_.failed_rows += in_flight.batch.row_count;
+    stats_.failed_batches++;
+    if (error_code_ == CASS_OK) {
+      error_code_ = error->code;
+      error_message_ = error->message;
+    }
+  } else {
+    stats_.rows += in_flight.batch.row_count;
+    stats_.batches++;
+  }
+
+  update_elapsed();
+  if (progress_callback_ != NULL) {
+    progress_callback_(&stats_, progress_data_);
+  }
+}
+
+void BulkLoader::drain() {
+  for (InFlightMap::iterator it = in_flight_.begin(),
+       end = in_flight_.end(); it != end; ++it) {
+    while (!it->second.empty()) {
+      finish_oldest(&it->second);
+    }
+  }
+  in_flight_.clear();
+  update_elapsed();
+}
+
+void BulkLoader::update_elapsed() {
+  uint64_t elapsed_ns = get_time_monotonic_ns() - start_time_ns_;
+  stats_.elapsed_ms = elapsed_ns / (1000 * 1000);
+  stats_.rows_per_second =
+      elapsed_ns > 0 ? static_cast<double>(stats_.rows) * 1e9 / elapsed_ns : 0.0;
+}
+
+} // namespace cass
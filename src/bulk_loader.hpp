@@ -0,0 +1,164 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_BULK_LOADER_HPP_INCLUDED__
+#define __CASS_BULK_LOADER_HPP_INCLUDED__
+
+#include "address.hpp"
+#include "batch_request.hpp"
+#include "cassandra.h"
+#include "external.hpp"
+#include "future.hpp"
+#include "macros.hpp"
+#include "prepared.hpp"
+
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cass {
+
+class Session;
+
+// Groups rows into unlogged batches. Rows with a known replica (the tablet
+// leader or the token map's primary replica) are batched per host and rows
+// with only a token are batched per partition token so that every batch is
+// written by a single replica set.
+class BulkBatcher {
+public:
+  struct Batch {
+    Batch()
+      : row_count(0) { }
+
+    Address host; // Invalid if the replica isn't known
+    SharedRefPtr<BatchRequest> request;
+    size_t row_count;
+  };
+
+  typedef std::vector<Batch> BatchVec;
+
+  BulkBatcher(size_t batch_size)
+    : batch_size_(batch_size) { }
+
+  // Creates a batch that uses the settings (e.g. the consistency and the
+  // retry policy) and the timestamp of its first row. The batch is only
+  // idempotent if all its rows are.
+  static BatchRequest* new_batch(const Statement* statement);
+
+  // Adds a row to its group and appends the group's batch to "batches"
+  // when it's full.
+  void add(const Address& host, int64_t token,
+           Statement* statement, BatchVec* batches);
+
+  // Flushes the partial batches of the groups without a replica. These are
+  // only grouped within a chunk of rows to bound the number of groups.
+  void flush_partitions(BatchVec* batches);
+
+  // Flushes all the partial batches.
+  void flush(BatchVec* batches);
+
+  bool empty() const { return groups_.empty(); }
+
+private:
+  typedef std::pair<Address, int64_t> Key;
+  typedef std::map<Key, Batch> GroupMap;
+
+private:
+  size_t batch_size_;
+  GroupMap groups_;
+};
+
+// Writes the rows produced by a row callback using a prepared INSERT. Rows
+// are grouped by replica into batches and the batches are written with a
+// bounded number of requests in flight per host. Failed batches are retried.
+//
+// The loader runs in the calling (application) thread and isn't thread-safe.
+class BulkLoader {
+public:
+  static const size_t DEFAULT_BATCH_SIZE = 64;
+  static const size_t DEFAULT_MAX_IN_FLIGHT_PER_HOST = 16;
+  static const unsigned DEFAULT_MAX_RETRIES = 3;
+
+  BulkLoader(Session* session, const Prepared* prepared);
+
+  void set_batch_size(size_t batch_size) { batch_size_ = batch_size; }
+  void set_max_in_flight_per_host(size_t max_in_flight) {
+    max_in_flight_per_host_ = max_in_flight;
+  }
+  void set_max_retries(unsigned max_retries) { max_retries_ = max_retries; }
+  void set_progress_callback(CassBulkLoaderProgressCallback callback, void* data) {
+    progress_callback_ = callback;
+    progress_data_ = data;
+  }
+
+  // Returns CASS_OK if all the rows were written, otherwise the error of the
+  // first batch that couldn't be written.
+  CassError run(CassBulkLoaderRowCallback callback, void* data);
+
+  const CassBulkLoaderStats& stats() const { return stats_; }
+  const std::string& error_message() const { return error_message_; }
+
+  // Errors that are likely to succeed on a later attempt. Other errors (e.g.
+  // invalid queries or values) fail the batch right away. A batch that timed
+  // out may have been applied so it's only retried if it's idempotent.
+  static bool is_retryable(CassError code, bool is_idempotent);
+
+private:
+  struct InFlight {
+    InFlight()
+      : attempts(0) { }
+
+    BulkBatcher::Batch batch;
+    Future::Ptr future;
+    unsigned attempts;
+  };
+
+  typedef std::deque<InFlight> InFlightQueue;
+  typedef std::map<Address, InFlightQueue> InFlightMap;
+
+  void write(const BulkBatcher::BatchVec& batches);
+  void fail_row(CassError code);
+  void execute(InFlight* in_flight);
+  void finish_oldest(InFlightQueue* queue);
+  void drain();
+  void update_elapsed();
+
+private:
+  Session* session_;
+  Prepared::ConstPtr prepared_;
+  size_t batch_size_;
+  size_t max_in_flight_per_host_;
+  unsigned max_retries_;
+  CassBulkLoaderProgressCallback progress_callback_;
+  void* progress_data_;
+
+  InFlightMap in_flight_;
+  uint64_t start_time_ns_;
+  CassBulkLoaderStats stats_;
+  CassError error_code_;
+  std::string error_message_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(BulkLoader);
+};
+
+} // namespace cass
+
+EXTERNAL_TYPE(cass::BulkLoader, CassBulkLoader)
+
+#endif
@@ -0,0 +1,66 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "circuit_breaker_policy.hpp"
+
+namespace cass {
+
+void CircuitBreakerPolicy::init(const Host::Ptr& connected_host,
+                                const HostMap& hosts,
+                                Random* random) {
+  for (HostMap::const_iterator i = hosts.begin(),
+       end = hosts.end(); i != end; ++i) {
+    enable_circuit_breaker(i->second);
+  }
+  ChainedLoadBalancingPolicy::init(connected_host, hosts, random);
+}
+
+QueryPlan* CircuitBreakerPolicy::new_query_plan(const std::string& keyspace,
+                                                RequestHandler* request_handler) {
+  return new CircuitBreakerQueryPlan(child_policy_->new_query_plan(keyspace,
+                                                                   request_handler));
+}
+
+void CircuitBreakerPolicy::on_add(const Host::Ptr& host) {
+  enable_circuit_breaker(host);
+  ChainedLoadBalancingPolicy::on_add(host);
+}
+
+void CircuitBreakerPolicy::enable_circuit_breaker(const Host::Ptr& host) const {
+  host->enable_circuit_breaker(settings_.failure_threshold,
+                               settings_.min_requests,
+                               settings_.window_ns,
+                               settings_.open_ns);
+}
+
+Host::Ptr CircuitBreakerPolicy::CircuitBreakerQueryPlan::compute_next() {
+  Host::Ptr host;
+  while ((host = child_plan_->compute_next())) {
+    if (host->allow_request()) {
+      return host;
+    }
+    skipped_.push_back(host);
+  }
+
+  // Hosts with an open breaker are only used as a last resort
+  if (skipped_index_ < skipped_.size()) {
+    return skipped_[skipped_index_++];
+  }
+
+  return Host::Ptr();
+}
+
+} // namespace cass
@@ -0,0 +1,89 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_CIRCUIT_BREAKER_POLICY_HPP_INCLUDED__
+#define __CASS_CIRCUIT_BREAKER_POLICY_HPP_INCLUDED__
+
+#include "load_balancing.hpp"
+#include "macros.hpp"
+#include "scoped_ptr.hpp"
+
+namespace cass {
+
+// Moves hosts with an open circuit breaker to the end of the query plan. A
+// host's breaker opens when the ratio of failed requests (timeouts, overloaded
+// and server errors) within a window exceeds the failure threshold. After the
+// open period a single probe request is routed to the host; its outcome
+// decides whether the breaker closes or reopens.
+class CircuitBreakerPolicy : public ChainedLoadBalancingPolicy {
+public:
+  struct Settings {
+    Settings()
+      : failure_threshold(0.5)
+      , min_requests(20LL)
+      , window_ns(10LL * 1000LL * 1000LL * 1000LL)
+      , open_ns(5LL * 1000LL * 1000LL * 1000LL) {}
+
+    double failure_threshold;
+    uint64_t min_requests;
+    uint64_t window_ns;
+    uint64_t open_ns;
+  };
+
+  CircuitBreakerPolicy(LoadBalancingPolicy* child_policy, const Settings& settings)
+    : ChainedLoadBalancingPolicy(child_policy)
+    , settings_(settings) {}
+
+  virtual ~CircuitBreakerPolicy() {}
+
+  virtual void init(const Host::Ptr& connected_host, const HostMap& hosts, Random* random);
+
+  virtual QueryPlan* new_query_plan(const std::string& keyspace,
+                                    RequestHandler* request_handler);
+
+  virtual LoadBalancingPolicy* new_instance() {
+    return new CircuitBreakerPolicy(child_policy_->new_instance(), settings_);
+  }
+
+  virtual void on_add(const Host::Ptr& host);
+
+private:
+  class CircuitBreakerQueryPlan : public QueryPlan {
+  public:
+    CircuitBreakerQueryPlan(QueryPlan* child_plan)
+      : child_plan_(child_plan)
+      , skipped_index_(0) {}
+
+    Host::Ptr compute_next();
+
+  private:
+    ScopedPtr<QueryPlan> child_plan_;
+
+    HostVec skipped_;
+    size_t skipped_index_;
+  };
+
+  void enable_circuit_breaker(const Host::Ptr& host) const;
+
+  Settings settings_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(CircuitBreakerPolicy);
+};
+
+} // namespace cass
+
+#endif
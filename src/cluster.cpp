@@ -286,6 +286,22 @@ void cass_cluster_set_partition_aware_routing(CassCluster* cluster,
   }
 }
 
+void cass_cluster_set_partition_aware_follower_reads(CassCluster* cluster,
+                                                     cass_bool_t enabled,
+                                                     const char* local_rack) {
+  cass_cluster_set_partition_aware_follower_reads_n(cluster, enabled,
+                                                    local_rack, SAFE_STRLEN(local_rack));
+}
+
+void cass_cluster_set_partition_aware_follower_reads_n(CassCluster* cluster,
+                                                       cass_bool_t enabled,
+                                                       const char* local_rack,
+                                                       size_t local_rack_length) {
+  cluster->config().set_partition_aware_follower_reads(
+        enabled == cass_true,
+        local_rack != NULL ? std::string(local_rack, local_rack_length) : std::string());
+}
+
 void cass_cluster_set_token_aware_routing(CassCluster* cluster,
                                           cass_bool_t enabled) {
   cluster->config().set_token_aware_routing(enabled == cass_true);
@@ -311,6 +327,24 @@ void cass_cluster_set_latency_aware_routing_settings(CassCluster* cluster,
   cluster->config().set_latency_aware_routing_settings(settings);
 }
 
+void cass_cluster_set_circuit_breaker(CassCluster* cluster,
+                                      cass_bool_t enabled) {
+  cluster->config().set_circuit_breaker(enabled == cass_true);
+}
+
+void cass_cluster_set_circuit_breaker_settings(CassCluster* cluster,
+                                               cass_double_t failure_threshold,
+                                               cass_uint64_t min_requests,
+                                               cass_uint64_t window_ms,
+                                               cass_uint64_t open_ms) {
+  cass::CircuitBreakerPolicy::Settings settings;
+  settings.failure_threshold = failure_threshold;
+  settings.min_requests = min_requests;
+  settings.window_ns = window_ms * 1000 * 1000;
+  settings.open_ns = open_ms * 1000 * 1000;
+  cluster->config().set_circuit_breaker_settings(settings);
+}
+
 void cass_cluster_set_whitelist_filtering(CassCluster* cluster,
                                           const char* hosts) {
   cass_cluster_set_whitelist_filtering_n(cluster,
@@ -424,6 +458,11 @@ void cass_cluster_set_timestamp_gen(CassCluster* cluster,
   cluster->config().set_timestamp_gen(timestamp_gen);
 }
 
+void cass_cluster_set_shared_io_threads(CassCluster* cluster,
+                                        CassSharedIoThreads* shared_io_threads) {
+  cluster->config().set_shared_io_threads(shared_io_threads);
+}
+
 void cass_cluster_set_use_schema(CassCluster* cluster,
                                  cass_bool_t enabled) {
   cluster->config().set_use_schema(enabled == cass_true);
@@ -481,6 +520,71 @@ CassError cass_cluster_set_no_compact(CassCluster* cluster,
   return CASS_OK;
 }
 
+CassError cass_cluster_set_external_event_loop(CassCluster* cluster,
+                                               cass_bool_t enabled) {
+  cluster->config().set_use_external_event_loop(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_pre_encode_requests(CassCluster* cluster,
+                                               cass_bool_t enabled) {
+  cluster->config().set_pre_encode_requests(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_result_cache(CassCluster* cluster,
+                                        unsigned max_entries,
+                                        cass_uint64_t ttl_ms) {
+  cluster->config().set_result_cache(max_entries, ttl_ms);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_result_cache_invalidation(CassCluster* cluster,
+                                                     cass_bool_t enabled) {
+  cluster->config().set_result_cache_invalidation(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_request_coalescing(CassCluster* cluster,
+                                              cass_bool_t enabled) {
+  cluster->config().set_request_coalescing(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_paging_memory_budget(CassCluster* cluster,
+                                                cass_uint64_t bytes) {
+  cluster->config().set_paging_memory_budget(bytes);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_partition_stats(CassCluster* cluster,
+                                           unsigned sample_rate,
+                                           unsigned top_k) {
+  if (sample_rate > 0 && top_k == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_partition_stats(sample_rate, top_k);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_statement_metrics(CassCluster* cluster,
+                                             unsigned max_statements) {
+  cluster->config().set_statement_metrics(max_statements);
+  return CASS_OK;
+}
+
+void cass_cluster_set_topology_cache(CassCluster* cluster,
+                                     const char* path) {
+  cass_cluster_set_topology_cache_n(cluster, path, SAFE_STRLEN(path));
+}
+
+void cass_cluster_set_topology_cache_n(CassCluster* cluster,
+                                       const char* path,
+                                       size_t path_length) {
+  cluster->config().set_topology_cache_path(
+        path != NULL ? std::string(path, path_length) : std::string());
+}
+
 
 void cass_cluster_free(CassCluster* cluster) {
   delete cluster->from();
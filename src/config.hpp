@@ -19,9 +19,11 @@
 
 #include "auth.hpp"
 #include "cassandra.h"
+#include "circuit_breaker_policy.hpp"
 #include "constants.hpp"
 #include "dc_aware_policy.hpp"
 #include "host_targeting_policy.hpp"
+#include "shared_io_threads.hpp"
 #include "latency_aware_policy.hpp"
 #include "retry_policy.hpp"
 #include "ssl.hpp"
@@ -70,8 +72,10 @@ public:
       , speculative_execution_policy_(new NoSpeculativeExecutionPolicy())
       , partition_aware_routing_(true) // Enabled by default
       , partition_refresh_frequency_secs_(CASS_DEFAULT_METADATA_REFRESH_FREQUENCY_SECS)
+      , partition_aware_follower_reads_(false)
       , token_aware_routing_(false)
       , latency_aware_routing_(false)
+      , circuit_breaker_(false)
       , host_targeting_(false)
       , tcp_nodelay_enable_(true)
       , tcp_keepalive_enable_(false)
@@ -84,7 +88,17 @@ public:
       , use_randomized_contact_points_(true)
       , prepare_on_all_hosts_(true)
       , prepare_on_up_or_add_host_(true)
-      , no_compact_(false) { }
+      , no_compact_(false)
+      , use_external_event_loop_(false)
+      , pre_encode_requests_(false)
+      , result_cache_max_entries_(0)
+      , result_cache_ttl_ms_(0)
+      , result_cache_invalidation_(true)
+      , request_coalescing_(false)
+      , partition_stats_sample_rate_(0)
+      , partition_stats_top_k_(0)
+      , statement_metrics_max_statements_(0)
+      , paging_memory_budget_(0) { }
 
   Config new_instance() const {
     Config config = *this;
@@ -108,17 +122,23 @@ public:
       chain = new TokenAwarePolicy(chain);
     }
     if (partition_aware_routing()) {
-      chain = new PartitionAwarePolicy(chain, partition_refresh_frequency_secs_);
+      chain = new PartitionAwarePolicy(chain, partition_refresh_frequency_secs_,
+                                      partition_aware_follower_reads_,
+                                      partition_aware_local_rack_);
     }
     if (latency_aware()) {
       chain = new LatencyAwarePolicy(chain, latency_aware_routing_settings_);
     }
+    if (circuit_breaker()) {
+      chain = new CircuitBreakerPolicy(chain, circuit_breaker_settings_);
+    }
     if (host_targeting()) {
       chain = new HostTargetingPolicy(chain);
     }
 
     config.set_load_balancing_policy(chain);
     config.set_speculative_execution_policy(speculative_execution_policy_->new_instance());
+    config.set_retry_policy(retry_policy_->new_instance());
 
     return config;
   }
@@ -308,6 +328,16 @@ public:
     partition_refresh_frequency_secs_ = refresh_frequency_secs;
   }
 
+  bool partition_aware_follower_reads() const { return partition_aware_follower_reads_; }
+
+  const std::string& partition_aware_local_rack() const { return partition_aware_local_rack_; }
+
+  void set_partition_aware_follower_reads(bool follower_reads,
+                                          const std::string& local_rack = std::string()) {
+    partition_aware_follower_reads_ = follower_reads;
+    partition_aware_local_rack_ = local_rack;
+  }
+
   bool token_aware_routing() const { return token_aware_routing_; }
 
   void set_token_aware_routing(bool is_token_aware) { token_aware_routing_ = is_token_aware; }
@@ -316,6 +346,10 @@ public:
 
   void set_latency_aware_routing(bool is_latency_aware) { latency_aware_routing_ = is_latency_aware; }
 
+  bool circuit_breaker() const { return circuit_breaker_; }
+
+  void set_circuit_breaker(bool is_circuit_breaker) { circuit_breaker_ = is_circuit_breaker; }
+
   bool host_targeting() const { return host_targeting_; }
 
   void set_host_targeting(bool is_host_targeting) { host_targeting_ = is_host_targeting; }
@@ -324,6 +358,10 @@ public:
     latency_aware_routing_settings_ = settings;
   }
 
+  void set_circuit_breaker_settings(const CircuitBreakerPolicy::Settings& settings) {
+    circuit_breaker_settings_ = settings;
+  }
+
   ContactPointList& whitelist() {
     return whitelist_;
   }
@@ -379,6 +417,12 @@ public:
     timestamp_gen_.reset(timestamp_gen);
   }
 
+  const SharedIOThreads::Ptr& shared_io_threads() const { return shared_io_threads_; }
+
+  void set_shared_io_threads(SharedIOThreads* shared_io_threads) {
+    shared_io_threads_.reset(shared_io_threads);
+  }
+
   const RetryPolicy::Ptr& retry_policy() const {
     return retry_policy_;
   }
@@ -419,6 +463,66 @@ public:
     no_compact_ = enabled;
   }
 
+  bool use_external_event_loop() const { return use_external_event_loop_; }
+
+  void set_use_external_event_loop(bool enabled) {
+    use_external_event_loop_ = enabled;
+  }
+
+  bool pre_encode_requests() const { return pre_encode_requests_; }
+
+  void set_pre_encode_requests(bool enabled) {
+    pre_encode_requests_ = enabled;
+  }
+
+  unsigned result_cache_max_entries() const { return result_cache_max_entries_; }
+
+  uint64_t result_cache_ttl_ms() const { return result_cache_ttl_ms_; }
+
+  void set_result_cache(unsigned max_entries, uint64_t ttl_ms) {
+    result_cache_max_entries_ = max_entries;
+    result_cache_ttl_ms_ = ttl_ms;
+  }
+
+  bool result_cache_invalidation() const { return result_cache_invalidation_; }
+
+  void set_result_cache_invalidation(bool enabled) {
+    result_cache_invalidation_ = enabled;
+  }
+
+  bool request_coalescing() const { return request_coalescing_; }
+
+  void set_request_coalescing(bool enabled) {
+    request_coalescing_ = enabled;
+  }
+
+  unsigned partition_stats_sample_rate() const { return partition_stats_sample_rate_; }
+
+  unsigned partition_stats_top_k() const { return partition_stats_top_k_; }
+
+  void set_partition_stats(unsigned sample_rate, unsigned top_k) {
+    partition_stats_sample_rate_ = sample_rate;
+    partition_stats_top_k_ = top_k;
+  }
+
+  unsigned statement_metrics_max_statements() const { return statement_metrics_max_statements_; }
+
+  void set_statement_metrics(unsigned max_statements) {
+    statement_metrics_max_statements_ = max_statements;
+  }
+
+  uint64_t paging_memory_budget() const { return paging_memory_budget_; }
+
+  void set_paging_memory_budget(uint64_t bytes) {
+    paging_memory_budget_ = bytes;
+  }
+
+  const std::string& topology_cache_path() const { return topology_cache_path_; }
+
+  void set_topology_cache_path(const std::string& path) {
+    topology_cache_path_ = path;
+  }
+
 private:
   int port_;
   int protocol_version_;
@@ -448,10 +552,14 @@ private:
   SslContext::Ptr ssl_context_;
   bool partition_aware_routing_;
   unsigned partition_refresh_frequency_secs_;
+  bool partition_aware_follower_reads_;
+  std::string partition_aware_local_rack_;
   bool token_aware_routing_;
   bool latency_aware_routing_;
+  bool circuit_breaker_;
   bool host_targeting_;
   LatencyAwarePolicy::Settings latency_aware_routing_settings_;
+  CircuitBreakerPolicy::Settings circuit_breaker_settings_;
   ContactPointList whitelist_;
   ContactPointList blacklist_;
   DcList whitelist_dc_;
@@ -463,12 +571,24 @@ private:
   unsigned connection_heartbeat_interval_secs_;
   SharedRefPtr<TimestampGenerator> timestamp_gen_;
   RetryPolicy::Ptr retry_policy_;
+  SharedIOThreads::Ptr shared_io_threads_;
   bool use_schema_;
   bool use_hostname_resolution_;
   bool use_randomized_contact_points_;
   bool prepare_on_all_hosts_;
   bool prepare_on_up_or_add_host_;
   bool no_compact_;
+  bool use_external_event_loop_;
+  bool pre_encode_requests_;
+  unsigned result_cache_max_entries_;
+  uint64_t result_cache_ttl_ms_;
+  bool result_cache_invalidation_;
+  bool request_coalescing_;
+  unsigned partition_stats_sample_rate_;
+  unsigned partition_stats_top_k_;
+  unsigned statement_metrics_max_statements_;
+  uint64_t paging_memory_budget_;
+  std::string topology_cache_path_;
 };
 
 } // namespace cass
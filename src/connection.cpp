@@ -33,7 +33,9 @@
 #include "register_request.hpp"
 #include "error_response.hpp"
 #include "event_response.hpp"
+#include "get_time.hpp"
 #include "logger.hpp"
+#include "protocol.hpp"
 
 #ifdef HAVE_NOSIGPIPE
 #include <sys/socket.h>
@@ -128,6 +130,7 @@ void Connection::StartupCallback::on_internal_set(ResponseMessage* response) {
     }
 
     case CQL_OPCODE_AUTHENTICATE: {
+      connection()->start_segments();
       AuthenticateResponse* auth
           = static_cast<AuthenticateResponse*>(response->response_body().get());
       connection()->on_authenticate(auth->class_name());
@@ -147,6 +150,7 @@ void Connection::StartupCallback::on_internal_set(ResponseMessage* response) {
       break;
 
     case CQL_OPCODE_READY:
+      connection()->start_segments();
       connection()->on_ready();
       break;
 
@@ -219,6 +223,7 @@ Connection::Connection(uv_loop_t* loop,
     : state_(CONNECTION_STATE_NEW)
     , error_code_(CONNECTION_OK)
     , ssl_error_code_(CASS_OK)
+    , schema_agreement_(this)
     , loop_(loop)
     , config_(config)
     , metrics_(metrics)
@@ -226,7 +231,8 @@ Connection::Connection(uv_loop_t* loop,
     , keyspace_(keyspace)
     , protocol_version_(protocol_version)
     , listener_(listener)
-    , response_(new ResponseMessage())
+    , response_(new ResponseMessage(this))
+    , is_segmented_(false)
     , stream_manager_(protocol_version)
     , ssl_session_(NULL)
     , heartbeat_outstanding_(false) {
@@ -338,13 +344,38 @@ void Connection::flush() {
   pending_writes_.back()->flush();
 }
 
-void Connection::schedule_schema_agreement(const SchemaChangeCallback::Ptr& callback, uint64_t wait) {
-  PendingSchemaAgreement* pending_schema_agreement = new PendingSchemaAgreement(callback);
-  pending_schema_agreements_.add_to_back(pending_schema_agreement);
-  pending_schema_agreement->timer.start(loop_,
-                                        wait,
-                                        pending_schema_agreement,
-                                        Connection::on_pending_schema_agreement);
+void Connection::wait_for_schema_agreement(const RequestExecution::Ptr& request_execution,
+                                           const Response::Ptr& response) {
+  schema_agreement_.add(SchemaChangeCallback::Waiter(request_execution, response));
+}
+
+void Connection::on_schema_agreement_checked(bool has_agreement, bool has_error,
+                                             SchemaChangeCallback::WaiterVec* waiters) {
+  schema_agreement_.on_checked(has_agreement, has_error,
+                               get_time_since_epoch_ms(), is_closing(), waiters);
+}
+
+void Connection::on_schema_change_event() {
+  schema_agreement_.on_schema_change_event();
+}
+
+void Connection::on_check_schema_agreement(SchemaChangeCallback::WaiterVec* waiters) {
+  SchemaChangeCallback::Ptr callback(new SchemaChangeCallback(this, waiters));
+  callback->execute();
+}
+
+void Connection::on_start_schema_agreement_timer(uint64_t delay_ms) {
+  schema_agreement_timer_.start(loop_, delay_ms, this,
+                                Connection::on_schema_agreement_retry);
+}
+
+void Connection::on_stop_schema_agreement_timer() {
+  schema_agreement_timer_.stop();
+}
+
+void Connection::on_schema_agreement_retry(Timer* timer) {
+  Connection* connection = static_cast<Connection*>(timer->data());
+  connection->schema_agreement_.on_timer();
 }
 
 void Connection::close() {
@@ -426,13 +457,55 @@ void Connection::set_state(ConnectionState new_state) {
 }
 
 void Connection::consume(char* input, size_t size) {
-  char* buffer = input;
-  size_t remaining = size;
-
   // A successful read means the connection is still responsive
   restart_terminate_timer();
 
-  while (remaining != 0 && !is_closing()) {
+  if (!is_segmented_) {
+    size_t consumed = consume_frames(input, size);
+    input += consumed;
+    size -= consumed;
+  }
+
+  // The response to STARTUP can be followed by segments
+  if (size > 0 && is_segmented_) {
+    consume_segments(input, size);
+  }
+}
+
+void Connection::consume_segments(char* input, size_t size) {
+  while (size != 0 && !is_closing()) {
+    ssize_t consumed = segment_decoder_.decode(input, size);
+    if (consumed <= 0) {
+      notify_error("Error consuming segment: " + segment_decoder_.error_message());
+      return;
+    }
+
+    if (segment_decoder_.is_payload_ready()) {
+      // Frames that span several segments are reassembled by the frame
+      // decoder the same way frames that span several reads are
+      consume_frames(const_cast<char*>(segment_decoder_.payload()),
+                     segment_decoder_.payload_size());
+    }
+
+    size -= consumed;
+    input += consumed;
+  }
+}
+
+void Connection::start_segments() {
+  if (!is_segmented_ && supports_segments(protocol_version_, host_->cassandra_version())) {
+    LOG_DEBUG("Using segments for protocol v%d on host %s",
+              protocol_version_, address_string().c_str());
+    is_segmented_ = true;
+  }
+}
+
+size_t Connection::consume_frames(char* input, size_t size) {
+  char* buffer = input;
+  size_t remaining = size;
+  const bool was_segmented = is_segmented_;
+
+  while (remaining != 0 && !is_closing() && is_segmented_ == was_segmented) {
     ssize_t consumed = response_->decode(buffer, remaining);
     if (consumed <= 0) {
       notify_error("Error consuming message");
@@ -441,7 +514,7 @@ void Connection::consume(char* input, size_t size) {
 
     if (response_->is_body_ready()) {
       ScopedPtr<ResponseMessage> response(response_.release());
-      response_.reset(new ResponseMessage());
+      response_.reset(new ResponseMessage(this));
 
       LOG_TRACE("Consumed message type %s with stream %d, input %u, remaining %u on host %s",
                 opcode_to_string(response->opcode()).c_str(),
@@ -509,6 +582,18 @@ void Connection::consume(char* input, size_t size) {
     remaining -= consumed;
     buffer += consumed;
   }
+
+  return size - remaining;
+}
+
+bool Connection::is_discarded(int16_t stream) const {
+  // Responses for cancelled requests only release their stream
+  RequestCallback* callback = NULL;
+  if (stream_manager_.get_pending(stream, callback)) {
+    return callback->state() == RequestCallback::REQUEST_STATE_CANCELLED_READING ||
+        callback->state() == RequestCallback::REQUEST_STATE_CANCELLED_WRITING;
+  }
+  return false;
 }
 
 void Connection::maybe_set_keyspace(ResponseMessage* response) {
@@ -589,14 +674,7 @@ void Connection::on_close(uv_handle_t* handle) {
     delete pending_write;
   }
 
-  while (!connection->pending_schema_agreements_.is_empty()) {
-    PendingSchemaAgreement* pending_schema_aggreement
-        = connection->pending_schema_agreements_.front();
-    connection->pending_schema_agreements_.remove(pending_schema_aggreement);
-    pending_schema_aggreement->stop_timer();
-    pending_schema_aggreement->callback->on_closing();
-    delete pending_schema_aggreement;
-  }
+  connection->schema_agreement_.close();
 
   connection->listener_->on_close(connection);
 
@@ -797,15 +875,6 @@ void Connection::on_supported(ResponseMessage* response) {
                                          new StartupRequest(config().no_compact())))));
 }
 
-void Connection::on_pending_schema_agreement(Timer* timer) {
-  PendingSchemaAgreement* pending_schema_agreement
-      = static_cast<PendingSchemaAgreement*>(timer->data());
-  Connection* connection = pending_schema_agreement->callback->connection();
-  connection->pending_schema_agreements_.remove(pending_schema_agreement);
-  pending_schema_agreement->callback->execute();
-  delete pending_schema_agreement;
-}
-
 void Connection::notify_ready() {
   connect_timer_.stop();
   restart_heartbeat_timer();
@@ -932,10 +1001,6 @@ void Connection::on_terminate(Timer* timer) {
                            CONNECTION_ERROR_TIMEOUT);
 }
 
-void Connection::PendingSchemaAgreement::stop_timer() {
-  timer.stop();
-}
-
 Connection::PendingWriteBase::~PendingWriteBase() {
   cleanup_pending_callbacks(&callbacks_);
 }
@@ -949,6 +1014,9 @@ int32_t Connection::PendingWriteBase::write(RequestCallback* callback) {
   }
 
   size_ += request_size;
+  if (is_segmented_) {
+    frame_sizes_.push_back(request_size);
+  }
   callbacks_.add_to_back(callback);
 
   return request_size;
@@ -1020,8 +1088,19 @@ void Connection::PendingWriteBase::on_write(uv_write_t* req, int status) {
   connection->flush();
 }
 
+void Connection::PendingWriteBase::encode_segments() {
+  if (!is_segmented_) return;
+
+  BufferVec segments;
+  Segment::encode(buffers_, frame_sizes_, &segments);
+  buffers_.swap(segments);
+  frame_sizes_.clear();
+}
+
 void Connection::PendingWrite::flush() {
   if (!is_flushed_ && !buffers_.empty()) {
+    encode_segments();
+
     UvBufVec bufs;
 
     bufs.reserve(buffers_.size());
@@ -1057,13 +1136,28 @@ void Connection::PendingWriteSsl::encrypt() {
     assert(it->size() > 0);
     size_t size = it->size();
 
+    // Large buffers (e.g. blobs) are encrypted in place, in full chunks,
+    // instead of being copied into the staging buffer first
+    while (copied == 0 && size - offset >= SSL_WRITE_SIZE) {
+      int rc = ssl_session->encrypt(it->data() + offset, SSL_WRITE_SIZE);
+      if (rc <= 0 && ssl_session->has_error()) {
+        connection_->notify_error("Unable to encrypt data: " + ssl_session->error_message(),
+                                  CONNECTION_ERROR_SSL_ENCRYPT);
+        return;
+      }
+      offset += SSL_WRITE_SIZE;
+      total += SSL_WRITE_SIZE;
+    }
+
     size_t to_copy = size - offset;
     size_t available = SSL_WRITE_SIZE - copied;
     if (available < to_copy) {
       to_copy = available;
     }
 
-    memcpy(buf + copied, it->data() + offset, to_copy);
+    if (to_copy > 0) {
+      memcpy(buf + copied, it->data() + offset, to_copy);
+    }
 
     copied += to_copy;
     offset += to_copy;
@@ -1076,7 +1170,7 @@ void Connection::PendingWriteSsl::encrypt() {
 
     is_done = (it == end);
 
-    if (is_done || copied == SSL_WRITE_SIZE) {
+    if (copied > 0 && (is_done || copied == SSL_WRITE_SIZE)) {
       int rc = ssl_session->encrypt(buf, copied);
       if (rc <= 0 && ssl_session->has_error()) {
         connection_->notify_error("Unable to encrypt data: " + ssl_session->error_message(),
@@ -1087,7 +1181,7 @@ void Connection::PendingWriteSsl::encrypt() {
     }
   }
 
-  LOG_TRACE("Copied %u bytes for encryption", static_cast<unsigned int>(total));
+  LOG_TRACE("Encrypted %u bytes", static_cast<unsigned int>(total));
 }
 
 void Connection::PendingWriteSsl::flush() {
@@ -1096,6 +1190,7 @@ void Connection::PendingWriteSsl::flush() {
 
     rb::RingBuffer::Position prev_pos = ssl_session->outgoing().write_position();
 
+    encode_segments();
     encrypt();
 
     SmallVector<uv_buf_t, SSL_ENCRYPTED_BUFS_COUNT> bufs;
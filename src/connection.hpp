@@ -30,6 +30,7 @@
 #include "response.hpp"
 #include "schema_change_callback.hpp"
 #include "scoped_ptr.hpp"
+#include "segment.hpp"
 #include "ssl.hpp"
 #include "stream_manager.hpp"
 #include "timer.hpp"
@@ -47,7 +48,8 @@ class Connector;
 class EventResponse;
 class Request;
 
-class Connection {
+class Connection : public ResponseMessage::Filter
+                 , public SchemaChangeCallback::Scheduler::Handler {
 public:
   enum ConnectionState {
     CONNECTION_STATE_NEW,
@@ -108,7 +110,17 @@ public:
   bool write(const RequestCallback::Ptr& request, bool flush_immediately = true);
   void flush();
 
-  void schedule_schema_agreement(const SchemaChangeCallback::Ptr& callback, uint64_t wait);
+  // Returns the response of a schema change request once the live nodes
+  // agree on the schema version. Concurrent schema change requests on the
+  // connection share a single agreement check.
+  void wait_for_schema_agreement(const RequestExecution::Ptr& request_execution,
+                                 const Response::Ptr& response);
+  void on_schema_agreement_checked(bool has_agreement, bool has_error,
+                                   SchemaChangeCallback::WaiterVec* waiters);
+
+  // Runs a pending schema agreement check immediately instead of waiting
+  // for the retry interval, e.g. after a schema change event was received.
+  void on_schema_change_event();
 
   uv_loop_t* loop() { return loop_; }
   const Config& config() const { return config_; }
@@ -151,6 +163,9 @@ public:
 
   static void on_timeout(Timer* timer);
 
+  // Response message filter method
+  virtual bool is_discarded(int16_t stream) const;
+
 private:
   class SslHandshakeWriter {
   public:
@@ -197,6 +212,7 @@ private:
     PendingWriteBase(Connection* connection)
       : connection_(connection)
       , is_flushed_(false)
+      , is_segmented_(connection->is_segmented_)
       , size_(0) {
       req_.data = this;
     }
@@ -218,11 +234,16 @@ private:
   protected:
     static void on_write(uv_write_t* req, int status);
 
+    // Replaces the frames with the segments that contain them
+    void encode_segments();
+
     Connection* connection_;
     uv_write_t req_;
     bool is_flushed_;
+    bool is_segmented_;
     size_t size_;
     BufferVec buffers_;
+    Segment::FrameSizeVec frame_sizes_;
     List<RequestCallback> callbacks_;
   };
 
@@ -248,21 +269,13 @@ private:
     static void on_write(uv_write_t* req, int status);
   };
 
-  struct PendingSchemaAgreement
-      : public List<PendingSchemaAgreement>::Node {
-    PendingSchemaAgreement(const SchemaChangeCallback::Ptr& callback)
-        : callback(callback) { }
-
-    void stop_timer();
-
-    SchemaChangeCallback::Ptr callback;
-    Timer timer;
-  };
-
   int32_t internal_write(const RequestCallback::Ptr& request, bool flush_immediately = true);
   void internal_close(ConnectionState close_state);
   void set_state(ConnectionState state);
   void consume(char* input, size_t size);
+  size_t consume_frames(char* input, size_t size);
+  void consume_segments(char* input, size_t size);
+  void start_segments();
   void maybe_set_keyspace(ResponseMessage* response);
 
   static void on_connect(Connector* connecter);
@@ -291,7 +304,10 @@ private:
   void on_ready();
   void on_set_keyspace();
   void on_supported(ResponseMessage* response);
-  static void on_pending_schema_agreement(Timer* timer);
+  virtual void on_check_schema_agreement(SchemaChangeCallback::WaiterVec* waiters);
+  virtual void on_start_schema_agreement_timer(uint64_t delay_ms);
+  virtual void on_stop_schema_agreement_timer();
+  static void on_schema_agreement_retry(Timer* timer);
 
   void notify_ready();
   void notify_error(const std::string& message, ConnectionError code = CONNECTION_ERROR_GENERIC);
@@ -314,7 +330,10 @@ private:
 
   List<PendingWriteBase> pending_writes_;
   List<RequestCallback> pending_reads_;
-  List<PendingSchemaAgreement> pending_schema_agreements_;
+
+  // Schedules the schema agreement checks of schema change requests
+  SchemaChangeCallback::Scheduler schema_agreement_;
+  Timer schema_agreement_timer_;
 
   uv_loop_t* loop_;
   const Config& config_;
@@ -325,6 +344,10 @@ private:
   Listener* listener_;
 
   ScopedPtr<ResponseMessage> response_;
+  // Protocol v5 and higher use segments after the STARTUP handshake (see
+  // supports_segments())
+  bool is_segmented_;
+  SegmentDecoder segment_decoder_;
   StreamManager<RequestCallback*> stream_manager_;
 
   uv_tcp_t socket_;
@@ -107,6 +107,7 @@
 #define CASS_DEFAULT_CONSISTENCY CASS_CONSISTENCY_LOCAL_ONE
 #define CASS_DEFAULT_SERIAL_CONSISTENCY CASS_CONSISTENCY_ANY
 #define CASS_DEFAULT_REQUEST_TIMEOUT_MS 12000u
+#define CASS_DEFAULT_PAGE_SIZE 5000 // The server's default page size
 
 #define CASS_DEFAULT_METADATA_REFRESH_FREQUENCY_SECS 60u
 
@@ -305,6 +305,7 @@ void ControlConnection::on_event(EventResponse* response) {
             session_->on_remove(host);
             if (session_->token_map_) {
               session_->token_map_->remove_host_and_build(host);
+              session_->update_token_map_snapshot();
             }
           } else {
             LOG_DEBUG("Tried to remove host %s that doesn't exist", address_str.c_str());
@@ -321,6 +322,7 @@ void ControlConnection::on_event(EventResponse* response) {
             LOG_DEBUG("Move event for host %s that doesn't exist", address_str.c_str());
             if (session_->token_map_) {
               session_->token_map_->remove_host_and_build(host);
+              session_->update_token_map_snapshot();
             }
           }
           break;
@@ -350,6 +352,20 @@ void ControlConnection::on_event(EventResponse* response) {
     }
 
     case CASS_EVENT_SCHEMA_CHANGE:
+      session_->broadcast_schema_change();
+
+      if (session_->result_cache_ &&
+          session_->config().result_cache_invalidation() &&
+          response->schema_change() != EventResponse::CREATED) {
+        if (response->schema_change_target() == EventResponse::KEYSPACE) {
+          session_->result_cache_->invalidate(response->keyspace().to_string(),
+                                              std::string());
+        } else if (response->schema_change_target() == EventResponse::TABLE) {
+          session_->result_cache_->invalidate(response->keyspace().to_string(),
+                                              response->target().to_string());
+        }
+      }
+
       // Only handle keyspace events when using token-aware routing
       if (!use_schema_ &&
           response->schema_change_target() != EventResponse::KEYSPACE) {
@@ -511,6 +527,13 @@ void ControlConnection::on_query_hosts(ControlConnection* control_connection,
   if (control_connection->use_schema_ ||
       control_connection->token_aware_routing_ ||
       control_connection->partition_aware_routing_) {
+    if (is_initial_connection && session->is_topology_cache_loaded()) {
+      // The partition map from the topology cache is used to route requests
+      // until the schema metadata has been refreshed in the background.
+      control_connection->state_ = CONTROL_STATE_READY;
+      session->on_control_connection_ready();
+      control_connection->query_plan_.reset(session->new_query_plan());
+    }
     control_connection->query_meta_schema();
   } else if (is_initial_connection) {
     control_connection->state_ = CONTROL_STATE_READY;
@@ -587,6 +610,7 @@ void ControlConnection::on_query_meta_schema(ControlConnection* control_connecti
       session->token_map_->add_keyspaces(cassandra_version, keyspaces_result);
     }
     session->token_map_->build();
+    session->update_token_map_snapshot();
   }
 
   if (control_connection->use_schema_) {
@@ -656,6 +680,8 @@ void ControlConnection::on_query_meta_schema(ControlConnection* control_connecti
     // "system" tables.
     control_connection->query_plan_.reset(session->new_query_plan());
   }
+
+  session->save_topology_cache();
 }
 
 void ControlConnection::refresh_node_info(Host::Ptr host,
@@ -825,6 +851,7 @@ void ControlConnection::update_node_info(Host::Ptr host, const Row* row, UpdateH
       if (session_->token_map_) {
         if (type == UPDATE_HOST_AND_BUILD) {
           session_->token_map_->update_host_and_build(host, v);
+          session_->update_token_map_snapshot();
         } else {
           session_->token_map_->add_host(host, v);
         }
@@ -875,6 +902,7 @@ void ControlConnection::on_refresh_keyspace(ControlConnection* control_connectio
 
   if (session->token_map_) {
     session->token_map_->update_keyspaces_and_build(cassandra_version, result);
+    session->update_token_map_snapshot();
   }
 
   if (control_connection->use_schema_) {
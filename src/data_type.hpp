@@ -21,6 +21,7 @@
 #include "external.hpp"
 #include "hash_table.hpp"
 #include "macros.hpp"
+#include "persistent_map.hpp"
 #include "ref_counted.hpp"
 #include "small_dense_hash_map.hpp"
 #include "types.hpp"
@@ -325,7 +326,7 @@ class UserType : public DataType {
 public:
   typedef SharedRefPtr<UserType> Ptr;
   typedef SharedRefPtr<const UserType> ConstPtr;
-  typedef std::map<std::string, UserType::Ptr > Map;
+  typedef PersistentMap<std::string, UserType::Ptr> Map;
 
   struct Field : public HashTableEntry<Field> {
     Field(const std::string& field_name,
@@ -550,6 +551,13 @@ struct IsValidDataType<CassBytes> {
   }
 };
 
+template<>
+struct IsValidDataType<CassExternalBytes> {
+  bool operator()(const CassExternalBytes&, const DataType::ConstPtr& data_type) const {
+    return is_bytes_type(data_type->value_type());
+  }
+};
+
 template<>
 struct IsValidDataType<CassCustom> {
   bool operator()(const CassCustom& custom, const DataType::ConstPtr& data_type) const {
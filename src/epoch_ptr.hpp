@@ -0,0 +1,158 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_EPOCH_PTR_HPP_INCLUDED__
+#define __CASS_EPOCH_PTR_HPP_INCLUDED__
+
+#include "atomic.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+
+#include <uv.h>
+
+#if defined(WIN32) || defined(_WIN32)
+#ifndef _WINSOCKAPI_
+#define _WINSOCKAPI_
+#endif
+#include <Windows.h>
+#else
+#include <sched.h>
+#endif
+
+namespace cass {
+
+// A published reference counted object that can be loaded without locking.
+//
+// Readers announce themselves in a per-thread slot for the current epoch
+// before loading the object. Publishing a new object advances the epoch and
+// waits for the readers of the previous epoch, the only ones that could have
+// loaded the replaced object without a reference, before releasing it. The
+// only shared write on the read path is the reference taken on the loaded
+// object.
+//
+// Calls to store() must be serialized by the caller.
+template <class T>
+class EpochPtr {
+public:
+  typedef SharedRefPtr<T> Ptr;
+
+  static const size_t NUM_SLOTS = 16;
+
+  explicit EpochPtr(const Ptr& ptr)
+    : current_(NULL)
+    , epoch_(0)
+#if UV_VERSION_MAJOR >= 1
+    , thread_count_(0)
+#endif
+  {
+#if UV_VERSION_MAJOR >= 1
+    uv_key_create(&slot_key_);
+#endif
+    store(ptr);
+  }
+
+  ~EpochPtr() {
+    T* current = current_.load();
+    if (current != NULL) current->dec_ref();
+#if UV_VERSION_MAJOR >= 1
+    uv_key_delete(&slot_key_);
+#endif
+  }
+
+  Ptr load() const {
+    Slot& slot = slots_[current_slot()];
+    while (true) {
+      size_t epoch = epoch_.load(MEMORY_ORDER_ACQUIRE);
+      Atomic<size_t>& readers = slot.readers[epoch & 1];
+      readers.fetch_add(1);
+      // The epoch can't be advanced past this reader after this check so
+      // the loaded object is valid until the reader leaves the epoch.
+      if (epoch_.load() == epoch) {
+        Ptr result(current_.load(MEMORY_ORDER_ACQUIRE));
+        readers.fetch_sub(1, MEMORY_ORDER_RELEASE);
+        return result;
+      }
+      readers.fetch_sub(1, MEMORY_ORDER_RELEASE);
+    }
+  }
+
+  void store(const Ptr& ptr) {
+    if (ptr) ptr->inc_ref();
+    T* previous = current_.exchange(ptr.get());
+    size_t epoch = epoch_.fetch_add(1);
+
+    // New readers use the next epoch and load the new object. Wait for the
+    // readers that entered the previous epoch.
+    for (size_t i = 0; i < NUM_SLOTS; ++i) {
+      while (slots_[i].readers[epoch & 1].load(MEMORY_ORDER_ACQUIRE) != 0) {
+        yield();
+      }
+    }
+
+    if (previous != NULL) previous->dec_ref();
+  }
+
+private:
+  struct Slot {
+    Slot() {
+      readers[0].store(0);
+      readers[1].store(0);
+    }
+
+    Atomic<size_t> readers[2];
+
+    // Keeps the slots used by different threads in different cache lines
+    static const size_t cacheline_size = 64;
+    char pad__[cacheline_size];
+  };
+
+  size_t current_slot() const {
+#if UV_VERSION_MAJOR == 0
+    return 0;
+#else
+    void* id = uv_key_get(&slot_key_);
+    if (id == NULL) {
+      id = reinterpret_cast<void*>(thread_count_.fetch_add(1) + 1);
+      uv_key_set(&slot_key_, id);
+    }
+    return (reinterpret_cast<size_t>(id) - 1) % NUM_SLOTS;
+#endif
+  }
+
+  static void yield() {
+#if defined(WIN32) || defined(_WIN32)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+  }
+
+private:
+  Atomic<T*> current_;
+  Atomic<size_t> epoch_;
+  mutable Slot slots_[NUM_SLOTS];
+#if UV_VERSION_MAJOR >= 1
+  mutable Atomic<size_t> thread_count_;
+  mutable uv_key_t slot_key_;
+#endif
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(EpochPtr);
+};
+
+} // namespace cass
+
+#endif
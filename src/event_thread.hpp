@@ -38,7 +38,7 @@ public:
 
   void close_handles() {
     LoopThread::close_handles();
-    event_queue_->close_handles();
+    close_handle(event_queue_->handle());
   }
 
   bool send_event_async(const E& event) { return event_queue_->enqueue(event); }
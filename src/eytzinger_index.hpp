@@ -0,0 +1,91 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_EYTZINGER_INDEX_HPP_INCLUDED__
+#define __CASS_EYTZINGER_INDEX_HPP_INCLUDED__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CASS_EYTZINGER_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define CASS_EYTZINGER_PREFETCH(addr)
+#endif
+
+namespace cass {
+
+// A search index over a sorted sequence stored in Eytzinger (breadth-first
+// binary tree) order. The first levels of the tree share a few cache lines
+// and the children of a node are adjacent so, unlike a binary search over the
+// sorted sequence, a search touches a predictable set of cache lines that can
+// be prefetched. Searches return positions in the original sorted sequence so
+// that associated data can be stored separately from the keys.
+template <class T>
+class EytzingerIndex {
+public:
+  EytzingerIndex()
+    : values_(1) { }
+
+  // The values must be sorted
+  void build(const std::vector<T>& sorted) {
+    values_.resize(sorted.size() + 1);
+    positions_.resize(sorted.size() + 1);
+    fill(sorted, 0, 1);
+  }
+
+  size_t size() const { return values_.size() - 1; }
+  bool empty() const { return values_.size() == 1; }
+
+  // Returns the position (in the sorted sequence) of the first value greater
+  // than "value" or size() if there is no such value.
+  size_t upper_bound(const T& value) const {
+    const size_t n = values_.size();
+    size_t k = 1;
+    while (k < n) {
+      // Prefetch the great-grandchildren while the comparison is resolved
+      if (8 * k < n) CASS_EYTZINGER_PREFETCH(&values_[8 * k]);
+      k = 2 * k + !(value < values_[k]);
+    }
+    // The search ends after the last right turn followed by a left turn
+    // at the first value greater than the searched value. Undo the
+    // trailing right turns and the final left turn.
+    while (k & 1) k >>= 1;
+    k >>= 1;
+    return k == 0 ? size() : positions_[k];
+  }
+
+private:
+  size_t fill(const std::vector<T>& sorted, size_t i, size_t k) {
+    if (k < values_.size()) {
+      i = fill(sorted, i, 2 * k);
+      values_[k] = sorted[i];
+      positions_[k] = static_cast<uint32_t>(i);
+      i = fill(sorted, i + 1, 2 * k + 1);
+    }
+    return i;
+  }
+
+private:
+  // 1-based, the first element is unused
+  std::vector<T> values_;
+  std::vector<uint32_t> positions_;
+};
+
+} // namespace cass
+
+#endif
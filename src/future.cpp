@@ -51,6 +51,16 @@ cass_bool_t cass_future_wait_timed(CassFuture* future, cass_duration_t wait_us)
   return static_cast<cass_bool_t>(future->wait_for(wait_us));
 }
 
+CassError cass_future_cancel(CassFuture* future) {
+  if (future->type() != cass::CASS_FUTURE_TYPE_RESPONSE) {
+    return CASS_ERROR_LIB_INVALID_FUTURE_TYPE;
+  }
+  if (!static_cast<cass::ResponseFuture*>(future->from())->cancel()) {
+    return CASS_ERROR_LIB_INVALID_STATE;
+  }
+  return CASS_OK;
+}
+
 const CassResult* cass_future_get_result(CassFuture* future) {
   if (future->type() != cass::CASS_FUTURE_TYPE_RESPONSE) {
     return NULL;
@@ -16,8 +16,52 @@
 
 #include "host.hpp"
 
+namespace {
+
+class HostIdPool {
+public:
+  HostIdPool()
+    : next_id_(0) { }
+
+  uint32_t acquire() {
+    cass::ScopedSpinlock l(&lock_);
+    if (!free_ids_.empty()) {
+      uint32_t id = free_ids_.back();
+      free_ids_.pop_back();
+      return id;
+    }
+    return next_id_++;
+  }
+
+  void release(uint32_t id) {
+    cass::ScopedSpinlock l(&lock_);
+    free_ids_.push_back(id);
+  }
+
+private:
+  cass::Spinlock lock_;
+  uint32_t next_id_;
+  std::vector<uint32_t> free_ids_;
+};
+
+// Never destroyed so that hosts can be freed during static destruction
+HostIdPool* host_id_pool() {
+  static HostIdPool* pool = new HostIdPool();
+  return pool;
+}
+
+} // namespace
+
 namespace cass {
 
+uint32_t Host::acquire_id() {
+  return host_id_pool()->acquire();
+}
+
+void Host::release_id(uint32_t id) {
+  host_id_pool()->release(id);
+}
+
 void add_host(CopyOnWriteHostVec& hosts, const Host::Ptr& host) {
   HostVec::iterator i;
   for (i = hosts->begin(); i != hosts->end(); ++i) {
@@ -67,6 +111,68 @@ void Host::LatencyTracker::update(uint64_t latency_ns) {
   current_.timestamp = now;
 }
 
+void Host::CircuitBreaker::record(bool is_failure, uint64_t now,
+                                 const std::string& address) {
+  ScopedSpinlock l(SpinlockPool<CircuitBreaker>::get_spinlock(this));
+
+  switch (state_) {
+    case CLOSED:
+      if (now - window_start_ > window_ns_) {
+        window_start_ = now;
+        num_requests_ = 0;
+        num_failures_ = 0;
+      }
+      num_requests_++;
+      if (is_failure) {
+        num_failures_++;
+        if (num_requests_ >= min_requests_ &&
+            num_failures_ >= failure_threshold_ * num_requests_) {
+          LOG_WARN("Opening circuit breaker for host %s (%u failures out of %u requests)",
+                   address.c_str(),
+                   static_cast<unsigned int>(num_failures_),
+                   static_cast<unsigned int>(num_requests_));
+          state_ = OPEN;
+          timestamp_ = now;
+        }
+      }
+      break;
+
+    case HALF_OPEN:
+      if (is_failure) {
+        LOG_DEBUG("Probe failed, reopening circuit breaker for host %s", address.c_str());
+        state_ = OPEN;
+        timestamp_ = now;
+      } else {
+        LOG_INFO("Closing circuit breaker for host %s", address.c_str());
+        state_ = CLOSED;
+        window_start_ = now;
+        num_requests_ = 0;
+        num_failures_ = 0;
+      }
+      break;
+
+    case OPEN:
+      // Outcomes of requests sent before the breaker opened are ignored
+      break;
+  }
+}
+
+bool Host::CircuitBreaker::allow_request(uint64_t now) {
+  ScopedSpinlock l(SpinlockPool<CircuitBreaker>::get_spinlock(this));
+
+  if (state_ == CLOSED) return true;
+
+  // Allow a probe once the open period has elapsed. Another probe is allowed
+  // if the outcome of the previous one was never recorded (e.g. the request
+  // was cancelled).
+  if (now - timestamp_ >= open_ns_) {
+    state_ = HALF_OPEN;
+    timestamp_ = now;
+    return true;
+  }
+  return false;
+}
+
 bool VersionNumber::parse(const std::string& version) {
   return sscanf(version.c_str(), "%d.%d.%d", &major_version_, &minor_version_, &patch_version_) >= 2;
 }
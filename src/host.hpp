@@ -113,14 +113,23 @@ public:
   };
 
   Host(const Address& address, bool mark)
-      : address_(address)
+      : id_(acquire_id())
+      , address_(address)
       , rack_id_(0)
       , dc_id_(0)
       , mark_(mark)
       , state_(ADDED)
       , address_string_(address.to_string()) { }
 
+  ~Host() { release_id(id_); }
+
+  // A small integer that's unique among the live hosts. IDs are reused so
+  // that sets of hosts can be represented as bitsets (see HostIdSet).
+  uint32_t id() const { return id_; }
+
   const Address& address() const { return address_; }
+  // The address without the port. This is how hosts are identified in
+  // partition metadata and in the list policies' filters.
   const std::string& address_string() const { return address_string_; }
 
   bool mark() const { return mark_; }
@@ -196,7 +205,71 @@ public:
     return TimestampedAverage();
   }
 
+  void enable_circuit_breaker(double failure_threshold, uint64_t min_requests,
+                              uint64_t window_ns, uint64_t open_ns) {
+    if (!circuit_breaker_) {
+      circuit_breaker_.reset(new CircuitBreaker(failure_threshold, min_requests,
+                                                window_ns, open_ns));
+    }
+  }
+
+  // Records the outcome of a request sent to this host. Failures are
+  // timeouts and errors that indicate the host is unhealthy.
+  void record_outcome(bool is_failure) {
+    if (circuit_breaker_) {
+      circuit_breaker_->record(is_failure, uv_hrtime(), address_string_);
+    }
+  }
+
+  // Returns false while the host's circuit breaker is open. Once the open
+  // period has elapsed a single probe request is allowed through.
+  bool allow_request() {
+    if (circuit_breaker_) {
+      return circuit_breaker_->allow_request(uv_hrtime());
+    }
+    return true;
+  }
+
 private:
+  class CircuitBreaker {
+  public:
+    enum State {
+      CLOSED,
+      OPEN,
+      HALF_OPEN
+    };
+
+    CircuitBreaker(double failure_threshold, uint64_t min_requests,
+                   uint64_t window_ns, uint64_t open_ns)
+      : failure_threshold_(failure_threshold)
+      , min_requests_(min_requests)
+      , window_ns_(window_ns)
+      , open_ns_(open_ns)
+      , state_(CLOSED)
+      , window_start_(0)
+      , num_requests_(0)
+      , num_failures_(0)
+      , timestamp_(0) { }
+
+    void record(bool is_failure, uint64_t now, const std::string& address);
+    bool allow_request(uint64_t now);
+
+  private:
+    const double failure_threshold_;
+    const uint64_t min_requests_;
+    const uint64_t window_ns_;
+    const uint64_t open_ns_;
+    State state_;
+    uint64_t window_start_;
+    uint64_t num_requests_;
+    uint64_t num_failures_;
+    // The time the breaker opened or, when half-open, the time of the probe
+    uint64_t timestamp_;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(CircuitBreaker);
+  };
+
   class LatencyTracker {
   public:
     LatencyTracker(uint64_t scale_ns, uint64_t threshold_to_account)
@@ -228,6 +301,10 @@ private:
     state_.store(state, MEMORY_ORDER_RELEASE);
   }
 
+  static uint32_t acquire_id();
+  static void release_id(uint32_t id);
+
+  const uint32_t id_;
   Address address_;
   uint32_t rack_id_;
   uint32_t dc_id_;
@@ -241,6 +318,7 @@ private:
   std::string dc_;
 
   ScopedPtr<LatencyTracker> latency_tracker_;
+  ScopedPtr<CircuitBreaker> circuit_breaker_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Host);
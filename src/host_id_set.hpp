@@ -0,0 +1,146 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_HOST_ID_SET_HPP_INCLUDED__
+#define __CASS_HOST_ID_SET_HPP_INCLUDED__
+
+#include "atomic.hpp"
+#include "macros.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace cass {
+
+// A set of hosts represented as a bitset of their IDs (see Host::id()).
+// Host IDs are small and dense so a membership test is a single bit test.
+//
+// The set is updated by a single thread (e.g. the session thread) while other
+// threads call contains(). The words are never resized in place: growing the
+// set publishes a larger copy and keeps the previous words until the set is
+// destroyed, so a reader never sees freed memory. The words only double in
+// size so the retired words are less than the current words.
+class HostIdSet {
+public:
+  HostIdSet()
+    : words_(NULL)
+    , size_(0) { }
+
+  ~HostIdSet() {
+    delete words_.load();
+    for (std::vector<Words*>::iterator it = retired_.begin(),
+         end = retired_.end(); it != end; ++it) {
+      delete *it;
+    }
+  }
+
+  bool contains(uint32_t id) const {
+    const Words* words = words_.load(MEMORY_ORDER_ACQUIRE);
+    size_t word = id / 64;
+    return words != NULL && word < words->count &&
+        (words->bits[word].load(MEMORY_ORDER_RELAXED) & bit(id)) != 0;
+  }
+
+  // The following methods must only be called by the updating thread
+
+  void add(uint32_t id) {
+    Words* words = grow(id / 64 + 1);
+    Atomic<uint64_t>& word = words->bits[id / 64];
+    uint64_t value = word.load(MEMORY_ORDER_RELAXED);
+    if ((value & bit(id)) == 0) {
+      word.store(value | bit(id), MEMORY_ORDER_RELAXED);
+      ++size_;
+    }
+  }
+
+  void remove(uint32_t id) {
+    Words* words = words_.load(MEMORY_ORDER_RELAXED);
+    size_t index = id / 64;
+    if (words == NULL || index >= words->count) return;
+    Atomic<uint64_t>& word = words->bits[index];
+    uint64_t value = word.load(MEMORY_ORDER_RELAXED);
+    if ((value & bit(id)) != 0) {
+      word.store(value & ~bit(id), MEMORY_ORDER_RELAXED);
+      --size_;
+    }
+  }
+
+  void clear() {
+    Words* words = words_.load(MEMORY_ORDER_RELAXED);
+    if (words != NULL) {
+      for (size_t i = 0; i < words->count; ++i) {
+        words->bits[i].store(0, MEMORY_ORDER_RELAXED);
+      }
+    }
+    size_ = 0;
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+private:
+  struct Words {
+    explicit Words(size_t count)
+      : count(count)
+      , bits(new Atomic<uint64_t>[count]) {
+      for (size_t i = 0; i < count; ++i) {
+        bits[i].store(0, MEMORY_ORDER_RELAXED);
+      }
+    }
+
+    ~Words() { delete[] bits; }
+
+    const size_t count;
+    Atomic<uint64_t>* const bits;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(Words);
+  };
+
+  Words* grow(size_t count) {
+    Words* words = words_.load(MEMORY_ORDER_RELAXED);
+    if (words != NULL && count <= words->count) return words;
+
+    size_t new_count = words != NULL ? words->count : 1;
+    while (new_count < count) new_count *= 2;
+
+    Words* new_words = new Words(new_count);
+    if (words != NULL) {
+      for (size_t i = 0; i < words->count; ++i) {
+        new_words->bits[i].store(words->bits[i].load(MEMORY_ORDER_RELAXED),
+                                 MEMORY_ORDER_RELAXED);
+      }
+      retired_.push_back(words);
+    }
+    words_.store(new_words, MEMORY_ORDER_RELEASE);
+    return new_words;
+  }
+
+  static uint64_t bit(uint32_t id) { return static_cast<uint64_t>(1) << (id % 64); }
+
+private:
+  Atomic<Words*> words_;
+  std::vector<Words*> retired_;
+  size_t size_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(HostIdSet);
+};
+
+} // namespace cass
+
+#endif
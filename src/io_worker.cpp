@@ -154,6 +154,25 @@ IOWorker::~IOWorker() {
 }
 
 int IOWorker::init() {
+  if (session_->is_run_externally()) {
+    // Share the session's loop which is run by the application's thread
+    attach(session_->loop());
+    return internal_init();
+  }
+
+  // Only the IO workers are attached to the shared threads. The session's
+  // own thread (and its control connection) isn't shared.
+  const SharedIOThreads::Ptr& shared_io_threads(config_.shared_io_threads());
+  if (shared_io_threads) {
+    size_t index = shared_io_threads->next_thread_index();
+    attach(shared_io_threads->loop(index));
+    // Handles must be initialized on the thread that's running the loop
+    return shared_io_threads->run_task(index, on_init, this);
+  }
+  return internal_init();
+}
+
+int IOWorker::internal_init() {
   int rc = EventThread<IOWorkerEvent>::init(config_.queue_size_event());
   if (rc != 0) return rc;
   rc = request_queue_.init(loop(), this, &IOWorker::on_execute);
@@ -205,6 +224,26 @@ bool IOWorker::remove_pool_async(const Host::ConstPtr& host, bool cancel_reconne
   return send_event_async(event);
 }
 
+bool IOWorker::cancel_request_async(RequestHandler* request_handler) {
+  IOWorkerEvent event;
+  event.type = IOWorkerEvent::CANCEL_REQUEST;
+  event.request_handler = request_handler;
+  request_handler->inc_ref(); // Queue reference
+  if (!send_event_async(event)) {
+    // The request is still stopped when its response, error or timeout
+    // is handled.
+    request_handler->dec_ref();
+    return false;
+  }
+  return true;
+}
+
+bool IOWorker::schema_change_async() {
+  IOWorkerEvent event;
+  event.type = IOWorkerEvent::SCHEMA_CHANGE;
+  return send_event_async(event);
+}
+
 void IOWorker::close_async() {
   while (!request_queue_.enqueue(NULL)) {
     // Keep trying
@@ -236,8 +275,16 @@ void IOWorker::add_pool(const Host::ConstPtr& host, bool is_initial_connection)
 }
 
 bool IOWorker::execute(const RequestHandler::Ptr& request_handler) {
+  if (session_->is_run_externally()) {
+    // Already on the loop's thread so the request can be started without
+    // handing it off through the request queue.
+    outstanding_requests_.add();
+    start(request_handler);
+    return true;
+  }
+
   request_handler->inc_ref(); // Queue reference
-  if (!request_queue_.enqueue(request_handler.get())) {
+  if (!outstanding_requests_.enqueue(&request_queue_, request_handler.get())) {
     request_handler->dec_ref();
     return false;
   }
@@ -303,6 +350,7 @@ void IOWorker::retry(const RequestExecution::Ptr& request_execution) {
 
 void IOWorker::request_finished() {
   pending_request_count_--;
+  outstanding_requests_.finish();
   maybe_close();
   request_queue_.send();
 }
@@ -374,23 +422,50 @@ void IOWorker::maybe_close() {
 void IOWorker::maybe_notify_closed() {
   if (is_closing() && pools_.empty()) {
     state_ = IO_WORKER_STATE_CLOSED;
-    session_->notify_worker_closed_async();
-    close_handles();
+    if (is_attached()) {
+      // The shared loop keeps running so the session is notified after the
+      // handles are closed (in on_handles_closed()) instead of after joining
+      // this worker's thread.
+      close_handles();
+    } else {
+      session_->notify_worker_closed_async();
+      close_handles();
+    }
   }
 }
 
 void IOWorker::close_handles() {
   EventThread<IOWorkerEvent>::close_handles();
-  request_queue_.close_handles();
+  close_handle(request_queue_.handle());
   uv_check_stop(&check_);
-  uv_close(reinterpret_cast<uv_handle_t*>(&check_), NULL);
+  close_handle(reinterpret_cast<uv_handle_t*>(&check_));
   uv_prepare_stop(&prepare_);
-  uv_close(reinterpret_cast<uv_handle_t*>(&prepare_), NULL);
+  close_handle(reinterpret_cast<uv_handle_t*>(&prepare_));
 }
 
-void IOWorker::on_event(const IOWorkerEvent& event) {
-  const Address& address = event.host->address();
+void IOWorker::start(const RequestHandler::Ptr& request_handler) {
+  pending_request_count_++;
+  request_handler->start_request(this);
+  if (request_handler->is_cancelled()) {
+    // The request was cancelled while it was queued (or while it was
+    // being started) so stop it before anything is written.
+    request_handler->finish_cancel();
+  } else {
+    RequestExecution::Ptr request_execution(new RequestExecution(request_handler,
+                                                                 request_handler->current_host()));
+    request_execution->execute();
+  }
+}
+
+int IOWorker::on_init(void* data) {
+  return static_cast<IOWorker*>(data)->internal_init();
+}
+
+void IOWorker::on_handles_closed() {
+  session_->notify_worker_closed_async();
+}
 
+void IOWorker::on_event(const IOWorkerEvent& event) {
   switch (event.type) {
     case IOWorkerEvent::ADD_POOL: {
       add_pool(event.host, event.is_initial_connection);
@@ -398,7 +473,7 @@ void IOWorker::on_event(const IOWorkerEvent& event) {
     }
 
     case IOWorkerEvent::REMOVE_POOL: {
-      PoolMap::iterator it = pools_.find(address);
+      PoolMap::iterator it = pools_.find(event.host->address());
       if (it != pools_.end()) {
         LOG_DEBUG("Remove pool event for %s closing pool(%p) io_worker(%p)",
                   event.host->address_string().c_str(),
@@ -409,6 +484,21 @@ void IOWorker::on_event(const IOWorkerEvent& event) {
       break;
     }
 
+    case IOWorkerEvent::CANCEL_REQUEST: {
+      event.request_handler->finish_cancel();
+      event.request_handler->dec_ref(); // Queue reference
+      break;
+    }
+
+    case IOWorkerEvent::SCHEMA_CHANGE: {
+      // Check schema agreement for pending schema changes right away
+      for (PoolMap::iterator it = pools_.begin(), end = pools_.end();
+           it != end; ++it) {
+        it->second->on_schema_change_event();
+      }
+      break;
+    }
+
     default:
       assert(false);
       break;
@@ -428,11 +518,7 @@ void IOWorker::on_execute(uv_async_t* async) {
     RequestHandler::Ptr request_handler(temp);
     if (request_handler) {
       request_handler->dec_ref(); // Queue reference
-      io_worker->pending_request_count_++;
-      request_handler->start_request(io_worker);
-      RequestExecution::Ptr request_execution(new RequestExecution(request_handler,
-                                                                   request_handler->current_host()));
-      request_execution->execute();
+      io_worker->start(request_handler);
     } else {
       io_worker->state_ = IO_WORKER_STATE_CLOSING;
     }
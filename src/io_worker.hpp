@@ -24,6 +24,7 @@
 #include "constants.hpp"
 #include "event_thread.hpp"
 #include "host.hpp"
+#include "io_worker_selector.hpp"
 #include "logger.hpp"
 #include "metrics.hpp"
 #include "pool.hpp"
@@ -49,18 +50,22 @@ struct IOWorkerEvent {
   enum Type {
     INVALID,
     ADD_POOL,
-    REMOVE_POOL
+    REMOVE_POOL,
+    CANCEL_REQUEST,
+    SCHEMA_CHANGE
   };
 
   IOWorkerEvent()
     : type(INVALID)
     , is_initial_connection(false)
-    , cancel_reconnect(false) {}
+    , cancel_reconnect(false)
+    , request_handler(NULL) {}
 
   Type type;
   Host::ConstPtr host;
   bool is_initial_connection;
   bool cancel_reconnect;
+  RequestHandler* request_handler;
 };
 
 class IOWorker
@@ -102,10 +107,19 @@ public:
 
   bool add_pool_async(const Host::ConstPtr& host, bool is_initial_connection);
   bool remove_pool_async(const Host::ConstPtr& host, bool cancel_reconnect);
+  bool cancel_request_async(RequestHandler* request_handler);
+  bool schema_change_async();
   void close_async();
 
   bool execute(const RequestHandler::Ptr& request_handler);
 
+  // The number of requests handed to this worker that haven't finished,
+  // including the requests still in its queue. It's used by the session to
+  // dispatch requests to the least loaded worker.
+  int outstanding_request_count() const {
+    return outstanding_requests_.count();
+  }
+
   // Prepares a statement on all other hosts. It returns false if
   // "prepare on all" is disabled in the config or if there's
   // not enough hosts.
@@ -128,6 +142,13 @@ private:
   void maybe_notify_closed();
   void close_handles();
 
+  int internal_init();
+  static int on_init(void* data);
+
+  void start(const RequestHandler::Ptr& request_handler);
+
+  virtual void on_handles_closed();
+
   static void on_pending_pool_reconnect(Timer* timer);
 
   virtual void on_event(const IOWorkerEvent& event);
@@ -165,6 +186,7 @@ private:
   PoolVec pools_pending_request_processing_;
   bool is_closing_;
   int pending_request_count_;
+  OutstandingRequests outstanding_requests_;
 
   AsyncQueue<SPSCQueue<RequestHandler*> > request_queue_;
 };
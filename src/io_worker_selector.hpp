@@ -0,0 +1,132 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_IO_WORKER_SELECTOR_HPP_INCLUDED__
+#define __CASS_IO_WORKER_SELECTOR_HPP_INCLUDED__
+
+#include "atomic.hpp"
+#include "macros.hpp"
+
+#include <stddef.h>
+#include <vector>
+
+namespace cass {
+
+// The number of requests handed to an I/O worker that haven't finished,
+// including the requests still in its queue. It's updated by the session
+// thread (when a request is handed off) and by the worker's thread (when a
+// request finishes) and read by the session thread to select a worker.
+class OutstandingRequests {
+public:
+  OutstandingRequests()
+    : count_(0) { }
+
+  int count() const {
+    return count_.load(MEMORY_ORDER_RELAXED);
+  }
+
+  // Counts a request that's started without being queued
+  void add() {
+    count_.fetch_add(1, MEMORY_ORDER_RELAXED);
+  }
+
+  // Counts a request and queues it. The request is counted before it's
+  // queued so that it can't finish (and be subtracted) before it's added.
+  // The count is taken back if the queue is full.
+  template <class Queue, class Entry>
+  bool enqueue(Queue* queue, const Entry& entry) {
+    count_.fetch_add(1, MEMORY_ORDER_RELAXED);
+    if (!queue->enqueue(entry)) {
+      count_.fetch_sub(1, MEMORY_ORDER_RELAXED);
+      return false;
+    }
+    return true;
+  }
+
+  void finish() {
+    count_.fetch_sub(1, MEMORY_ORDER_RELAXED);
+  }
+
+private:
+  Atomic<int> count_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(OutstandingRequests);
+};
+
+// Selects the I/O worker a request is handed to. The least loaded worker
+// (the one with the fewest outstanding requests) is tried first so that a
+// worker that's stalled (e.g. by a slow callback) stops receiving its share
+// of the requests. Workers with the same load are used round-robin. If a
+// worker's queue is full the following workers are tried.
+//
+// A worker must provide:
+//
+//   int outstanding_request_count() const;
+//   bool execute(const Request& request);  // False if it can't be queued
+//
+// This must only be used from the session's thread.
+template <class WorkerPtr>
+class IOWorkerSelector {
+public:
+  typedef std::vector<WorkerPtr> WorkerVec;
+
+  IOWorkerSelector()
+    : next_(0) { }
+
+  void reset() { next_ = 0; }
+
+  // Returns the index of the worker to try first
+  size_t select(const WorkerVec& workers) {
+    size_t size = workers.size();
+    size_t start = next_ % size;
+    int min_count = workers[start]->outstanding_request_count();
+    for (size_t i = 1; i < size && min_count > 0; ++i) {
+      size_t index = (next_ + i) % size;
+      int count = workers[index]->outstanding_request_count();
+      if (count < min_count) {
+        start = index;
+        min_count = count;
+      }
+    }
+    next_ = (next_ + 1) % size;
+    return start;
+  }
+
+  // Returns false if none of the workers could take the request
+  template <class Request>
+  bool execute(const WorkerVec& workers, const Request& request) {
+    if (workers.empty()) return false;
+    size_t size = workers.size();
+    size_t start = select(workers);
+    for (size_t i = 0; i < size; ++i) {
+      if (workers[(start + i) % size]->execute(request)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  size_t next_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(IOWorkerSelector);
+};
+
+} // namespace cass
+
+#endif
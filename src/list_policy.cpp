@@ -24,10 +24,12 @@ void ListPolicy::init(const Host::Ptr& connected_host,
                       const HostMap& hosts,
                       Random* random) {
   HostMap valid_hosts;
+  valid_hosts_.clear();
   for (HostMap::const_iterator i = hosts.begin(),
     end = hosts.end(); i != end; ++i) {
     const Host::Ptr& host = i->second;
     if (is_valid_host(host)) {
+      valid_hosts_.add(host->id());
       valid_hosts.insert(HostPair(i->first, host));
     }
   }
@@ -40,7 +42,7 @@ void ListPolicy::init(const Host::Ptr& connected_host,
 }
 
 CassHostDistance ListPolicy::distance(const Host::Ptr& host) const {
-  if (is_valid_host(host)) {
+  if (is_valid(host)) {
     return child_policy_->distance(host);
   }
   return CASS_HOST_DISTANCE_IGNORE;
@@ -53,24 +55,26 @@ QueryPlan* ListPolicy::new_query_plan(const std::string& keyspace,
 
 void ListPolicy::on_add(const Host::Ptr& host) {
   if (is_valid_host(host)) {
+    valid_hosts_.add(host->id());
     child_policy_->on_add(host);
   }
 }
 
 void ListPolicy::on_remove(const Host::Ptr& host) {
-  if (is_valid_host(host)) {
+  if (is_valid(host)) {
+    valid_hosts_.remove(host->id());
     child_policy_->on_remove(host);
   }
 }
 
 void ListPolicy::on_up(const Host::Ptr& host) {
-  if (is_valid_host(host)) {
+  if (is_valid(host)) {
     child_policy_->on_up(host);
   }
 }
 
 void ListPolicy::on_down(const Host::Ptr& host) {
-  if (is_valid_host(host)) {
+  if (is_valid(host)) {
     child_policy_->on_down(host);
   }
 }
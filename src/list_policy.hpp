@@ -19,6 +19,7 @@
 
 #include "load_balancing.hpp"
 #include "host.hpp"
+#include "host_id_set.hpp"
 #include "scoped_ptr.hpp"
 
 namespace cass {
@@ -45,8 +46,19 @@ public:
   virtual ListPolicy* new_instance() = 0;
 
 private:
+  // Matches a host against the policy's filter. This is only done when a
+  // host is added; the result is kept in a bitset of host IDs so that
+  // checking a host is a bit test. The bitset is updated on the session
+  // thread and read by distance() on the I/O threads.
   virtual bool is_valid_host(const Host::Ptr& host) const = 0;
 
+  bool is_valid(const Host::Ptr& host) const {
+    return valid_hosts_.contains(host->id());
+  }
+
+private:
+  HostIdSet valid_hosts_;
+
 };
 
 } // namespace cass
@@ -58,6 +58,10 @@ public:
 #else
       : is_loop_initialized_(false)
 #endif
+      , external_loop_(NULL)
+      , pending_close_count_(0)
+      , is_run_externally_(false)
+      , is_running_(false)
       , is_joinable_(false) {}
 
   virtual ~LoopThread() {
@@ -70,8 +74,38 @@ public:
 #endif
   }
 
+  // Attaches to a loop that is owned and run by another thread (e.g. a
+  // thread of a shared SharedIOThreads). This must be called before init(). An
+  // attached thread doesn't create a thread of its own so run() and join()
+  // have no effect, and on_handles_closed() is called instead of
+  // on_after_run() once all the handles closed with close_handle() are done.
+  void attach(uv_loop_t* loop) {
+    assert(external_loop_ == NULL);
+    external_loop_ = loop;
+  }
+
+  bool is_attached() const { return external_loop_ != NULL; }
+
+  // Runs the loop on the application's thread instead of creating a thread.
+  // This must be called before init(). run() only starts the loop and the
+  // application is responsible for calling run_once() (e.g. when
+  // backend_fd() is readable or when backend_timeout() expires) until it
+  // returns false.
+  void set_run_externally(bool enable) {
+    assert(!is_running_);
+    is_run_externally_ = enable;
+  }
+
+  bool is_run_externally() const { return is_run_externally_; }
+
+  bool is_running() const { return is_running_; }
+
   int init() {
     int rc = 0;
+    // The owner of the loop is responsible for its initialization and for
+    // handling SIGPIPE on its thread.
+    if (is_attached()) return rc;
+
 #if UV_VERSION_MAJOR > 0
     rc = uv_loop_init(&loop_);
     if (rc != 0) return rc;
@@ -79,6 +113,8 @@ public:
 #endif
 
 #if defined(HAVE_SIGTIMEDWAIT) && !defined(HAVE_NOSIGPIPE)
+    // The application owns the thread's signal mask when it runs the loop
+    if (is_run_externally_) return rc;
     rc = block_sigpipe();
     if (rc != 0) return rc;
     rc = uv_prepare_init(loop(), &prepare_);
@@ -91,18 +127,25 @@ public:
 
   void close_handles() {
 #if defined(HAVE_SIGTIMEDWAIT) && !defined(HAVE_NOSIGPIPE)
+    if (is_attached() || is_run_externally_) return;
     uv_prepare_stop(&prepare_);
     uv_close(reinterpret_cast<uv_handle_t*>(&prepare_), NULL);
 #endif
   }
 
 #if UV_VERSION_MAJOR == 0
-  uv_loop_t* loop() { return loop_; }
+  uv_loop_t* loop() { return is_attached() ? external_loop_ : loop_; }
 #else
-  uv_loop_t* loop() { return &loop_; }
+  uv_loop_t* loop() { return is_attached() ? external_loop_ : &loop_; }
 #endif
 
   int run() {
+    if (is_attached()) return 0;
+    if (is_run_externally_) {
+      is_running_ = true;
+      on_run();
+      return 0;
+    }
     int rc = uv_thread_create(&thread_, on_run_internal, this);
     if (rc == 0) is_joinable_ = true;
     return rc;
@@ -117,11 +160,55 @@ public:
     }
   }
 
+  // Runs a single iteration of an externally run loop. It returns false once
+  // the loop has no more active handles or requests (after the owner has
+  // closed its handles) or if the loop isn't running.
+  bool run_once(bool nowait) {
+    if (!is_running_) return false;
+    if (uv_run(loop(), nowait ? UV_RUN_NOWAIT : UV_RUN_ONCE) == 0) {
+      is_running_ = false;
+      on_after_run();
+      return false;
+    }
+    return true;
+  }
+
+  int backend_fd() {
+    if (!is_running_) return -1;
+    return uv_backend_fd(loop());
+  }
+
+  int backend_timeout() {
+    if (!is_running_) return -1;
+    return uv_backend_timeout(loop());
+  }
+
 protected:
   virtual void on_run() {}
   virtual void on_after_run() {}
+  virtual void on_handles_closed() {}
+
+  // Closes a handle owned by this thread. When attached to an external loop
+  // the loop keeps running after the handles are closed so the close
+  // callbacks are tracked to know when it's safe to release this object.
+  void close_handle(uv_handle_t* handle) {
+    if (!is_attached()) {
+      uv_close(handle, NULL);
+      return;
+    }
+    pending_close_count_++;
+    handle->data = this;
+    uv_close(handle, on_close_handle);
+  }
 
 private:
+  static void on_close_handle(uv_handle_t* handle) {
+    LoopThread* thread = static_cast<LoopThread*>(handle->data);
+    if (--thread->pending_close_count_ == 0) {
+      thread->on_handles_closed();
+    }
+  }
+
   static void on_run_internal(void* data) {
     LoopThread* thread = static_cast<LoopThread*>(data);
     thread->on_run();
@@ -151,6 +238,10 @@ private:
   uv_prepare_t prepare_;
 #endif
 
+  uv_loop_t* external_loop_;
+  int pending_close_count_;
+  bool is_run_externally_;
+  bool is_running_;
   uv_thread_t thread_;
   bool is_joinable_;
 };
@@ -39,6 +39,9 @@
 #define THREE_PARAMS1_(A, B, C)  ,A,B,C
 #define THREE_PARAMS_(A, B, C) THREE_PARAMS1_(A, B, C)
 
+#define FOUR_PARAMS1_(A, B, C, D)  ,A,B,C,D
+#define FOUR_PARAMS_(A, B, C, D) FOUR_PARAMS1_(A, B, C, D)
+
 // Done this way so that macros like __LINE__ will expand before
 // being concatenated.
 #define STATIC_ASSERT_CONCAT(Arg1, Arg2)  STATIC_ASSERT_CONCAT1(Arg1, Arg2)
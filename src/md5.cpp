@@ -61,8 +61,166 @@
   (block_[(n)])
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CASS_MD5_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Pads a message that fits in a single block: the message, a 1 bit, zeros
+// and the message's length in bits (64-bit little-endian).
+void pad_single_block(const uint8_t* data, size_t size, uint8_t* block) {
+  if (size > 0) memcpy(block, data, size);
+  block[size] = 0x80;
+  memset(block + size + 1, 0, 56 - (size + 1));
+  uint64_t bits = static_cast<uint64_t>(size) << 3;
+  for (size_t i = 0; i < 8; ++i) {
+    block[56 + i] = static_cast<uint8_t>(bits >> (8 * i));
+  }
+}
+
+#ifdef CASS_MD5_SSE2
+
+// The basic MD5 functions and the transformation for four messages at a
+// time. Each 32-bit lane of a vector holds the state of one message.
+#define F4(x, y, z) _mm_xor_si128((z), _mm_and_si128((x), _mm_xor_si128((y), (z))))
+#define G4(x, y, z) _mm_xor_si128((y), _mm_and_si128((z), _mm_xor_si128((x), (y))))
+#define H4(x, y, z) _mm_xor_si128(_mm_xor_si128((x), (y)), (z))
+#define I4(x, y, z) _mm_xor_si128((y), _mm_or_si128((x), _mm_xor_si128((z), ones)))
+
+#define STEP4(f, a, b, c, d, x, t, s) \
+  (a) = _mm_add_epi32((a), _mm_add_epi32(f((b), (c), (d)), \
+                           _mm_add_epi32((x), _mm_set1_epi32(static_cast<int>(t))))); \
+  (a) = _mm_or_si128(_mm_slli_epi32((a), (s)), _mm_srli_epi32((a), 32 - (s))); \
+  (a) = _mm_add_epi32((a), (b));
+
+// Hashes four padded single block messages
+void hash_blocks_sse2(const uint8_t (*blocks)[64], uint8_t (*digests)[16]) {
+  const __m128i ones = _mm_set1_epi32(-1);
+
+  // Transpose the blocks so that w[n] holds word n of each message. SSE2
+  // implies a little-endian (x86) processor so the words need no swapping.
+  __m128i w[16];
+  for (size_t n = 0; n < 16; n += 4) {
+    __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[0] + 4 * n));
+    __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[1] + 4 * n));
+    __m128i r2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[2] + 4 * n));
+    __m128i r3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[3] + 4 * n));
+    __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+    __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+    __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+    __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+    w[n + 0] = _mm_unpacklo_epi64(t0, t1);
+    w[n + 1] = _mm_unpackhi_epi64(t0, t1);
+    w[n + 2] = _mm_unpacklo_epi64(t2, t3);
+    w[n + 3] = _mm_unpackhi_epi64(t2, t3);
+  }
+
+  const __m128i init_a = _mm_set1_epi32(0x67452301);
+  const __m128i init_b = _mm_set1_epi32(static_cast<int>(0xefcdab89));
+  const __m128i init_c = _mm_set1_epi32(static_cast<int>(0x98badcfe));
+  const __m128i init_d = _mm_set1_epi32(0x10325476);
+
+  __m128i a = init_a, b = init_b, c = init_c, d = init_d;
+
+  // Round 1
+  STEP4(F4, a, b, c, d, w[0], 0xd76aa478, 7)
+  STEP4(F4, d, a, b, c, w[1], 0xe8c7b756, 12)
+  STEP4(F4, c, d, a, b, w[2], 0x242070db, 17)
+  STEP4(F4, b, c, d, a, w[3], 0xc1bdceee, 22)
+  STEP4(F4, a, b, c, d, w[4], 0xf57c0faf, 7)
+  STEP4(F4, d, a, b, c, w[5], 0x4787c62a, 12)
+  STEP4(F4, c, d, a, b, w[6], 0xa8304613, 17)
+  STEP4(F4, b, c, d, a, w[7], 0xfd469501, 22)
+  STEP4(F4, a, b, c, d, w[8], 0x698098d8, 7)
+  STEP4(F4, d, a, b, c, w[9], 0x8b44f7af, 12)
+  STEP4(F4, c, d, a, b, w[10], 0xffff5bb1, 17)
+  STEP4(F4, b, c, d, a, w[11], 0x895cd7be, 22)
+  STEP4(F4, a, b, c, d, w[12], 0x6b901122, 7)
+  STEP4(F4, d, a, b, c, w[13], 0xfd987193, 12)
+  STEP4(F4, c, d, a, b, w[14], 0xa679438e, 17)
+  STEP4(F4, b, c, d, a, w[15], 0x49b40821, 22)
+
+  // Round 2
+  STEP4(G4, a, b, c, d, w[1], 0xf61e2562, 5)
+  STEP4(G4, d, a, b, c, w[6], 0xc040b340, 9)
+  STEP4(G4, c, d, a, b, w[11], 0x265e5a51, 14)
+  STEP4(G4, b, c, d, a, w[0], 0xe9b6c7aa, 20)
+  STEP4(G4, a, b, c, d, w[5], 0xd62f105d, 5)
+  STEP4(G4, d, a, b, c, w[10], 0x02441453, 9)
+  STEP4(G4, c, d, a, b, w[15], 0xd8a1e681, 14)
+  STEP4(G4, b, c, d, a, w[4], 0xe7d3fbc8, 20)
+  STEP4(G4, a, b, c, d, w[9], 0x21e1cde6, 5)
+  STEP4(G4, d, a, b, c, w[14], 0xc33707d6, 9)
+  STEP4(G4, c, d, a, b, w[3], 0xf4d50d87, 14)
+  STEP4(G4, b, c, d, a, w[8], 0x455a14ed, 20)
+  STEP4(G4, a, b, c, d, w[13], 0xa9e3e905, 5)
+  STEP4(G4, d, a, b, c, w[2], 0xfcefa3f8, 9)
+  STEP4(G4, c, d, a, b, w[7], 0x676f02d9, 14)
+  STEP4(G4, b, c, d, a, w[12], 0x8d2a4c8a, 20)
+
+  // Round 3
+  STEP4(H4, a, b, c, d, w[5], 0xfffa3942, 4)
+  STEP4(H4, d, a, b, c, w[8], 0x8771f681, 11)
+  STEP4(H4, c, d, a, b, w[11], 0x6d9d6122, 16)
+  STEP4(H4, b, c, d, a, w[14], 0xfde5380c, 23)
+  STEP4(H4, a, b, c, d, w[1], 0xa4beea44, 4)
+  STEP4(H4, d, a, b, c, w[4], 0x4bdecfa9, 11)
+  STEP4(H4, c, d, a, b, w[7], 0xf6bb4b60, 16)
+  STEP4(H4, b, c, d, a, w[10], 0xbebfbc70, 23)
+  STEP4(H4, a, b, c, d, w[13], 0x289b7ec6, 4)
+  STEP4(H4, d, a, b, c, w[0], 0xeaa127fa, 11)
+  STEP4(H4, c, d, a, b, w[3], 0xd4ef3085, 16)
+  STEP4(H4, b, c, d, a, w[6], 0x04881d05, 23)
+  STEP4(H4, a, b, c, d, w[9], 0xd9d4d039, 4)
+  STEP4(H4, d, a, b, c, w[12], 0xe6db99e5, 11)
+  STEP4(H4, c, d, a, b, w[15], 0x1fa27cf8, 16)
+  STEP4(H4, b, c, d, a, w[2], 0xc4ac5665, 23)
+
+  // Round 4
+  STEP4(I4, a, b, c, d, w[0], 0xf4292244, 6)
+  STEP4(I4, d, a, b, c, w[7], 0x432aff97, 10)
+  STEP4(I4, c, d, a, b, w[14], 0xab9423a7, 15)
+  STEP4(I4, b, c, d, a, w[5], 0xfc93a039, 21)
+  STEP4(I4, a, b, c, d, w[12], 0x655b59c3, 6)
+  STEP4(I4, d, a, b, c, w[3], 0x8f0ccc92, 10)
+  STEP4(I4, c, d, a, b, w[10], 0xffeff47d, 15)
+  STEP4(I4, b, c, d, a, w[1], 0x85845dd1, 21)
+  STEP4(I4, a, b, c, d, w[8], 0x6fa87e4f, 6)
+  STEP4(I4, d, a, b, c, w[15], 0xfe2ce6e0, 10)
+  STEP4(I4, c, d, a, b, w[6], 0xa3014314, 15)
+  STEP4(I4, b, c, d, a, w[13], 0x4e0811a1, 21)
+  STEP4(I4, a, b, c, d, w[4], 0xf7537e82, 6)
+  STEP4(I4, d, a, b, c, w[11], 0xbd3af235, 10)
+  STEP4(I4, c, d, a, b, w[2], 0x2ad7d2bb, 15)
+  STEP4(I4, b, c, d, a, w[9], 0xeb86d391, 21)
+
+  a = _mm_add_epi32(a, init_a);
+  b = _mm_add_epi32(b, init_b);
+  c = _mm_add_epi32(c, init_c);
+  d = _mm_add_epi32(d, init_d);
+
+  uint32_t words[4][4];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(words[0]), a);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(words[1]), b);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(words[2]), c);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(words[3]), d);
+  for (size_t lane = 0; lane < 4; ++lane) {
+    for (size_t i = 0; i < 4; ++i) {
+      memcpy(digests[lane] + 4 * i, &words[i][lane], 4);
+    }
+  }
+}
+
+#endif
+
+} // namespace
+
 namespace cass {
 
+const size_t Md5::MAX_SINGLE_BLOCK_SIZE;
+
 Md5::Md5()
   : lo_(0), hi_(0)
   , a_(0x67452301), b_(0xefcdab89)
@@ -131,6 +289,12 @@ void Md5::final(uint8_t* result) {
 
   body(buffer_, 64);
 
+  digest(result);
+
+  memset(this, 0, sizeof(Md5));
+}
+
+void Md5::digest(uint8_t* result) const {
   result[0]  = a_;
   result[1]  = a_ >> 8;
   result[2]  = a_ >> 16;
@@ -147,8 +311,55 @@ void Md5::final(uint8_t* result) {
   result[13] = d_ >> 8;
   result[14] = d_ >> 16;
   result[15] = d_ >> 24;
+}
 
-  memset(this, 0, sizeof(Md5));
+void Md5::hash(const uint8_t* data, size_t size, uint8_t* result) {
+  Md5 md5;
+  if (size <= MAX_SINGLE_BLOCK_SIZE) {
+    uint8_t block[64];
+    pad_single_block(data, size, block);
+    md5.body(block, 64);
+    md5.digest(result);
+  } else {
+    md5.update(data, size);
+    md5.final(result);
+  }
+}
+
+void Md5::hash_many(const uint8_t* const* data, const size_t* sizes,
+                    size_t count, uint8_t* results) {
+#ifdef CASS_MD5_SSE2
+  // Single block messages are hashed in groups of four. The indices of the
+  // messages waiting for a group are kept in "pending".
+  size_t pending[4];
+  size_t pending_count = 0;
+  uint8_t blocks[4][64];
+
+  for (size_t i = 0; i < count; ++i) {
+    if (sizes[i] > MAX_SINGLE_BLOCK_SIZE) {
+      hash(data[i], sizes[i], results + 16 * i);
+      continue;
+    }
+    pad_single_block(data[i], sizes[i], blocks[pending_count]);
+    pending[pending_count++] = i;
+    if (pending_count == 4) {
+      uint8_t digests[4][16];
+      hash_blocks_sse2(blocks, digests);
+      for (size_t j = 0; j < 4; ++j) {
+        memcpy(results + 16 * pending[j], digests[j], 16);
+      }
+      pending_count = 0;
+    }
+  }
+
+  for (size_t j = 0; j < pending_count; ++j) {
+    hash(data[pending[j]], sizes[pending[j]], results + 16 * pending[j]);
+  }
+#else
+  for (size_t i = 0; i < count; ++i) {
+    hash(data[i], sizes[i], results + 16 * i);
+  }
+#endif
 }
 
 // This processes one or more 64-byte data blocks, but does NOT update
@@ -34,8 +34,22 @@ public:
   void update(const uint8_t* data, size_t size);
   void final(uint8_t* result);
 
+  // Computes the digest of a single message. Messages that fit in a single
+  // block (up to 55 bytes, e.g. most routing keys) are hashed without
+  // buffering.
+  static void hash(const uint8_t* data, size_t size, uint8_t* result);
+
+  // Computes the digests of several messages; "results" receives 16 bytes
+  // per message. On SSE2 capable processors the single block messages are
+  // hashed four at a time using SIMD lanes.
+  static void hash_many(const uint8_t* const* data, const size_t* sizes,
+                        size_t count, uint8_t* results);
+
+  static const size_t MAX_SINGLE_BLOCK_SIZE = 55;
+
 private:
   const uint8_t* body(const uint8_t* data, size_t size);
+  void digest(uint8_t* result) const;
 
 private:
   // Any 32-bit or wider unsigned integer data type will do
@@ -753,16 +753,16 @@ struct ColumnCompare {
 };
 
 const KeyspaceMetadata* Metadata::SchemaSnapshot::get_keyspace(const std::string& name) const {
-  KeyspaceMetadata::Map::const_iterator i = keyspaces_->find(name);
-  if (i == keyspaces_->end()) return NULL;
+  KeyspaceMetadata::Map::const_iterator i = schema_->keyspaces.find(name);
+  if (i == schema_->keyspaces.end()) return NULL;
   return &i->second;
 }
 
 const UserType* Metadata::SchemaSnapshot::get_user_type(const std::string& keyspace_name,
                                                         const std::string& type_name) const
 {
-  KeyspaceMetadata::Map::const_iterator i = keyspaces_->find(keyspace_name);
-  if (i == keyspaces_->end()) {
+  KeyspaceMetadata::Map::const_iterator i = schema_->keyspaces.find(keyspace_name);
+  if (i == schema_->keyspaces.end()) {
     return NULL;
   }
   return i->second.get_user_type(type_name);
@@ -787,12 +787,7 @@ std::string Metadata::full_function_name(const std::string& name, const StringVe
 }
 
 Metadata::SchemaSnapshot Metadata::schema_snapshot(int protocol_version, const VersionNumber& cassandra_version) const {
-  ScopedMutex l(&mutex_);
-  return SchemaSnapshot(schema_snapshot_version_,
-                        protocol_version,
-                        cassandra_version,
-                        front_.keyspaces(),
-                        front_.partitions());
+  return SchemaSnapshot(protocol_version, cassandra_version, published_.load());
 }
 
 void Metadata::update_keyspaces(int protocol_version, const VersionNumber& cassandra_version, ResultResponse* result) {
@@ -801,6 +796,7 @@ void Metadata::update_keyspaces(int protocol_version, const VersionNumber& cassa
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_keyspaces(protocol_version, cassandra_version, result);
+    publish();
   } else {
     updating_->update_keyspaces(protocol_version, cassandra_version, result);
   }
@@ -812,6 +808,7 @@ void Metadata::update_tables(int protocol_version, const VersionNumber& cassandr
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_tables(protocol_version, cassandra_version, result);
+    publish();
   } else {
     updating_->update_tables(protocol_version, cassandra_version, result);
   }
@@ -823,6 +820,7 @@ void Metadata::update_views(int protocol_version, const VersionNumber& cassandra
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_views(protocol_version, cassandra_version, result);
+    publish();
   } else {
     updating_->update_views(protocol_version, cassandra_version, result);
   }
@@ -851,6 +849,7 @@ void Metadata::update_indexes(int protocol_version, const VersionNumber& cassand
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_indexes(protocol_version, cassandra_version, result);
+    publish();
   } else {
     updating_->update_indexes(protocol_version, cassandra_version, result);
   }
@@ -862,6 +861,7 @@ void Metadata::update_user_types(int protocol_version, const VersionNumber& cass
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_user_types(protocol_version, cassandra_version, cache_, result);
+    publish();
   } else {
     updating_->update_user_types(protocol_version, cassandra_version, cache_, result);
   }
@@ -873,6 +873,7 @@ void Metadata::update_functions(int protocol_version, const VersionNumber& cassa
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_functions(protocol_version, cassandra_version, cache_, result);
+    publish();
   } else {
     updating_->update_functions(protocol_version, cassandra_version, cache_, result);
   }
@@ -884,6 +885,7 @@ void Metadata::update_aggregates(int protocol_version, const VersionNumber& cass
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->update_aggregates(protocol_version, cassandra_version, cache_, result);
+    publish();
   } else {
     updating_->update_aggregates(protocol_version, cassandra_version, cache_, result);
   }
@@ -893,6 +895,14 @@ void Metadata::update_partitions(int protocol_version, const VersionNumber& cass
   ScopedMutex l(&mutex_);
   schema_snapshot_version_++;
   updating_->update_partitions(protocol_version, cassandra_version, cache_, result);
+  if (is_front_buffer()) publish();
+}
+
+void Metadata::set_partitions(const TableSplitMetadata::Map& partitions) {
+  ScopedMutex l(&mutex_);
+  schema_snapshot_version_++;
+  updating_->set_partitions(partitions);
+  if (is_front_buffer()) publish();
 }
 
 void Metadata::drop_keyspace(const std::string& keyspace_name) {
@@ -901,6 +911,7 @@ void Metadata::drop_keyspace(const std::string& keyspace_name) {
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->drop_keyspace(keyspace_name);
+    publish();
   } else {
     updating_->drop_keyspace(keyspace_name);
   }
@@ -912,6 +923,7 @@ void Metadata::drop_table_or_view(const std::string& keyspace_name, const std::s
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->drop_table_or_view(keyspace_name, table_or_view_name);
+    publish();
   } else {
     updating_->drop_table_or_view(keyspace_name, table_or_view_name);
   }
@@ -923,6 +935,7 @@ void Metadata::drop_user_type(const std::string& keyspace_name, const std::strin
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->drop_user_type(keyspace_name, type_name);
+    publish();
   } else {
     updating_->drop_user_type(keyspace_name, type_name);
   }
@@ -934,6 +947,7 @@ void Metadata::drop_function(const std::string& keyspace_name, const std::string
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->drop_function(keyspace_name, full_function_name);
+    publish();
   } else {
     updating_->drop_function(keyspace_name, full_function_name);
   }
@@ -945,11 +959,18 @@ void Metadata::drop_aggregate(const std::string& keyspace_name, const std::strin
   if (is_front_buffer()) {
     ScopedMutex l(&mutex_);
     updating_->drop_aggregate(keyspace_name, full_aggregate_name);
+    publish();
   } else {
     updating_->drop_aggregate(keyspace_name, full_aggregate_name);
   }
 }
 
+void Metadata::publish() {
+  published_.store(PublishedSchema::Ptr(new PublishedSchema(schema_snapshot_version_,
+                                                            front_.keyspaces(),
+                                                            front_.partitions())));
+}
+
 void Metadata::clear_and_update_back(const VersionNumber& cassandra_version) {
   back_.clear();
   updating_ = &back_;
@@ -960,6 +981,7 @@ void Metadata::swap_to_back_and_update_front() {
     ScopedMutex l(&mutex_);
     schema_snapshot_version_++;
     front_.swap(back_);
+    publish();
   }
   back_.clear();
   updating_ = &front_;
@@ -970,6 +992,7 @@ void Metadata::clear() {
     ScopedMutex l(&mutex_);
     schema_snapshot_version_ = 0;
     front_.clear();
+    publish();
   }
   back_.clear();
 }
@@ -1098,28 +1121,28 @@ const Value* MetadataBase::add_json_map_field(int protocol_version, const Row* r
 }
 
 const TableMetadata* KeyspaceMetadata::get_table(const std::string& name) const {
-  TableMetadata::Map::const_iterator i = tables_->find(name);
-  if (i == tables_->end()) return NULL;
+  TableMetadata::Map::const_iterator i = tables_.find(name);
+  if (i == tables_.end()) return NULL;
   return i->second.get();
 }
 
 const TableMetadata::Ptr& KeyspaceMetadata::get_table(const std::string& name) {
-  TableMetadata::Map::iterator i = tables_->find(name);
-  if (i == tables_->end()) return TableMetadata::NIL;
+  TableMetadata::Map::const_iterator i = tables_.find(name);
+  if (i == tables_.end()) return TableMetadata::NIL;
   return i->second;
 }
 
 void KeyspaceMetadata::add_table(const TableMetadata::Ptr& table) {
-  TableMetadata::Map::iterator table_it = tables_->find(table->name());
+  TableMetadata::Map::const_iterator table_it = tables_.find(table->name());
 
   // If there's a previous version of this table then copy its views
   // to the new version of the table, and update the table back-refs
   // in the views.
-  if (table_it != tables_->end()) {
+  if (table_it != tables_.end()) {
     TableMetadata::Ptr old_table(table_it->second);
     internal_add_table(table, old_table->views());
   } else {
-    (*tables_)[table->name()] = table; // Add new table
+    tables_[table->name()] = table; // Add new table
   }
 }
 
@@ -1130,34 +1153,34 @@ void KeyspaceMetadata::internal_add_table(const TableMetadata::Ptr& table,
         i != views.end(); ++i) {
     ViewMetadata::Ptr view(new ViewMetadata(**i, table.get()));
     table->add_view(view);
-    (*views_)[view->name()] = view;
+    views_[view->name()] = view;
   }
-  (*tables_)[table->name()] = table;
+  tables_[table->name()] = table;
 }
 
 
 
 const ViewMetadata* KeyspaceMetadata::get_view(const std::string& name) const {
-  ViewMetadata::Map::const_iterator i = views_->find(name);
-  if (i == views_->end()) return NULL;
+  ViewMetadata::Map::const_iterator i = views_.find(name);
+  if (i == views_.end()) return NULL;
   return i->second.get();
 }
 
 const ViewMetadata::Ptr& KeyspaceMetadata::get_view(const std::string& name) {
-  ViewMetadata::Map::iterator i = views_->find(name);
-  if (i == views_->end()) return ViewMetadata::NIL;
+  ViewMetadata::Map::const_iterator i = views_.find(name);
+  if (i == views_.end()) return ViewMetadata::NIL;
   return i->second;
 }
 
 void KeyspaceMetadata::add_view(const ViewMetadata::Ptr& view) {
   // Properly remove the previous view if it exists
   drop_table_or_view(view->name());
-  (*views_)[view->name()] = view;
+  views_[view->name()] = view;
 }
 
 void KeyspaceMetadata::drop_table_or_view(const std::string& table_or_view_name) {
-  TableMetadata::Map::iterator table_it = tables_->find(table_or_view_name);
-  if (table_it != tables_->end()) { // The name is for a table, remove the
+  TableMetadata::Map::const_iterator table_it = tables_.find(table_or_view_name);
+  if (table_it != tables_.end()) { // The name is for a table, remove the
                                     // table and views from keyspace
     TableMetadata::Ptr table(table_it->second);
     // Cassandra doesn't allow for tables to be dropped while it has active
@@ -1165,12 +1188,12 @@ void KeyspaceMetadata::drop_table_or_view(const std::string& table_or_view_name)
     // order.
     for (ViewMetadata::Vec::const_iterator i = table->views().begin(),
          end = table->views().end(); i != end; ++i) {
-      views_->erase((*i)->name());
+      views_.erase((*i)->name());
     }
-    tables_->erase(table_it);
+    tables_.erase(table_or_view_name);
   } else { // The name is for a view, remove the view from the table and keyspace
-    ViewMetadata::Map::iterator view_it = views_->find(table_or_view_name);
-    if (view_it != views_->end()) {
+    ViewMetadata::Map::const_iterator view_it = views_.find(table_or_view_name);
+    if (view_it != views_.end()) {
       ViewMetadata::Ptr view(view_it->second);
 
       // Remove view from the base table's views
@@ -1185,24 +1208,23 @@ void KeyspaceMetadata::drop_table_or_view(const std::string& table_or_view_name)
       internal_add_table(table, views);
 
       // Remove the dropped view
-      views_->erase(view_it);
+      views_.erase(table_or_view_name);
     }
   }
 }
 
 const UserType::Ptr& KeyspaceMetadata::get_or_create_user_type(const std::string& name, bool is_frozen) {
-  UserType::Map::iterator i = user_types_->find(name);
-  if (i == user_types_->end()) {
-    i = user_types_->insert(std::make_pair(name,
-                                           UserType::Ptr(new UserType(MetadataBase::name(), name,
-                                                                      is_frozen)))).first;
+  UserType::Ptr* user_type = user_types_.find_mutable(name);
+  if (user_type == NULL) {
+    user_type = &user_types_[name];
+    *user_type = UserType::Ptr(new UserType(MetadataBase::name(), name, is_frozen));
   }
-  return i->second;
+  return *user_type;
 }
 
 const UserType* KeyspaceMetadata::get_user_type(const std::string& name) const {
-  UserType::Map::const_iterator i = user_types_->find(name);
-  if (i == user_types_->end()) return NULL;
+  UserType::Map::const_iterator i = user_types_.find(name);
+  if (i == user_types_.end()) return NULL;
   return i->second.get();
 }
 
@@ -1239,35 +1261,35 @@ void KeyspaceMetadata::update(int protocol_version, const VersionNumber& cassand
 }
 
 void KeyspaceMetadata::drop_user_type(const std::string& type_name) {
-  user_types_->erase(type_name);
+  user_types_.erase(type_name);
 }
 
 void KeyspaceMetadata::add_function(const FunctionMetadata::Ptr& function) {
-  (*functions_)[function->name()] = function;
+  functions_[function->name()] = function;
 }
 
 const FunctionMetadata* KeyspaceMetadata::get_function(const std::string& full_function_name) const {
-  FunctionMetadata::Map::const_iterator i = functions_->find(full_function_name);
-  if (i == functions_->end()) return NULL;
+  FunctionMetadata::Map::const_iterator i = functions_.find(full_function_name);
+  if (i == functions_.end()) return NULL;
   return i->second.get();
 }
 
 void KeyspaceMetadata::drop_function(const std::string& full_function_name) {
-  functions_->erase(full_function_name);
+  functions_.erase(full_function_name);
 }
 
 const AggregateMetadata* KeyspaceMetadata::get_aggregate(const std::string& full_aggregate_name) const {
-  AggregateMetadata::Map::const_iterator i = aggregates_->find(full_aggregate_name);
-  if (i == aggregates_->end()) return NULL;
+  AggregateMetadata::Map::const_iterator i = aggregates_.find(full_aggregate_name);
+  if (i == aggregates_.end()) return NULL;
   return i->second.get();
 }
 
 void KeyspaceMetadata::add_aggregate(const AggregateMetadata::Ptr& aggregate) {
-  (*aggregates_)[aggregate->name()] = aggregate;
+  aggregates_[aggregate->name()] = aggregate;
 }
 
 void KeyspaceMetadata::drop_aggregate(const std::string& full_aggregate_name) {
-  aggregates_->erase(full_aggregate_name);
+  aggregates_.erase(full_aggregate_name);
 }
 
 TableMetadataBase::TableMetadataBase(int protocol_version, const VersionNumber& cassandra_version,
@@ -2253,32 +2275,32 @@ void Metadata::InternalData::update_partitions(int protocol_version, const Versi
 }
 
 void Metadata::InternalData::drop_keyspace(const std::string& keyspace_name) {
-  keyspaces_->erase(keyspace_name);
+  keyspaces_.erase(keyspace_name);
 }
 
 void Metadata::InternalData::drop_table_or_view(const std::string& keyspace_name,
                                                 const std::string& table_or_view_name) {
-  KeyspaceMetadata::Map::iterator i = keyspaces_->find(keyspace_name);
-  if (i == keyspaces_->end()) return;
-  i->second.drop_table_or_view(table_or_view_name);
+  KeyspaceMetadata* keyspace = keyspaces_.find_mutable(keyspace_name);
+  if (keyspace == NULL) return;
+  keyspace->drop_table_or_view(table_or_view_name);
 }
 
 void Metadata::InternalData::drop_user_type(const std::string& keyspace_name, const std::string& type_name) {
-  KeyspaceMetadata::Map::iterator i = keyspaces_->find(keyspace_name);
-  if (i == keyspaces_->end()) return;
-  i->second.drop_user_type(type_name);
+  KeyspaceMetadata* keyspace = keyspaces_.find_mutable(keyspace_name);
+  if (keyspace == NULL) return;
+  keyspace->drop_user_type(type_name);
 }
 
 void Metadata::InternalData::drop_function(const std::string& keyspace_name, const std::string& full_function_name) {
-  KeyspaceMetadata::Map::iterator i = keyspaces_->find(keyspace_name);
-  if (i == keyspaces_->end()) return;
-  i->second.drop_function(full_function_name);
+  KeyspaceMetadata* keyspace = keyspaces_.find_mutable(keyspace_name);
+  if (keyspace == NULL) return;
+  keyspace->drop_function(full_function_name);
 }
 
 void Metadata::InternalData::drop_aggregate(const std::string& keyspace_name, const std::string& full_aggregate_name) {
-  KeyspaceMetadata::Map::iterator i = keyspaces_->find(keyspace_name);
-  if (i == keyspaces_->end()) return;
-  i->second.drop_aggregate(full_aggregate_name);
+  KeyspaceMetadata* keyspace = keyspaces_.find_mutable(keyspace_name);
+  if (keyspace == NULL) return;
+  keyspace->drop_aggregate(full_aggregate_name);
 }
 
 void Metadata::InternalData::update_columns(int protocol_version, const VersionNumber& cassandra_version, SimpleDataTypeCache& cache, ResultResponse* result) {
@@ -2434,11 +2456,12 @@ void Metadata::InternalData::update_indexes(int protocol_version, const VersionN
 }
 
 KeyspaceMetadata* Metadata::InternalData::get_or_create_keyspace(const std::string& name) {
-  KeyspaceMetadata::Map::iterator i = keyspaces_->find(name);
-  if (i == keyspaces_->end()) {
-    i = keyspaces_->insert(std::make_pair(name, KeyspaceMetadata(name))).first;
+  KeyspaceMetadata* keyspace = keyspaces_.find_mutable(name);
+  if (keyspace == NULL) {
+    keyspaces_.insert(name, KeyspaceMetadata(name));
+    keyspace = keyspaces_.find_mutable(name);
   }
-  return &i->second;
+  return keyspace;
 }
 
 } // namespace cass
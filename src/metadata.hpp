@@ -18,10 +18,12 @@
 #define __CASS_SCHEMA_METADATA_HPP_INCLUDED__
 
 #include "copy_on_write_ptr.hpp"
+#include "epoch_ptr.hpp"
 #include "external.hpp"
 #include "host.hpp"
 #include "iterator.hpp"
 #include "macros.hpp"
+#include "persistent_map.hpp"
 #include "ref_counted.hpp"
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
@@ -42,11 +44,11 @@ class KeyspaceMetadata;
 class Row;
 class ResultResponse;
 
-template<class T>
+template<class T, class C = std::map<std::string, T> >
 class MapIteratorImpl {
 public:
   typedef T ItemType;
-  typedef std::map<std::string, T> Collection;
+  typedef C Collection;
 
   MapIteratorImpl(const Collection& map)
     : next_(map.begin())
@@ -188,7 +190,7 @@ protected:
 class FunctionMetadata : public MetadataBase, public RefCounted<FunctionMetadata> {
 public:
   typedef SharedRefPtr<FunctionMetadata> Ptr;
-  typedef std::map<std::string, Ptr> Map;
+  typedef PersistentMap<std::string, Ptr> Map;
   typedef std::vector<Ptr> Vec;
 
   struct Argument {
@@ -231,7 +233,7 @@ inline bool operator==(const FunctionMetadata::Argument& a, StringRef b) {
 class AggregateMetadata : public MetadataBase, public RefCounted<AggregateMetadata> {
 public:
   typedef SharedRefPtr<AggregateMetadata> Ptr;
-  typedef std::map<std::string, Ptr> Map;
+  typedef PersistentMap<std::string, Ptr> Map;
   typedef std::vector<Ptr> Vec;
 
   AggregateMetadata(int protocol_version, const VersionNumber& cassandra_version, SimpleDataTypeCache& cache,
@@ -389,7 +391,7 @@ protected:
 class ViewMetadata : public TableMetadataBase {
 public:
   typedef SharedRefPtr<ViewMetadata> Ptr;
-  typedef std::map<std::string, Ptr> Map;
+  typedef PersistentMap<std::string, Ptr> Map;
   typedef std::vector<Ptr> Vec;
 
   static const ViewMetadata::Ptr NIL;
@@ -445,7 +447,7 @@ public:
   virtual bool next() { return impl_.next(); }
 
 private:
-  MapIteratorImpl<ViewMetadata::Ptr> impl_;
+  MapIteratorImpl<ViewMetadata::Ptr, ViewMetadata::Map> impl_;
 };
 
 inline bool operator<(const ViewMetadata::Ptr& a, const ViewMetadata::Ptr& b) {
@@ -463,7 +465,7 @@ inline bool operator==(const ViewMetadata::Ptr& a, const ViewMetadata::Ptr& b) {
 class TableMetadata : public TableMetadataBase {
 public:
   typedef SharedRefPtr<TableMetadata> Ptr;
-  typedef std::map<std::string, Ptr> Map;
+  typedef PersistentMap<std::string, Ptr> Map;
   typedef std::vector<Ptr> Vec;
   typedef std::vector<std::string> KeyAliases;
 
@@ -508,74 +510,68 @@ private:
 
 class KeyspaceMetadata : public MetadataBase {
 public:
-  typedef std::map<std::string, KeyspaceMetadata> Map;
-  typedef CopyOnWritePtr<KeyspaceMetadata::Map> MapPtr;
+  typedef PersistentMap<std::string, KeyspaceMetadata> Map;
 
-  class TableIterator : public MetadataIteratorImpl<MapIteratorImpl<TableMetadata::Ptr> > {
+  class TableIterator : public MetadataIteratorImpl<MapIteratorImpl<TableMetadata::Ptr, TableMetadata::Map> > {
   public:
    TableIterator(const TableIterator::Collection& collection)
-     : MetadataIteratorImpl<MapIteratorImpl<TableMetadata::Ptr> >(CASS_ITERATOR_TYPE_TABLE_META, collection) { }
+     : MetadataIteratorImpl<MapIteratorImpl<TableMetadata::Ptr, TableMetadata::Map> >(CASS_ITERATOR_TYPE_TABLE_META, collection) { }
     const TableMetadata* table() const { return static_cast<TableMetadata*>(impl_.item().get()); }
   };
 
-  class TypeIterator : public MetadataIteratorImpl<MapIteratorImpl<UserType::Ptr> > {
+  class TypeIterator : public MetadataIteratorImpl<MapIteratorImpl<UserType::Ptr, UserType::Map> > {
   public:
    TypeIterator(const TypeIterator::Collection& collection)
-     : MetadataIteratorImpl<MapIteratorImpl<UserType::Ptr> >(CASS_ITERATOR_TYPE_TYPE_META, collection) { }
+     : MetadataIteratorImpl<MapIteratorImpl<UserType::Ptr, UserType::Map> >(CASS_ITERATOR_TYPE_TYPE_META, collection) { }
     const UserType* type() const { return impl_.item().get(); }
   };
 
-  class FunctionIterator : public MetadataIteratorImpl<MapIteratorImpl<FunctionMetadata::Ptr> > {
+  class FunctionIterator : public MetadataIteratorImpl<MapIteratorImpl<FunctionMetadata::Ptr, FunctionMetadata::Map> > {
   public:
    FunctionIterator(const FunctionIterator::Collection& collection)
-     : MetadataIteratorImpl<MapIteratorImpl<FunctionMetadata::Ptr> >(CASS_ITERATOR_TYPE_FUNCTION_META, collection) { }
+     : MetadataIteratorImpl<MapIteratorImpl<FunctionMetadata::Ptr, FunctionMetadata::Map> >(CASS_ITERATOR_TYPE_FUNCTION_META, collection) { }
     const FunctionMetadata* function() const { return impl_.item().get(); }
   };
 
-  class AggregateIterator : public MetadataIteratorImpl<MapIteratorImpl<AggregateMetadata::Ptr> > {
+  class AggregateIterator : public MetadataIteratorImpl<MapIteratorImpl<AggregateMetadata::Ptr, AggregateMetadata::Map> > {
   public:
    AggregateIterator(const AggregateIterator::Collection& collection)
-     : MetadataIteratorImpl<MapIteratorImpl<AggregateMetadata::Ptr> >(CASS_ITERATOR_TYPE_AGGREGATE_META, collection) { }
+     : MetadataIteratorImpl<MapIteratorImpl<AggregateMetadata::Ptr, AggregateMetadata::Map> >(CASS_ITERATOR_TYPE_AGGREGATE_META, collection) { }
     const AggregateMetadata* aggregate() const { return impl_.item().get(); }
   };
 
   KeyspaceMetadata(const std::string& name)
-    : MetadataBase(name)
-    , tables_(new TableMetadata::Map)
-    , views_(new ViewMetadata::Map)
-    , user_types_(new UserType::Map)
-    , functions_(new FunctionMetadata::Map)
-    , aggregates_(new AggregateMetadata::Map) { }
+    : MetadataBase(name) { }
 
   void update(int protocol_version, const VersionNumber& cassandra_version,
               const RefBuffer::Ptr& buffer, const Row* row);
 
-  const FunctionMetadata::Map& functions() const { return *functions_; }
-  const UserType::Map& user_types() const { return *user_types_; }
+  const FunctionMetadata::Map& functions() const { return functions_; }
+  const UserType::Map& user_types() const { return user_types_; }
 
-  Iterator* iterator_tables() const { return new TableIterator(*tables_); }
+  Iterator* iterator_tables() const { return new TableIterator(tables_); }
   const TableMetadata* get_table(const std::string& name) const;
   const TableMetadata::Ptr& get_table(const std::string& name);
   void add_table(const TableMetadata::Ptr& table);
 
-  Iterator* iterator_views() const { return new ViewIteratorMap(*views_); }
+  Iterator* iterator_views() const { return new ViewIteratorMap(views_); }
   const ViewMetadata* get_view(const std::string& name) const;
   const ViewMetadata::Ptr& get_view(const std::string& name);
   void add_view(const ViewMetadata::Ptr& view);
 
   void drop_table_or_view(const std::string& table_name);
 
-  Iterator* iterator_user_types() const { return new TypeIterator(*user_types_); }
+  Iterator* iterator_user_types() const { return new TypeIterator(user_types_); }
   const UserType* get_user_type(const std::string& type_name) const;
   const UserType::Ptr& get_or_create_user_type(const std::string& name, bool is_frozen);
   void drop_user_type(const std::string& type_name);
 
-  Iterator* iterator_functions() const { return new FunctionIterator(*functions_); }
+  Iterator* iterator_functions() const { return new FunctionIterator(functions_); }
   const FunctionMetadata* get_function(const std::string& full_function_name) const;
   void add_function(const FunctionMetadata::Ptr& function);
   void drop_function(const std::string& full_function_name);
 
-  Iterator* iterator_aggregates() const { return new AggregateIterator(*aggregates_); }
+  Iterator* iterator_aggregates() const { return new AggregateIterator(aggregates_); }
   const AggregateMetadata* get_aggregate(const std::string& full_aggregate_name) const;
   void add_aggregate(const AggregateMetadata::Ptr& aggregate);
   void drop_aggregate(const std::string& full_aggregate_name);
@@ -591,11 +587,13 @@ private:
   StringRef strategy_class_;
   Value strategy_options_;
 
-  CopyOnWritePtr<TableMetadata::Map> tables_;
-  CopyOnWritePtr<ViewMetadata::Map> views_;
-  CopyOnWritePtr<UserType::Map> user_types_;
-  CopyOnWritePtr<FunctionMetadata::Map> functions_;
-  CopyOnWritePtr<AggregateMetadata::Map> aggregates_;
+  // Persistent maps so that copying a keyspace (e.g. when a schema snapshot
+  // shares it) is cheap and updates only copy the path to the changed entry.
+  TableMetadata::Map tables_;
+  ViewMetadata::Map views_;
+  UserType::Map user_types_;
+  FunctionMetadata::Map functions_;
+  AggregateMetadata::Map aggregates_;
 };
 
 // The metadata for one table partition. It maintains the partition's range (start and end key)
@@ -676,6 +674,8 @@ public:
     return partition == nullptr ? nullptr : &partition->host_ips_;
   }
 
+  const std::vector<PartitionMetadata>& partitions() const { return partitions_; }
+
   std::string to_string() const {
     std::string str;
     for (const PartitionMetadata& partition : partitions_) {
@@ -692,44 +692,55 @@ private:
 
 class Metadata {
 public:
-  class KeyspaceIterator : public MetadataIteratorImpl<MapIteratorImpl<KeyspaceMetadata> > {
+  class KeyspaceIterator : public MetadataIteratorImpl<MapIteratorImpl<KeyspaceMetadata, KeyspaceMetadata::Map> > {
   public:
   KeyspaceIterator(const KeyspaceIterator::Collection& collection)
-    : MetadataIteratorImpl<MapIteratorImpl<KeyspaceMetadata> >(CASS_ITERATOR_TYPE_KEYSPACE_META, collection) { }
+    : MetadataIteratorImpl<MapIteratorImpl<KeyspaceMetadata, KeyspaceMetadata::Map> >(CASS_ITERATOR_TYPE_KEYSPACE_META, collection) { }
     const KeyspaceMetadata* keyspace() const { return &impl_.item(); }
   };
 
+  // An immutable version of the front buffer that's published to snapshots
+  class PublishedSchema : public RefCounted<PublishedSchema> {
+  public:
+    typedef SharedRefPtr<PublishedSchema> Ptr;
+
+    PublishedSchema(uint32_t version,
+                    const KeyspaceMetadata::Map& keyspaces,
+                    const TableSplitMetadata::MapPtr& partitions)
+      : version(version)
+      , keyspaces(keyspaces)
+      , partitions(partitions) { }
+
+    const uint32_t version;
+    const KeyspaceMetadata::Map keyspaces;
+    const TableSplitMetadata::MapPtr partitions;
+  };
+
   class SchemaSnapshot {
   public:
-    SchemaSnapshot(uint32_t version,
-                   int protocol_version,
+    SchemaSnapshot(int protocol_version,
                    const VersionNumber& cassandra_version,
-                   const KeyspaceMetadata::MapPtr& keyspaces,
-                   const TableSplitMetadata::MapPtr& partitions)
-      : version_(version)
-      , protocol_version_(protocol_version)
+                   const PublishedSchema::Ptr& schema)
+      : protocol_version_(protocol_version)
       , cassandra_version_(cassandra_version)
-      , keyspaces_(keyspaces)
-      , partitions_(partitions) { }
+      , schema_(schema) { }
 
-    uint32_t version() const { return version_; }
+    uint32_t version() const { return schema_->version; }
     int protocol_version() const { return protocol_version_; }
     VersionNumber cassandra_version() const { return cassandra_version_; }
 
     const KeyspaceMetadata* get_keyspace(const std::string& name) const;
-    Iterator* iterator_keyspaces() const { return new KeyspaceIterator(*keyspaces_); }
+    Iterator* iterator_keyspaces() const { return new KeyspaceIterator(schema_->keyspaces); }
 
     const UserType* get_user_type(const std::string& keyspace_name,
                                   const std::string& type_name) const;
 
-    const TableSplitMetadata::MapPtr& get_partitions() const { return partitions_; }
+    const TableSplitMetadata::MapPtr& get_partitions() const { return schema_->partitions; }
 
   private:
-    uint32_t version_;
     int protocol_version_;
     VersionNumber cassandra_version_;
-    KeyspaceMetadata::MapPtr keyspaces_;
-    TableSplitMetadata::MapPtr partitions_;
+    PublishedSchema::Ptr schema_;
   };
 
   static std::string full_function_name(const std::string& name, const StringVec& signature);
@@ -737,7 +748,9 @@ public:
 public:
   Metadata()
     : updating_(&front_)
-    , schema_snapshot_version_(0) {
+    , schema_snapshot_version_(0)
+    , published_(PublishedSchema::Ptr(
+                   new PublishedSchema(0, front_.keyspaces(), front_.partitions()))) {
     uv_mutex_init(&mutex_);
   }
 
@@ -757,6 +770,10 @@ public:
   void update_aggregates(int protocol_version, const VersionNumber& cassandra_version, ResultResponse* result);
   void update_partitions(int protocol_version, const VersionNumber& cassandra_version, ResultResponse* result);
 
+  // Replaces the partition map, e.g. with a partition map loaded from the
+  // topology cache before the control connection has queried it.
+  void set_partitions(const TableSplitMetadata::Map& partitions);
+
   void drop_keyspace(const std::string& keyspace_name);
   void drop_table_or_view(const std::string& keyspace_name, const std::string& table_or_view_name);
   void drop_user_type(const std::string& keyspace_name, const std::string& type_name);
@@ -776,14 +793,17 @@ public:
 private:
   bool is_front_buffer() const { return updating_ == &front_; }
 
+  // Publishes the front buffer to new snapshots. This must be called with
+  // the mutex held.
+  void publish();
+
 private:
   class InternalData {
   public:
     InternalData()
-      : keyspaces_(new KeyspaceMetadata::Map()),
-        partitions_(new TableSplitMetadata::Map()) { }
+      : partitions_(new TableSplitMetadata::Map()) { }
 
-    const KeyspaceMetadata::MapPtr& keyspaces() const { return keyspaces_; }
+    const KeyspaceMetadata::Map& keyspaces() const { return keyspaces_; }
     const TableSplitMetadata::MapPtr& partitions() const { return partitions_; }
 
     void update_keyspaces(int protocol_version, const VersionNumber& cassandra_version, ResultResponse* result);
@@ -803,11 +823,14 @@ private:
     void drop_function(const std::string& keyspace_name, const std::string& full_function_name);
     void drop_aggregate(const std::string& keyspace_name, const std::string& full_aggregate_name);
     void drop_partitions() { partitions_->clear(); }
+    void set_partitions(const TableSplitMetadata::Map& partitions) {
+      partitions_ = TableSplitMetadata::MapPtr(new TableSplitMetadata::Map(partitions));
+    }
 
-    void clear() { keyspaces_->clear(); partitions_->clear(); }
+    void clear() { keyspaces_.clear(); partitions_->clear(); }
 
     void swap(InternalData& other) {
-      CopyOnWritePtr<KeyspaceMetadata::Map> temp_ks = other.keyspaces_;
+      KeyspaceMetadata::Map temp_ks = other.keyspaces_;
       other.keyspaces_ = keyspaces_;
       keyspaces_ = temp_ks;
 
@@ -820,7 +843,7 @@ private:
     KeyspaceMetadata* get_or_create_keyspace(const std::string& name);
 
   private:
-    CopyOnWritePtr<KeyspaceMetadata::Map> keyspaces_;
+    KeyspaceMetadata::Map keyspaces_;
     CopyOnWritePtr<TableSplitMetadata::Map> partitions_;
 
   private:
@@ -833,7 +856,11 @@ private:
 
   uint32_t schema_snapshot_version_;
 
-  // This lock prevents partial snapshots when updating metadata
+  // Snapshots load the published schema without taking the mutex
+  EpochPtr<PublishedSchema> published_;
+
+  // This lock serializes the updates to the front buffer and their
+  // publication
   mutable uv_mutex_t mutex_;
 
   // Only used internally on a single thread, there's
@@ -101,6 +101,10 @@ public:
       counters_[thread_state_->current_thread_id()].add(1LL);
     }
 
+    void add(int64_t n) {
+      counters_[thread_state_->current_thread_id()].add(n);
+    }
+
     void dec() {
       counters_[thread_state_->current_thread_id()].sub(1LL);
     }
@@ -281,10 +285,15 @@ public:
       int64_t percentile_999th;
     };
 
-    Histogram(ThreadState* thread_state)
+    Histogram(ThreadState* thread_state,
+              int64_t highest_trackable_value = HIGHEST_TRACKABLE_VALUE,
+              int significant_figures = 3)
       : thread_state_(thread_state)
       , histograms_(new PerThreadHistogram[thread_state->max_threads()]) {
-      hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histogram_);
+      for (size_t i = 0; i < thread_state->max_threads(); ++i) {
+        histograms_[i].init(highest_trackable_value, significant_figures);
+      }
+      hdr_init(1LL, highest_trackable_value, significant_figures, &histogram_);
       uv_mutex_init(&mutex_);
     }
 
@@ -323,14 +332,17 @@ public:
 #if UV_VERSION_MAJOR == 0
     class PerThreadHistogram {
     public:
-      PerThreadHistogram() {
-        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histogram_);
-      }
+      PerThreadHistogram()
+        : histogram_(NULL) { }
 
       ~PerThreadHistogram() {
         free(histogram_);
       }
 
+      void init(int64_t highest_trackable_value, int significant_figures) {
+        hdr_init(1LL, highest_trackable_value, significant_figures, &histogram_);
+      }
+
       void record_value(int64_t value) {
         hdr_record_value(histogram_, value);
 
@@ -406,8 +418,7 @@ public:
     public:
       PerThreadHistogram()
         : active_index_(0) {
-        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histograms_[0]);
-        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histograms_[1]);
+        histograms_[0] = histograms_[1] = NULL;
       }
 
       ~PerThreadHistogram() {
@@ -415,6 +426,11 @@ public:
         free(histograms_[1]);
       }
 
+      void init(int64_t highest_trackable_value, int significant_figures) {
+        hdr_init(1LL, highest_trackable_value, significant_figures, &histograms_[0]);
+        hdr_init(1LL, highest_trackable_value, significant_figures, &histograms_[1]);
+      }
+
       void record_value(int64_t value) {
         int64_t critical_value_enter = phaser_.writer_critical_section_enter();
         hdr_histogram* h = histograms_[active_index_.load()];
@@ -466,7 +482,9 @@ public:
     , total_connections(&thread_state_)
     , connection_timeouts(&thread_state_)
     , pending_request_timeouts(&thread_state_)
-    , request_timeouts(&thread_state_) {}
+    , request_timeouts(&thread_state_)
+    , retries_allowed(&thread_state_)
+    , retries_denied(&thread_state_) {}
 
   void record_request(uint64_t latency_ns) {
     // Final measurement is in microseconds
@@ -487,6 +505,9 @@ public:
   Counter pending_request_timeouts;
   Counter request_timeouts;
 
+  Counter retries_allowed;
+  Counter retries_denied;
+
 private:
   DISALLOW_COPY_AND_ASSIGN(Metrics);
 };
@@ -0,0 +1,117 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "page_sizer.hpp"
+
+#include <algorithm>
+
+// The weight of the latest page in the bytes per row average
+#define PAGE_SIZER_SMOOTHING 0.5
+
+namespace cass {
+
+uint64_t PagingBudget::reserve(uint64_t requested, uint64_t minimum) {
+  uint64_t in_use = in_use_.load();
+  while (true) {
+    uint64_t available = in_use < limit_ ? limit_ - in_use : 0;
+    uint64_t granted = std::max(std::min(requested, available), minimum);
+    if (in_use_.compare_exchange_strong(in_use, in_use + granted)) {
+      return granted;
+    }
+  }
+}
+
+void PagingReservation::reserve(const PagingBudget::Ptr& budget,
+                                uint64_t requested, uint64_t minimum) {
+  release();
+  budget_ = budget;
+  reserved_ = budget->reserve(requested, minimum);
+}
+
+void PagingReservation::take(PagingReservation* other) {
+  release();
+  budget_ = other->budget_;
+  reserved_ = other->reserved_;
+  other->budget_.reset();
+  other->reserved_ = 0;
+}
+
+void PagingReservation::release() {
+  if (reserved_ > 0) {
+    budget_->release(reserved_);
+    reserved_ = 0;
+  }
+}
+
+PageSizer::PageSizer(const Settings& settings, int32_t initial_page_size)
+  : settings_(settings)
+  , page_size_(0)
+  , bytes_per_row_(0.0)
+  , has_rows_(false) {
+  page_size_ = clamp(initial_page_size);
+  // Nothing is known about the rows yet so the first page is expected to be
+  // as large as the target
+  bytes_per_row_ = std::max(static_cast<double>(settings_.target_page_bytes) / page_size_, 1.0);
+}
+
+int32_t PageSizer::reserve(const PagingBudget::Ptr& budget,
+                           PagingReservation* reservation) const {
+  uint64_t requested = expected_bytes(page_size_);
+  uint64_t minimum = std::min(requested, expected_bytes(settings_.min_page_size));
+  reservation->reserve(budget, requested, minimum);
+  if (reservation->reserved() < requested) {
+    return clamp(static_cast<double>(page_size_) * reservation->reserved() / requested);
+  }
+  return page_size_;
+}
+
+void PageSizer::update(int32_t row_count, size_t page_bytes, uint64_t latency_ns) {
+  if (row_count <= 0) return;
+
+  // The size isn't known for cached results
+  if (page_bytes > 0) {
+    double bytes_per_row = static_cast<double>(page_bytes) / row_count;
+    if (has_rows_) {
+      bytes_per_row_ = PAGE_SIZER_SMOOTHING * bytes_per_row +
+                       (1.0 - PAGE_SIZER_SMOOTHING) * bytes_per_row_;
+    } else {
+      bytes_per_row_ = bytes_per_row;
+      has_rows_ = true;
+    }
+  }
+
+  double next = settings_.target_page_bytes / std::max(bytes_per_row_, 1.0);
+  if (settings_.target_latency_ns > 0 && latency_ns > 0) {
+    double rows_within_latency =
+        static_cast<double>(row_count) * settings_.target_latency_ns / latency_ns;
+    next = std::min(next, rows_within_latency);
+  }
+  next = std::min(next, 2.0 * page_size_);
+
+  page_size_ = clamp(next);
+}
+
+int32_t PageSizer::clamp(double page_size) const {
+  if (page_size < settings_.min_page_size) return settings_.min_page_size;
+  if (page_size > settings_.max_page_size) return settings_.max_page_size;
+  return static_cast<int32_t>(page_size);
+}
+
+uint64_t PageSizer::expected_bytes(int32_t page_size) const {
+  return static_cast<uint64_t>(bytes_per_row_ * page_size) + 1;
+}
+
+} // namespace cass
@@ -0,0 +1,140 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_PAGE_SIZER_HPP_INCLUDED__
+#define __CASS_PAGE_SIZER_HPP_INCLUDED__
+
+#include "atomic.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace cass {
+
+// A session-wide limit on the bytes of the pages requested by adaptive
+// paging statements that haven't been consumed yet.
+class PagingBudget : public RefCounted<PagingBudget> {
+public:
+  typedef SharedRefPtr<PagingBudget> Ptr;
+
+  PagingBudget(uint64_t limit)
+    : limit_(limit)
+    , in_use_(0) { }
+
+  // Reserves up to "requested" bytes. At least "minimum" bytes are reserved,
+  // even over the limit, so that scans always make progress.
+  uint64_t reserve(uint64_t requested, uint64_t minimum);
+
+  void release(uint64_t bytes) { in_use_.fetch_sub(bytes); }
+
+  uint64_t limit() const { return limit_; }
+  uint64_t in_use() const { return in_use_.load(); }
+
+private:
+  const uint64_t limit_;
+  Atomic<uint64_t> in_use_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PagingBudget);
+};
+
+// The bytes reserved from a paging budget for a single execution of a
+// statement. It's released once the execution's page is received (or the
+// execution fails) and when it's destroyed.
+class PagingReservation {
+public:
+  PagingReservation()
+    : reserved_(0) { }
+
+  ~PagingReservation() { release(); }
+
+  uint64_t reserved() const { return reserved_; }
+
+  void reserve(const PagingBudget::Ptr& budget, uint64_t requested, uint64_t minimum);
+
+  // Takes over another reservation, which is left empty
+  void take(PagingReservation* other);
+
+  void release();
+
+private:
+  PagingBudget::Ptr budget_;
+  uint64_t reserved_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PagingReservation);
+};
+
+// Adjusts a statement's page size between pages. The next page size is the
+// number of rows expected to fill the target page size in bytes, using the
+// observed (smoothed) bytes per row, further limited by the number of rows
+// expected to be received within the target latency. The page size at most
+// doubles from one page to the next so that a few narrow rows don't lead to
+// a huge page.
+//
+// The page sizer is updated by the application thread that sets the
+// statement's paging state. Executions only read it and keep their own
+// budget reservation and page size.
+class PageSizer {
+public:
+  struct Settings {
+    Settings()
+      : target_page_bytes(0)
+      , target_latency_ns(0)
+      , min_page_size(1)
+      , max_page_size(1) { }
+
+    uint64_t target_page_bytes;
+    uint64_t target_latency_ns; // 0 if there's no latency target
+    int32_t min_page_size;
+    int32_t max_page_size;
+  };
+
+  PageSizer(const Settings& settings, int32_t initial_page_size);
+
+  const Settings& settings() const { return settings_; }
+
+  int32_t page_size() const { return page_size_; }
+
+  double bytes_per_row() const { return bytes_per_row_; }
+
+  // Reserves the expected size of the next page from the budget and returns
+  // the page size to request, which is reduced if the budget is exhausted.
+  int32_t reserve(const PagingBudget::Ptr& budget,
+                  PagingReservation* reservation) const;
+
+  // Updates the page size from a received page
+  void update(int32_t row_count, size_t page_bytes, uint64_t latency_ns);
+
+private:
+  int32_t clamp(double page_size) const;
+  uint64_t expected_bytes(int32_t page_size) const;
+
+private:
+  Settings settings_;
+  int32_t page_size_;
+  double bytes_per_row_;
+  bool has_rows_; // Whether a page with rows was received
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PageSizer);
+};
+
+} // namespace cass
+
+#endif
@@ -11,6 +11,7 @@
 // under the License.
 //
 
+#include <algorithm>
 #include <iomanip>
 
 #include "partition_aware_policy.hpp"
@@ -18,6 +19,7 @@
 #include "batch_request.hpp"
 #include "execute_request.hpp"
 #include "jenkins_hash.hpp"
+#include "latency_aware_policy.hpp"
 #include "logger.hpp"
 #include "metadata.hpp"
 #include "random.hpp"
@@ -53,7 +55,7 @@ static const char* bytes_to_str(const Buffer& b) {
 }
 #endif
 
-static int64_t cql_to_yb_hash_code(int32_t hash) {
+int64_t PartitionAwarePolicy::to_yb_hash_code(int32_t hash) {
   return static_cast<int64_t>(hash ^ 0x8000) << 48;
 }
 
@@ -68,6 +70,28 @@ static inline bool contains(const CopyOnWriteHostVec& replicas, const Address& a
   return false;
 }
 
+// Only single replica reads can be served by followers
+static bool is_follower_read(const RequestHandler* request_handler) {
+  CassConsistency consistency = request_handler->consistency();
+  if (consistency != CASS_CONSISTENCY_ONE &&
+      consistency != CASS_CONSISTENCY_LOCAL_ONE) {
+    return false;
+  }
+
+  const Request* request = request_handler->request();
+  if (request->opcode() != CQL_OPCODE_EXECUTE) {
+    return false;
+  }
+  const ResultMetadata::Ptr& result_metadata =
+      static_cast<const ExecuteRequest*>(request)->prepared()->result()->result_metadata();
+  return result_metadata && result_metadata->column_count() > 0;
+}
+
+static void enable_latency_tracking(const Host::Ptr& host) {
+  LatencyAwarePolicy::Settings settings;
+  host->enable_latency_tracking(settings.scale_ns, settings.min_measured);
+}
+
 static int32_t bytes_to_key(const char* bytes, size_t size) {
     const uint64_t seed = 97;
     const uint64_t h = Hash64StringWithSeed(bytes, size, seed);
@@ -92,6 +116,14 @@ static bool get_hash_key_from_execute(const ExecuteRequest* execute,
   // Set full table name.
   *full_table_name = result->keyspace().to_string() + '.' + result->table().to_string();
 
+  PartitionAwarePolicy::get_hash_key(execute, hash_key);
+  return true;
+}
+
+void PartitionAwarePolicy::get_hash_key(const ExecuteRequest* execute,
+                                        int32_t* hash_key) {
+  const Prepared::ConstPtr& prepared = execute->prepared();
+
   // Get binded values and write it into binary stream.
   const AbstractData::ElementVec& elems = execute->elements();
 
@@ -121,7 +153,6 @@ static bool get_hash_key_from_execute(const ExecuteRequest* execute,
 
   // Create hash key from binary stream.
   *hash_key = bytes_to_key(total.data(), total.size());
-  return true;
 }
 
 bool PartitionAwarePolicy::get_hash_code(const Request* request,
@@ -162,7 +193,7 @@ bool PartitionAwarePolicy::get_yb_hash_code(const Request* request,
     return false;
   }
 
-  *hash_key = cql_to_yb_hash_code(hash_key_32b);
+  *hash_key = to_yb_hash_code(hash_key_32b);
   return true;
 }
 
@@ -176,6 +207,13 @@ void PartitionAwarePolicy::init(const Host::Ptr& connected_host,
     index_ = random->next(std::max(static_cast<size_t>(1), hosts.size()));
   }
 
+  if (follower_reads_) {
+    for (HostMap::const_iterator i = hosts.begin(),
+         end = hosts.end(); i != end; ++i) {
+      enable_latency_tracking(i->second);
+    }
+  }
+
   ChainedLoadBalancingPolicy::init(connected_host, hosts, random);
 }
 
@@ -218,6 +256,7 @@ QueryPlan* PartitionAwarePolicy::new_query_plan(const std::string& keyspace,
   }
 
   CopyOnWriteHostVec replicas(new HostVec);
+  bool has_leader = false;
 
   for (PartitionMetadata::IpList::const_iterator ip_it = ip_list->begin();
       ip_it != ip_list->end(); ++ip_it) {
@@ -225,9 +264,10 @@ QueryPlan* PartitionAwarePolicy::new_query_plan(const std::string& keyspace,
 
     // TODO: replace host vector by host map
     for (const Host::Ptr& host : *hosts_) {
-      if (host->address().to_string(false) == *ip_it) {
+      if (host->address_string() == *ip_it) {
         if (is_leader) {
           replicas->insert(replicas->begin(), host);
+          has_leader = true;
         } else {
           replicas->push_back(host);
         }
@@ -236,11 +276,74 @@ QueryPlan* PartitionAwarePolicy::new_query_plan(const std::string& keyspace,
     }
   }
 
+  if (follower_reads_ && replicas->size() > 1 && is_follower_read(request_handler)) {
+    order_for_follower_read(child_policy_.get(), local_rack_, has_leader, &(*replicas));
+    return new PartitionAwareQueryPlan(child_policy_.get(), child_plan, replicas, index_++, true);
+  }
+
   // Replicas list can be empty.
   return new PartitionAwareQueryPlan(child_policy_.get(), child_plan, replicas, index_++);
 }
 
+namespace {
+
+struct FollowerRank {
+  FollowerRank(int locality, int64_t latency, const Host::Ptr& host)
+    : locality(locality)
+    , latency(latency)
+    , host(host) { }
+
+  bool operator<(const FollowerRank& other) const {
+    if (locality != other.locality) return locality < other.locality;
+    return latency < other.latency;
+  }
+
+  int locality;
+  int64_t latency;
+  Host::Ptr host;
+};
+
+} // namespace
+
+void PartitionAwarePolicy::order_for_follower_read(const LoadBalancingPolicy* child_policy,
+                                                   const std::string& local_rack,
+                                                   bool has_leader,
+                                                   HostVec* replicas) {
+  Host::Ptr leader;
+  std::vector<FollowerRank> followers;
+  followers.reserve(replicas->size());
+  for (HostVec::const_iterator i = replicas->begin(),
+       end = replicas->end(); i != end; ++i) {
+    const Host::Ptr& host = *i;
+    CassHostDistance distance = child_policy->distance(host);
+    if (has_leader && i == replicas->begin()) {
+      if (distance != CASS_HOST_DISTANCE_IGNORE) {
+        leader = host;
+      }
+      continue;
+    }
+    if (distance != CASS_HOST_DISTANCE_LOCAL) continue;
+    int locality = !local_rack.empty() && host->rack() == local_rack ? 0 : 1;
+    // Hosts without enough measurements are ordered after the measured ones
+    TimestampedAverage average = host->get_current_average();
+    int64_t latency = average.average >= 0 ? average.average : CASS_INT64_MAX;
+    followers.push_back(FollowerRank(locality, latency, host));
+  }
+  std::stable_sort(followers.begin(), followers.end());
+
+  replicas->clear();
+  for (size_t i = 0; i < followers.size(); ++i) {
+    replicas->push_back(followers[i].host);
+  }
+  if (leader) {
+    replicas->push_back(leader);
+  }
+}
+
 void PartitionAwarePolicy::on_add(const Host::Ptr& host) {
+  if (follower_reads_) {
+    enable_latency_tracking(host);
+  }
   add_host(hosts_, host);
   ChainedLoadBalancingPolicy::on_add(host);
 }
@@ -262,6 +365,17 @@ void PartitionAwarePolicy::on_down(const Host::Ptr& host) {
 
 Host::Ptr PartitionAwarePolicy::PartitionAwareQueryPlan::compute_next() {
   Host::Ptr host;
+
+  if (is_ordered_) {
+    while (remaining_ > 0) {
+      --remaining_;
+      host = (*replicas_)[index_++];
+      if (host->is_up()) {
+        return host;
+      }
+    }
+  }
+
   // Leader is preferred host - first member of replicas list.
   if (use_leader_ && !replicas_->empty()) {
     host = (*replicas_)[0];
@@ -18,14 +18,20 @@
 
 namespace cass {
 
+class ExecuteRequest;
+
 class CASS_EXPORT PartitionAwarePolicy: public ChainedLoadBalancingPolicy {
 public:
   PartitionAwarePolicy(LoadBalancingPolicy *child_policy,
-                       unsigned refresh_frequency_secs)
+                       unsigned refresh_frequency_secs,
+                       bool follower_reads = false,
+                       const std::string& local_rack = std::string())
     : ChainedLoadBalancingPolicy(child_policy)
     , hosts_(new HostVec)
     , index_(0)
-    , refresh_frequency_secs_(refresh_frequency_secs) {}
+    , refresh_frequency_secs_(refresh_frequency_secs)
+    , follower_reads_(follower_reads)
+    , local_rack_(local_rack) {}
 
   virtual void init(const Host::Ptr& connected_host, const HostMap& hosts, Random* random);
 
@@ -38,7 +44,8 @@ public:
   virtual void on_down(const Host::Ptr& host);
 
   virtual LoadBalancingPolicy* new_instance() {
-    return new PartitionAwarePolicy(child_policy_->new_instance(), refresh_frequency_secs_);
+    return new PartitionAwarePolicy(child_policy_->new_instance(), refresh_frequency_secs_,
+                                    follower_reads_, local_rack_);
   }
 
   static bool get_hash_code(
@@ -47,18 +54,37 @@ public:
   static bool get_yb_hash_code(
       const Request* request, int64_t* hash_key, std::string* full_table_name);
 
+  // Computes the hash key of a bound statement's partition key values. The
+  // statement's prepared result must be valid.
+  static void get_hash_key(const ExecuteRequest* execute, int32_t* hash_key);
+
+  static int64_t to_yb_hash_code(int32_t hash_key);
+
+  // Orders a partition's replicas (leader first if "has_leader") for a
+  // follower read: the followers in the local rack, then the other followers
+  // in the local DC, each ordered by their average latency, then the leader.
+  // Followers that aren't local are removed and left to the child policy's
+  // plan so that reads don't leave the local DC before trying the leader.
+  // Hosts ignored by the child policy are removed.
+  static void order_for_follower_read(const LoadBalancingPolicy* child_policy,
+                                      const std::string& local_rack,
+                                      bool has_leader,
+                                      HostVec* replicas);
+
 private:
   class PartitionAwareQueryPlan : public QueryPlan {
   public:
     PartitionAwareQueryPlan(
         LoadBalancingPolicy* child_policy, QueryPlan* child_plan,
-        const CopyOnWriteHostVec& replicas, size_t start_index)
+        const CopyOnWriteHostVec& replicas, size_t start_index,
+        bool is_ordered = false)
       : child_policy_(child_policy)
       , child_plan_(child_plan)
-      , use_leader_(true)
+      , use_leader_(!is_ordered)
+      , is_ordered_(is_ordered)
       , replicas_(replicas)
-      , index_(start_index)
-      , remaining_(replicas->size() - 1) {}
+      , index_(is_ordered ? 0 : start_index)
+      , remaining_(is_ordered ? replicas->size() : replicas->size() - 1) {}
 
     virtual Host::Ptr compute_next();
 
@@ -66,6 +92,8 @@ private:
     LoadBalancingPolicy* child_policy_;
     ScopedPtr<QueryPlan> child_plan_;
     bool use_leader_;
+    // The replicas are tried in order instead of leader first
+    bool is_ordered_;
     const CopyOnWriteHostVec replicas_;
     size_t index_;
     size_t remaining_;
@@ -74,6 +102,8 @@ private:
   CopyOnWriteHostVec hosts_;
   int index_;
   unsigned refresh_frequency_secs_;
+  bool follower_reads_;
+  std::string local_rack_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(PartitionAwarePolicy);
@@ -0,0 +1,246 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "partition_stats.hpp"
+
+#include "batch_request.hpp"
+#include "execute_request.hpp"
+#include "partition_aware_policy.hpp"
+#include "scoped_lock.hpp"
+#include "serialization.hpp"
+#include "session.hpp"
+
+#include <algorithm>
+
+extern "C" {
+
+CassPartitionStats* cass_session_get_partition_stats(const CassSession* session,
+                                                     CassPartitionStatsType type) {
+  const cass::PartitionStats::Ptr& partition_stats = session->partition_stats();
+  if (!partition_stats) {
+    return NULL;
+  }
+  cass::PartitionStatsSnapshot* snapshot =
+      new cass::PartitionStatsSnapshot(partition_stats->sample_rate());
+  if (type == CASS_PARTITION_STATS_TYPE_TABLET) {
+    partition_stats->top_tablets(&snapshot->entries());
+  } else {
+    partition_stats->top_partitions(&snapshot->entries());
+  }
+  return CassPartitionStats::to(snapshot);
+}
+
+void cass_session_reset_partition_stats(CassSession* session) {
+  const cass::PartitionStats::Ptr& partition_stats = session->partition_stats();
+  if (partition_stats) {
+    partition_stats->reset();
+  }
+}
+
+void cass_partition_stats_free(CassPartitionStats* stats) {
+  delete stats->from();
+}
+
+size_t cass_partition_stats_entry_count(const CassPartitionStats* stats) {
+  return stats->entries().size();
+}
+
+CassError cass_partition_stats_entry(const CassPartitionStats* stats,
+                                     size_t index,
+                                     CassPartitionStatsEntry* output) {
+  if (index >= stats->entries().size()) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+  const cass::PartitionStats::Entry& entry = stats->entries()[index];
+  output->table = entry.table.data();
+  output->table_length = entry.table.size();
+  output->start = entry.start;
+  output->end = entry.end;
+  // Only sampled requests are counted
+  output->requests = entry.count * stats->sample_rate();
+  output->error = entry.error * stats->sample_rate();
+  output->bytes = entry.bytes * stats->sample_rate();
+  output->mean_latency = entry.mean_latency_ns() / 1000;
+  return CASS_OK;
+}
+
+} // extern "C"
+
+namespace cass {
+
+PartitionStats::PartitionStats(unsigned sample_rate, size_t top_k)
+  : sample_rate_(std::max(sample_rate, 1u))
+  , sample_count_(0)
+  , partitions_(top_k)
+  , tablets_(top_k) {
+  uv_mutex_init(&mutex_);
+}
+
+PartitionStats::~PartitionStats() {
+  uv_mutex_destroy(&mutex_);
+}
+
+bool PartitionStats::make_sample(const Request* request,
+                                 const Metadata::SchemaSnapshot& schema,
+                                 const TokenMap* token_map,
+                                 Sample* sample) {
+  // Batches are recorded using their first bound statement
+  const ExecuteRequest* execute = NULL;
+  if (request->opcode() == CQL_OPCODE_EXECUTE) {
+    execute = static_cast<const ExecuteRequest*>(request);
+  } else if (request->opcode() == CQL_OPCODE_BATCH) {
+    const BatchRequest::StatementVec& statements =
+        static_cast<const BatchRequest*>(request)->statements();
+    for (BatchRequest::StatementVec::const_iterator i = statements.begin(),
+         end = statements.end(); i != end; ++i) {
+      if ((*i)->opcode() == CQL_OPCODE_EXECUTE) {
+        execute = static_cast<const ExecuteRequest*>(i->get());
+        break;
+      }
+    }
+  }
+  if (execute == NULL) {
+    return false;
+  }
+
+  const ResultResponse::ConstPtr& result = execute->prepared()->result();
+  if (!result || result->table().empty()) {
+    return false;
+  }
+  sample->table = result->keyspace().to_string() + '.' + result->table().to_string();
+
+  const TableSplitMetadata::MapPtr& partitions = schema.get_partitions();
+  TableSplitMetadata::Map::const_iterator it = partitions->find(sample->table);
+  if (it != partitions->end()) {
+    int32_t hash_key = 0;
+    PartitionAwarePolicy::get_hash_key(execute, &hash_key);
+    sample->token = hash_key;
+    const PartitionMetadata* partition = it->second.get_partition_metadata(hash_key);
+    if (partition != NULL) {
+      sample->has_tablet = true;
+      sample->tablet_start = partition->start_key_;
+      sample->tablet_end = partition->end_key_;
+    }
+    return true;
+  }
+
+  std::string routing_key;
+  if (token_map == NULL || !execute->get_routing_key(&routing_key)) {
+    return false;
+  }
+  return token_map->get_token(routing_key, &sample->token);
+}
+
+void PartitionStats::record(const Sample& sample, uint64_t bytes, uint64_t latency_ns) {
+  ScopedMutex l(&mutex_);
+  partitions_.add(sample.table, sample.token, sample.token, bytes, latency_ns);
+  if (sample.has_tablet) {
+    tablets_.add(sample.table, sample.tablet_start, sample.tablet_end, bytes, latency_ns);
+  }
+}
+
+void PartitionStats::top_partitions(EntryVec* output) const {
+  ScopedMutex l(&mutex_);
+  partitions_.copy(output);
+}
+
+void PartitionStats::top_tablets(EntryVec* output) const {
+  ScopedMutex l(&mutex_);
+  tablets_.copy(output);
+}
+
+void PartitionStats::reset() {
+  ScopedMutex l(&mutex_);
+  partitions_.clear();
+  tablets_.clear();
+}
+
+PartitionStats::HeavyHitters::HeavyHitters(size_t capacity)
+  : capacity_(std::max(capacity, static_cast<size_t>(1))) {
+  entries_.reserve(capacity_);
+  index_.set_empty_key(std::string());
+  index_.set_deleted_key(std::string(1, '\0'));
+}
+
+void PartitionStats::HeavyHitters::add(const std::string& table, int64_t start, int64_t end,
+                                       uint64_t bytes, uint64_t latency_ns) {
+  make_key(table, start, &key_);
+
+  size_t index;
+  IndexMap::const_iterator it = index_.find(key_);
+  if (it != index_.end()) {
+    index = it->second;
+  } else {
+    if (entries_.size() < capacity_) {
+      index = entries_.size();
+      entries_.push_back(Entry());
+    } else {
+      // Replace the entry with the lowest count. Its count is kept as the
+      // error bound of the new entry so the new entry's count is never
+      // underestimated. The number of entries is small so a linear scan
+      // is used instead of a heap.
+      index = 0;
+      for (size_t i = 1; i < entries_.size(); ++i) {
+        if (entries_[i].count < entries_[index].count) {
+          index = i;
+        }
+      }
+      Entry& replaced = entries_[index];
+      std::string replaced_key;
+      make_key(replaced.table, replaced.start, &replaced_key);
+      index_.erase(replaced_key);
+      replaced.error = replaced.count;
+      replaced.bytes = 0;
+      replaced.total_latency_ns = 0;
+    }
+    Entry& entry = entries_[index];
+    entry.table = table;
+    entry.start = start;
+    entry.end = end;
+    index_[key_] = index;
+  }
+
+  Entry& entry = entries_[index];
+  entry.count++;
+  entry.bytes += bytes;
+  entry.total_latency_ns += latency_ns;
+}
+
+static bool compare_count(const PartitionStats::Entry& lhs,
+                          const PartitionStats::Entry& rhs) {
+  return lhs.count > rhs.count;
+}
+
+void PartitionStats::HeavyHitters::copy(EntryVec* output) const {
+  *output = entries_;
+  std::sort(output->begin(), output->end(), compare_count);
+}
+
+void PartitionStats::HeavyHitters::clear() {
+  entries_.clear();
+  index_.clear();
+}
+
+// Format: <table><start>
+void PartitionStats::HeavyHitters::make_key(const std::string& table, int64_t start,
+                                            std::string* key) {
+  char buf[sizeof(int64_t)];
+  encode_int64(buf, start);
+  key->assign(table);
+  key->append(buf, sizeof(int64_t));
+}
+
+} // namespace cass
@@ -0,0 +1,178 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_PARTITION_STATS_HPP_INCLUDED__
+#define __CASS_PARTITION_STATS_HPP_INCLUDED__
+
+#include "atomic.hpp"
+#include "cassandra.h"
+#include "external.hpp"
+#include "macros.hpp"
+#include "metadata.hpp"
+#include "ref_counted.hpp"
+#include "token_map.hpp"
+
+#include <sparsehash/dense_hash_map>
+
+#include <string>
+#include <uv.h>
+#include <vector>
+
+namespace cass {
+
+class Request;
+
+/**
+ * Bounded memory statistics of the partitions and tablets that receive the
+ * most traffic. One in every `sample_rate` requests is sampled and its
+ * request count, response bytes and latency are recorded per partition token
+ * and per YugaByte tablet. Each table of counters keeps at most `top_k`
+ * entries using the Space-Saving heavy hitters algorithm: when a table is full
+ * the entry with the lowest count is replaced and its count becomes the new
+ * entry's error bound.
+ */
+class PartitionStats : public RefCounted<PartitionStats> {
+public:
+  typedef SharedRefPtr<PartitionStats> Ptr;
+
+  // The partition and tablet of a sampled request
+  struct Sample {
+    Sample()
+      : token(0)
+      , has_tablet(false)
+      , tablet_start(0)
+      , tablet_end(0) { }
+
+    std::string table;
+    int64_t token;
+    bool has_tablet;
+    int32_t tablet_start;
+    int32_t tablet_end;
+  };
+
+  struct Entry {
+    Entry()
+      : start(0)
+      , end(0)
+      , count(0)
+      , error(0)
+      , bytes(0)
+      , total_latency_ns(0) { }
+
+    // The latency is only accumulated for the requests that were counted
+    // after the entry was added
+    uint64_t mean_latency_ns() const {
+      uint64_t measured = count - error;
+      return measured > 0 ? total_latency_ns / measured : 0;
+    }
+
+    std::string table;
+    int64_t start;
+    int64_t end;
+    uint64_t count;
+    uint64_t error;
+    uint64_t bytes;
+    uint64_t total_latency_ns;
+  };
+
+  typedef std::vector<Entry> EntryVec;
+
+  PartitionStats(unsigned sample_rate, size_t top_k);
+  ~PartitionStats();
+
+  unsigned sample_rate() const { return sample_rate_; }
+
+  bool should_sample() {
+    return sample_count_.fetch_add(1, MEMORY_ORDER_RELAXED) % sample_rate_ == 0;
+  }
+
+  // Finds the partition token and tablet of a request. The token is found
+  // using the token map's partitioner unless the table's partitions are
+  // known. Returns false if the request doesn't have a routing key or its
+  // token can't be found (there's no token map or the partitioner's tokens
+  // aren't 64-bit integers).
+  static bool make_sample(const Request* request,
+                          const Metadata::SchemaSnapshot& schema,
+                          const TokenMap* token_map,
+                          Sample* sample);
+
+  void record(const Sample& sample, uint64_t bytes, uint64_t latency_ns);
+
+  // Copies the entries ordered from the highest count to the lowest. The
+  // counts are the number of sampled requests.
+  void top_partitions(EntryVec* output) const;
+  void top_tablets(EntryVec* output) const;
+
+  void reset();
+
+private:
+  class HeavyHitters {
+  public:
+    HeavyHitters(size_t capacity);
+
+    void add(const std::string& table, int64_t start, int64_t end,
+             uint64_t bytes, uint64_t latency_ns);
+
+    void copy(EntryVec* output) const;
+
+    void clear();
+
+  private:
+    typedef sparsehash::dense_hash_map<std::string, size_t> IndexMap;
+
+    static void make_key(const std::string& table, int64_t start, std::string* key);
+
+    const size_t capacity_;
+    EntryVec entries_;
+    IndexMap index_;
+    std::string key_;
+  };
+
+  const unsigned sample_rate_;
+  Atomic<uint64_t> sample_count_;
+
+  mutable uv_mutex_t mutex_;
+  HeavyHitters partitions_;
+  HeavyHitters tablets_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PartitionStats);
+};
+
+// A copy of the top entries returned to the application
+class PartitionStatsSnapshot {
+public:
+  PartitionStatsSnapshot(unsigned sample_rate)
+    : sample_rate_(sample_rate) { }
+
+  unsigned sample_rate() const { return sample_rate_; }
+
+  PartitionStats::EntryVec& entries() { return entries_; }
+  const PartitionStats::EntryVec& entries() const { return entries_; }
+
+private:
+  unsigned sample_rate_;
+  PartitionStats::EntryVec entries_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PartitionStatsSnapshot);
+};
+
+} // namespace cass
+
+EXTERNAL_TYPE(cass::PartitionStatsSnapshot, CassPartitionStats)
+
+#endif
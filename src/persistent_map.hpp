@@ -0,0 +1,271 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_PERSISTENT_MAP_HPP_INCLUDED__
+#define __CASS_PERSISTENT_MAP_HPP_INCLUDED__
+
+#include "ref_counted.hpp"
+
+#include <functional>
+#include <stddef.h>
+#include <vector>
+
+namespace cass {
+
+// A sorted map with structural sharing. Copying the map is constant time
+// because copies share their nodes. A modification only copies the nodes on
+// the path to the modified entry that are shared with other copies, so
+// the copies held by readers are never modified.
+//
+// The map is a treap that uses the hash of the key as the priority so that
+// its shape only depends on its keys. It's not thread-safe to modify a map
+// and read the same map object concurrently, but different copies of a map can
+// be used concurrently from different threads.
+template <class K, class V>
+class PersistentMap {
+private:
+  class Node : public RefCounted<Node> {
+  public:
+    typedef SharedRefPtr<Node> Ptr;
+
+    Node(const K& key, const V& value, size_t priority)
+      : first(key)
+      , second(value)
+      , priority(priority) { }
+
+    const K first;
+    V second;
+
+    const size_t priority;
+    Ptr left;
+    Ptr right;
+  };
+
+  typedef typename Node::Ptr NodePtr;
+
+public:
+  typedef K key_type;
+  typedef V mapped_type;
+
+  class const_iterator {
+  public:
+    const_iterator() { }
+
+    const Node& operator*() const { return *stack_.back(); }
+    const Node* operator->() const { return stack_.back(); }
+
+    const_iterator& operator++() {
+      const Node* node = stack_.back();
+      stack_.pop_back();
+      push_left(node->right.get());
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator temp(*this);
+      ++(*this);
+      return temp;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return stack_.empty() ? other.stack_.empty()
+                            : !other.stack_.empty() && stack_.back() == other.stack_.back();
+    }
+
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+
+  private:
+    friend class PersistentMap;
+
+    explicit const_iterator(const Node* root) {
+      push_left(root);
+    }
+
+    void push_left(const Node* node) {
+      for (; node != NULL; node = node->left.get()) {
+        stack_.push_back(node);
+      }
+    }
+
+    // The path from the root to the current node (the nodes with smaller keys
+    // are skipped).
+    std::vector<const Node*> stack_;
+  };
+
+  typedef const_iterator iterator;
+
+  PersistentMap()
+    : size_(0) { }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  const_iterator begin() const { return const_iterator(root_.get()); }
+  const_iterator end() const { return const_iterator(); }
+
+  const_iterator find(const K& key) const {
+    const_iterator it;
+    for (const Node* node = root_.get(); node != NULL;) {
+      if (key < node->first) {
+        it.stack_.push_back(node);
+        node = node->left.get();
+      } else if (node->first < key) {
+        node = node->right.get();
+      } else {
+        it.stack_.push_back(node);
+        return it;
+      }
+    }
+    return end();
+  }
+
+  // Returns a pointer to the value for the key that can be modified or
+  // NULL if there's no entry for the key. The pointer is valid until the
+  // map is modified.
+  V* find_mutable(const K& key) {
+    if (find(key) == end()) return NULL;
+    NodePtr* node = &root_;
+    while (true) {
+      make_unique(*node);
+      if (key < (*node)->first) {
+        node = &(*node)->left;
+      } else if ((*node)->first < key) {
+        node = &(*node)->right;
+      } else {
+        return &(*node)->second;
+      }
+    }
+  }
+
+  V& operator[](const K& key) {
+    V* value = find_mutable(key);
+    if (value != NULL) return *value;
+    return *insert(root_, key, V());
+  }
+
+  // Returns false (and doesn't modify the map) if there's already an entry
+  // for the key.
+  bool insert(const K& key, const V& value) {
+    if (find(key) != end()) return false;
+    insert(root_, key, value);
+    return true;
+  }
+
+  size_t erase(const K& key) {
+    if (find(key) == end()) return 0;
+    erase(root_, key);
+    size_--;
+    return 1;
+  }
+
+  void clear() {
+    root_.reset();
+    size_ = 0;
+  }
+
+private:
+  static void make_unique(NodePtr& node) {
+    if (node->ref_count() > 1) {
+      NodePtr copy(new Node(node->first, node->second, node->priority));
+      copy->left = node->left;
+      copy->right = node->right;
+      node = copy;
+    }
+  }
+
+  static void rotate_right(NodePtr& node) {
+    NodePtr left(node->left);
+    node->left = left->right;
+    left->right = node;
+    node = left;
+  }
+
+  static void rotate_left(NodePtr& node) {
+    NodePtr right(node->right);
+    node->right = right->left;
+    right->left = node;
+    node = right;
+  }
+
+  V* insert(NodePtr& node, const K& key, const V& value) {
+    if (!node) {
+      node.reset(new Node(key, value, std::hash<K>()(key)));
+      size_++;
+      return &node->second;
+    }
+    make_unique(node);
+    V* result;
+    if (key < node->first) {
+      result = insert(node->left, key, value);
+      if (node->left->priority > node->priority) rotate_right(node);
+    } else {
+      result = insert(node->right, key, value);
+      if (node->right->priority > node->priority) rotate_left(node);
+    }
+    return result;
+  }
+
+  static void erase(NodePtr& node, const K& key) {
+    make_unique(node);
+    if (key < node->first) {
+      erase(node->left, key);
+    } else if (node->first < key) {
+      erase(node->right, key);
+    } else {
+      NodePtr left(node->left);
+      NodePtr right(node->right);
+      node.reset(); // Releases the node's references to its children
+      merge(node, left, right);
+    }
+  }
+
+  // Merges two treaps where all the keys of "left" are less than the keys of
+  // "right". The references held by "left" and "right" are released so that
+  // unshared nodes aren't copied.
+  static void merge(NodePtr& result, NodePtr& left, NodePtr& right) {
+    if (!left) {
+      result = right;
+      right.reset();
+    } else if (!right) {
+      result = left;
+      left.reset();
+    } else if (left->priority > right->priority) {
+      make_unique(left);
+      NodePtr child(left->right);
+      left->right.reset();
+      merge(left->right, child, right);
+      result = left;
+      left.reset();
+    } else {
+      make_unique(right);
+      NodePtr child(right->left);
+      right->left.reset();
+      merge(right->left, left, child);
+      result = right;
+      right.reset();
+    }
+  }
+
+private:
+  NodePtr root_;
+  size_t size_;
+};
+
+} // namespace cass
+
+#endif
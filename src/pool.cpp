@@ -20,6 +20,7 @@
 #include "error_response.hpp"
 #include "io_worker.hpp"
 #include "logger.hpp"
+#include "protocol.hpp"
 #include "query_request.hpp"
 #include "session.hpp"
 #include "request_handler.hpp"
@@ -225,8 +226,16 @@ Connection* Pool::borrow_connection() {
 }
 
 bool Pool::internal_write(Connection* connection, const RequestCallback::Ptr& callback) {
-  std::string keyspace(io_worker_->keyspace());
-  if (keyspace == connection->keyspace()) {
+  // Requests carry their own keyspace when the protocol supports it so the
+  // connection's keyspace doesn't need to be changed using "USE" first.
+  bool is_keyspace_current = supports_set_keyspace(connection->protocol_version());
+  std::string keyspace;
+  if (!is_keyspace_current) {
+    keyspace = io_worker_->keyspace();
+    is_keyspace_current = keyspace == connection->keyspace();
+  }
+
+  if (is_keyspace_current) {
     if (!connection->write(callback, false)) {
       return false;
     }
@@ -270,6 +279,13 @@ void Pool::flush() {
   }
 }
 
+void Pool::on_schema_change_event() {
+  for (ConnectionVec::iterator it = connections_.begin(),
+       end = connections_.end(); it != end; ++it) {
+    (*it)->on_schema_change_event();
+  }
+}
+
 bool Pool::process_pending_requests() {
   RequestCallback::Vec::iterator it = pending_requests_.begin();
   for (RequestCallback::Vec::iterator end = pending_requests_.end();
@@ -60,6 +60,8 @@ public:
   void flush();
   bool process_pending_requests();
 
+  void on_schema_change_event();
+
   const Host::ConstPtr& host() const { return host_; }
   uv_loop_t* loop() { return loop_; }
   const Config& config() const { return config_; }
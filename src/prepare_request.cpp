@@ -17,6 +17,7 @@
 #include "prepare_request.hpp"
 
 #include "protocol.hpp"
+#include "request_callback.hpp"
 #include "serialization.hpp"
 
 namespace cass {
@@ -32,9 +33,10 @@ int PrepareRequest::encode(int version, RequestCallback* callback, BufferVec* bu
     int32_t flags = 0;
     size_t flags_keyspace_buf_size = sizeof(int32_t); // <flags> [int]
 
-    if (!keyspace().empty()) {
+    const std::string& keyspace = callback->keyspace();
+    if (!keyspace.empty()) {
       flags |= CASS_PREPARE_FLAG_WITH_KEYSPACE;
-      flags_keyspace_buf_size += sizeof(uint16_t) + keyspace().size(); // <keyspace> [string]
+      flags_keyspace_buf_size += sizeof(uint16_t) + keyspace.size(); // <keyspace> [string]
     }
 
     bufs->push_back(Buffer(flags_keyspace_buf_size));
@@ -43,8 +45,8 @@ int PrepareRequest::encode(int version, RequestCallback* callback, BufferVec* bu
     Buffer& buf = bufs->back();
     size_t pos = buf.encode_int32(0, flags);
 
-    if (!keyspace().empty()) {
-      buf.encode_string(pos, keyspace().data(), keyspace().size());
+    if (!keyspace.empty()) {
+      buf.encode_string(pos, keyspace.data(), keyspace.size());
     }
   }
   return length;
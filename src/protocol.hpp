@@ -19,6 +19,7 @@
 
 #include "cassandra.h"
 #include "constants.hpp"
+#include "host.hpp"
 
 namespace cass {
 
@@ -26,6 +27,16 @@ inline bool supports_set_keyspace(int version) {
   return version >= CASS_PROTOCOL_VERSION_V5;
 }
 
+// Frames are sent in checksummed segments after the STARTUP handshake. The
+// beta protocol v5 of Cassandra v3.x doesn't use segments; they were added by
+// the final protocol v5 of Cassandra v4.0. Segments are only used once the
+// server's version is known (i.e. not for the first connection to a contact
+// point).
+inline bool supports_segments(int version, const VersionNumber& cassandra_version) {
+  return version >= CASS_PROTOCOL_VERSION_V5 &&
+      cassandra_version >= VersionNumber(4, 0, 0);
+}
+
 inline bool supports_result_metadata_id(int version) {
   // Cassandra v4.x broke the beta protocol v5 version
   // JIRA: https://issues.apache.org/jira/browse/CASSANDRA-10786
@@ -0,0 +1,238 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "replica_lookup.hpp"
+
+#include "execute_request.hpp"
+#include "partition_aware_policy.hpp"
+#include "session.hpp"
+#include "token_map.hpp"
+
+extern "C" {
+
+CassError cass_session_lookup_replicas(const CassSession* session,
+                                       const CassStatement* const* statements,
+                                       size_t statement_count,
+                                       CassReplicaLookup** output) {
+  std::vector<const cass::ExecuteRequest*> requests;
+  requests.reserve(statement_count);
+  for (size_t i = 0; i < statement_count; ++i) {
+    const cass::Statement* statement = statements[i]->from();
+    if (statement->opcode() != CQL_OPCODE_EXECUTE) {
+      return CASS_ERROR_LIB_BAD_PARAMS;
+    }
+    requests.push_back(static_cast<const cass::ExecuteRequest*>(statement));
+  }
+
+  // The session's token map is updated on the session thread so a snapshot
+  // of it is used instead
+  cass::TokenMapSnapshot::ConstPtr token_map(session->token_map_snapshot());
+  cass::ReplicaLookup* lookup = new cass::ReplicaLookup();
+  lookup->lookup(session->metadata().schema_snapshot(session->protocol_version(),
+                                                     session->cassandra_version()),
+                 token_map ? token_map->token_map() : NULL,
+                 requests.empty() ? NULL : &requests[0], requests.size());
+  *output = CassReplicaLookup::to(lookup);
+  return CASS_OK;
+}
+
+void cass_replica_lookup_free(CassReplicaLookup* lookup) {
+  delete lookup->from();
+}
+
+size_t cass_replica_lookup_host_count(const CassReplicaLookup* lookup) {
+  return lookup->host_count();
+}
+
+CassError cass_replica_lookup_host(const CassReplicaLookup* lookup,
+                                   size_t index,
+                                   CassInet* output) {
+  if (index >= lookup->host_count()) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+  output->address_length = lookup->host(index).to_inet(output->address);
+  return CASS_OK;
+}
+
+size_t cass_replica_lookup_row_count(const CassReplicaLookup* lookup) {
+  return lookup->row_count();
+}
+
+CassError cass_replica_lookup_row(const CassReplicaLookup* lookup,
+                                  size_t index,
+                                  cass_int64_t* token,
+                                  const size_t** host_indices,
+                                  size_t* host_indices_count) {
+  if (index >= lookup->row_count()) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+  const cass::ReplicaLookup::Row& row = lookup->row(index);
+  if (row.error != CASS_OK) {
+    return row.error;
+  }
+  if (token != NULL) {
+    if (!row.has_token) {
+      return CASS_ERROR_LIB_NOT_IMPLEMENTED;
+    }
+    *token = row.token;
+  }
+  *host_indices = lookup->replicas(row);
+  *host_indices_count = row.replica_count;
+  return CASS_OK;
+}
+
+} // extern "C"
+
+namespace {
+
+// The partition key values must be bound, and not null, to find the
+// partition's replicas
+bool has_partition_key(const cass::ExecuteRequest* request) {
+  const cass::ResultResponse::PKIndexVec& indices = request->prepared()->key_indices();
+  if (indices.empty()) return false;
+  const cass::AbstractData::ElementVec& elements = request->elements();
+  for (cass::ResultResponse::PKIndexVec::const_iterator i = indices.begin(),
+       end = indices.end(); i != end; ++i) {
+    if (elements[*i].is_unset() || elements[*i].is_null()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+namespace cass {
+
+void ReplicaLookup::lookup(const Metadata::SchemaSnapshot& schema,
+                           const TokenMap* token_map,
+                           const ExecuteRequest* const* requests, size_t count) {
+  const TableSplitMetadata::MapPtr& partitions = schema.get_partitions();
+
+  rows_.resize(count);
+  replicas_.reserve(count * 3);
+
+  // Rows usually share the same prepared statement so the table's
+  // partitions are only looked up when the statement changes.
+  const Prepared* last_prepared = NULL;
+  const TableSplitMetadata* table_split = NULL;
+  std::string keyspace;
+
+  PendingRows pending;
+
+  for (size_t i = 0; i < count; ++i) {
+    const ExecuteRequest* request = requests[i];
+    const Prepared* prepared = request->prepared().get();
+    Row& row = rows_[i];
+
+    if (prepared != last_prepared) {
+      last_prepared = prepared;
+      table_split = NULL;
+      const ResultResponse::ConstPtr& result = prepared->result();
+      keyspace = result && !result->keyspace().empty()
+                 ? result->keyspace().to_string()
+                 : prepared->keyspace();
+      if (result && !result->table().empty()) {
+        TableSplitMetadata::Map::const_iterator it =
+            partitions->find(keyspace + '.' + result->table().to_string());
+        if (it != partitions->end()) {
+          table_split = &it->second;
+        }
+      }
+    }
+
+    if (!has_partition_key(request)) {
+      row.error = CASS_ERROR_LIB_BAD_PARAMS;
+      continue;
+    }
+
+    if (table_split != NULL) {
+      int32_t hash_key = 0;
+      PartitionAwarePolicy::get_hash_key(request, &hash_key);
+      row.token = PartitionAwarePolicy::to_yb_hash_code(hash_key);
+      row.has_token = true;
+
+      const PartitionMetadata::IpList* ip_list = table_split->get_hosts(hash_key);
+      row.first_replica = replicas_.size();
+      if (ip_list != NULL) {
+        for (PartitionMetadata::IpList::const_iterator it = ip_list->begin(),
+             end = ip_list->end(); it != end; ++it) {
+          replicas_.push_back(host_index(*it));
+        }
+      }
+      row.replica_count = replicas_.size() - row.first_replica;
+    } else {
+      if (keyspace != pending.keyspace) {
+        lookup_pending(token_map, &pending);
+        pending.keyspace = keyspace;
+      }
+      pending.rows.push_back(i);
+      pending.routing_keys.push_back(std::string());
+      request->get_routing_key(&pending.routing_keys.back());
+    }
+  }
+
+  lookup_pending(token_map, &pending);
+}
+
+void ReplicaLookup::lookup_pending(const TokenMap* token_map, PendingRows* pending) {
+  if (pending->rows.empty()) return;
+
+  // Without a token map (token-aware routing is disabled) the partitioner
+  // isn't known, so the rows have no token or replicas
+  if (token_map != NULL) {
+    std::vector<int64_t> tokens(pending->rows.size());
+    std::vector<CopyOnWriteHostVec> replicas;
+    replicas.reserve(pending->rows.size());
+    bool has_tokens = token_map->get_tokens_and_replicas(pending->keyspace,
+                                                         &pending->routing_keys[0],
+                                                         pending->rows.size(),
+                                                         &tokens[0], &replicas);
+
+    for (size_t i = 0; i < pending->rows.size(); ++i) {
+      Row& row = rows_[pending->rows[i]];
+      row.token = has_tokens ? tokens[i] : 0;
+      row.has_token = has_tokens;
+      row.first_replica = replicas_.size();
+      const CopyOnWriteHostVec& hosts = replicas[i];
+      if (hosts) {
+        for (HostVec::const_iterator it = hosts->begin(),
+             end = hosts->end(); it != end; ++it) {
+          replicas_.push_back(host_index((*it)->address_string()));
+        }
+      }
+      row.replica_count = replicas_.size() - row.first_replica;
+    }
+  }
+
+  pending->rows.clear();
+  pending->routing_keys.clear();
+}
+
+size_t ReplicaLookup::host_index(const std::string& ip) {
+  std::map<std::string, size_t>::const_iterator it = host_indices_.find(ip);
+  if (it != host_indices_.end()) {
+    return it->second;
+  }
+  Address address;
+  Address::from_string(ip, 0, &address);
+  size_t index = hosts_.size();
+  hosts_.push_back(address);
+  host_indices_[ip] = index;
+  return index;
+}
+
+} // namespace cass
@@ -0,0 +1,106 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_REPLICA_LOOKUP_HPP_INCLUDED__
+#define __CASS_REPLICA_LOOKUP_HPP_INCLUDED__
+
+#include "address.hpp"
+#include "cassandra.h"
+#include "external.hpp"
+#include "macros.hpp"
+#include "metadata.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cass {
+
+class ExecuteRequest;
+
+class TokenMap;
+
+/**
+ * The tokens and replicas of a batch of bound statements. When the
+ * partitions of a statement's table are known (partition-aware routing) the
+ * token is the YugaByte hash code and the replicas are the partition's hosts,
+ * leader first. Otherwise, the token and the replicas are found using the
+ * token map, which uses the cluster's partitioner. Only Murmur3Partitioner
+ * tokens are returned; the tokens of the other partitioners aren't 64-bit
+ * integers.
+ *
+ * Hosts are deduplicated so that callers can group rows by host index.
+ */
+class ReplicaLookup {
+public:
+  struct Row {
+    Row()
+      : token(0)
+      , has_token(false)
+      , error(CASS_OK)
+      , first_replica(0)
+      , replica_count(0) { }
+
+    int64_t token;
+    bool has_token;
+    CassError error;
+    size_t first_replica;
+    size_t replica_count;
+  };
+
+  ReplicaLookup() { }
+
+  // The token map is NULL if token-aware routing is disabled
+  void lookup(const Metadata::SchemaSnapshot& schema,
+              const TokenMap* token_map,
+              const ExecuteRequest* const* requests, size_t count);
+
+  size_t host_count() const { return hosts_.size(); }
+  const Address& host(size_t index) const { return hosts_[index]; }
+
+  size_t row_count() const { return rows_.size(); }
+  const Row& row(size_t index) const { return rows_[index]; }
+
+  const size_t* replicas(const Row& row) const {
+    return row.replica_count > 0 ? &replicas_[row.first_replica] : NULL;
+  }
+
+private:
+  // Rows that are looked up using the token map, grouped by keyspace
+  struct PendingRows {
+    std::string keyspace;
+    std::vector<size_t> rows;
+    std::vector<std::string> routing_keys;
+  };
+
+  void lookup_pending(const TokenMap* token_map, PendingRows* pending);
+
+  size_t host_index(const std::string& ip);
+
+  std::vector<Address> hosts_;
+  std::map<std::string, size_t> host_indices_;
+  std::vector<Row> rows_;
+  std::vector<size_t> replicas_; // Host indices of all the rows
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ReplicaLookup);
+};
+
+} // namespace cass
+
+EXTERNAL_TYPE(cass::ReplicaLookup, CassReplicaLookup)
+
+#endif
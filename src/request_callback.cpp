@@ -30,12 +30,48 @@
 
 namespace cass {
 
+namespace {
+
+// Used to encode a request outside of a connection. Errors are reported by
+// the callback that writes the request.
+class PreEncodeRequestCallback : public RequestCallback {
+public:
+  PreEncodeRequestCallback(const RequestWrapper& wrapper)
+    : RequestCallback(wrapper) { }
+
+private:
+  virtual void on_start() { }
+  virtual void on_retry_current_host() { }
+  virtual void on_retry_next_host() { }
+  virtual void on_set(ResponseMessage* response) { }
+  virtual void on_error(CassError code, const std::string& message) { }
+  virtual void on_cancel() { }
+};
+
+int32_t encode_body(RequestCallback* callback, int version, int* flags, BufferVec* bufs) {
+  const Request* req = callback->request();
+  int32_t length = 0;
+
+  if (version >= 4 && req->custom_payload()) {
+    *flags |= CASS_FLAG_CUSTOM_PAYLOAD;
+    length += req->custom_payload()->encode(bufs);
+  }
+
+  int32_t result = req->encode(version, callback, bufs);
+  if (result < 0) return result;
+  return length + result;
+}
+
+} // namespace
+
 void RequestWrapper::init(const Config& config,
+                          const std::string& keyspace,
                           const PreparedMetadata& prepared_metadata) {
   consistency_ = config.consistency();
   serial_consistency_ = config.serial_consistency();
   request_timeout_ms_ = config.request_timeout_ms();
   timestamp_ = config.timestamp_gen()->next();
+  keyspace_ = keyspace;
   retry_policy_ = config.retry_policy();
 
   if (request()->opcode() == CQL_OPCODE_EXECUTE) {
@@ -44,6 +80,16 @@ void RequestWrapper::init(const Config& config,
   }
 }
 
+bool RequestWrapper::pre_encode(int version) {
+  PreEncodeRequestCallback callback(*this);
+  EncodedBody::Ptr encoded(new EncodedBody(version, consistency()));
+  int32_t length = encode_body(&callback, version, &encoded->flags, &encoded->bufs);
+  if (length < 0) return false;
+  encoded->length = length;
+  encoded_body_ = encoded;
+  return true;
+}
+
 void RequestCallback::start(Connection* connection, int stream) {
   connection_ = connection;
   stream_ = stream;
@@ -61,15 +107,20 @@ int32_t RequestCallback::encode(int version, int flags, BufferVec* bufs) {
     flags |= CASS_FLAG_BETA;
   }
 
-  if (version >= 4 && req->custom_payload()) {
-    flags |= CASS_FLAG_CUSTOM_PAYLOAD;
-    length += req->custom_payload()->encode(bufs);
+  // Use the body encoded by the executing thread unless the connection's
+  // protocol version or the request's consistency have changed since
+  const RequestWrapper::EncodedBody::Ptr& encoded = wrapper_.encoded_body();
+  if (encoded &&
+      encoded->version == version &&
+      encoded->consistency == consistency()) {
+    flags |= encoded->flags;
+    bufs->insert(bufs->end(), encoded->bufs.begin(), encoded->bufs.end());
+    length = encoded->length;
+  } else {
+    length = encode_body(this, version, &flags, bufs);
+    if (length < 0) return length;
   }
 
-  int32_t result = req->encode(version, this, bufs);
-  if (result < 0) return result;
-  length += result;
-
   const size_t header_size
       = (version >= 3) ? CASS_HEADER_SIZE_V3 : CASS_HEADER_SIZE_V1_AND_V2;
 
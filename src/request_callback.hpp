@@ -50,16 +50,45 @@ typedef std::vector<uv_buf_t> UvBufVec;
  */
 class RequestWrapper {
 public:
+  /**
+   * A request's frame body encoded ahead of time, without the frame header.
+   * It's shared by all of the request's executions and is only valid for the
+   * protocol version and consistency it was encoded with.
+   */
+  struct EncodedBody : public RefCounted<EncodedBody> {
+    typedef SharedRefPtr<EncodedBody> Ptr;
+
+    EncodedBody(int version, CassConsistency consistency)
+      : version(version)
+      , consistency(consistency)
+      , flags(0)
+      , length(0) { }
+
+    const int version;
+    const CassConsistency consistency;
+    int flags;
+    int32_t length;
+    BufferVec bufs;
+  };
+
   RequestWrapper(const Request::ConstPtr &request)
     : request_(request)
     , consistency_(CASS_DEFAULT_CONSISTENCY)
     , serial_consistency_(CASS_DEFAULT_SERIAL_CONSISTENCY)
     , request_timeout_ms_(CASS_DEFAULT_REQUEST_TIMEOUT_MS)
-    , timestamp_(CASS_INT64_MIN) { }
+    , timestamp_(CASS_INT64_MIN)
+    , page_size_(0) { }
 
   void init(const Config& config,
+            const std::string& keyspace,
             const PreparedMetadata& prepared_metadata);
 
+  // Encodes the request's frame body for the given protocol version so that
+  // it doesn't need to be encoded by the I/O worker. Returns false if the
+  // request can't be encoded; the error is then reported when the request
+  // is written.
+  bool pre_encode(int version);
+
   const Request::ConstPtr& request() const {
     return request_;
   }
@@ -92,6 +121,23 @@ public:
     return timestamp_;
   }
 
+  // The page size of this execution of an adaptive paging statement, which
+  // is reduced when the session's paging budget is low. It's 0 if the
+  // statement's page size is used.
+  int32_t page_size() const { return page_size_; }
+
+  void set_page_size(int32_t page_size) { page_size_ = page_size; }
+
+  // The keyspace sent with the request on protocol versions that support
+  // per-request keyspaces. The session's keyspace is used if the request
+  // doesn't have its own.
+  const std::string& keyspace() const {
+    if (!request()->keyspace().empty()) {
+      return request()->keyspace();
+    }
+    return keyspace_;
+  }
+
   const RetryPolicy::Ptr& retry_policy() const {
     if (request()->retry_policy()) {
       return request()->retry_policy();
@@ -103,14 +149,21 @@ public:
     return prepared_metadata_entry_;
   }
 
+  const EncodedBody::Ptr& encoded_body() const {
+    return encoded_body_;
+  }
+
 private:
   Request::ConstPtr request_;
   CassConsistency consistency_;
   CassConsistency serial_consistency_;
   uint64_t request_timeout_ms_;
   int64_t timestamp_;
+  int32_t page_size_;
+  std::string keyspace_;
   RetryPolicy::Ptr retry_policy_;
   PreparedMetadata::Entry::Ptr prepared_metadata_entry_;
+  EncodedBody::Ptr encoded_body_;
 };
 
 class RequestCallback : public RefCounted<RequestCallback>, public List<RequestCallback>::Node {
@@ -175,10 +228,18 @@ public:
    return wrapper_.timestamp();
  }
 
+  int32_t page_size() const {
+    return wrapper_.page_size();
+  }
+
  const RetryPolicy::Ptr& retry_policy() {
    return wrapper_.retry_policy();
  }
 
+  const std::string& keyspace() const {
+    return wrapper_.keyspace();
+  }
+
   const PreparedMetadata::Entry::Ptr& prepared_metadata_entry() const {
     return wrapper_.prepared_metadata_entry();
   }
@@ -0,0 +1,106 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "request_coalescer.hpp"
+
+#include "constants.hpp"
+#include "execute_request.hpp"
+#include "external.hpp"
+#include "scoped_lock.hpp"
+
+namespace cass {
+
+RequestCoalescer::RequestCoalescer()
+  : coalesced_(0) {
+  flights_.set_empty_key(std::string());
+  flights_.set_deleted_key(std::string(1, '\0'));
+  uv_mutex_init(&mutex_);
+}
+
+RequestCoalescer::~RequestCoalescer() {
+  // Flights hold a reference to the coalescer so there are none left
+  uv_mutex_destroy(&mutex_);
+}
+
+ResponseFuture::Ptr RequestCoalescer::add(const std::string& key,
+                                          const ResponseFuture::Ptr& future) {
+  ScopedMutex l(&mutex_);
+
+  Map::iterator i = flights_.find(key);
+  if (i != flights_.end()) {
+    i->second->futures.push_back(future);
+    coalesced_.fetch_add(1, MEMORY_ORDER_RELAXED);
+    return ResponseFuture::Ptr();
+  }
+
+  Flight* flight = new Flight(this, key);
+  flight->futures.push_back(future);
+  flights_[key] = flight;
+  l.unlock();
+
+  ResponseFuture::Ptr leader(new ResponseFuture());
+  leader->set_callback(on_finished, flight);
+  return leader;
+}
+
+size_t RequestCoalescer::in_flight() const {
+  ScopedMutex l(&mutex_);
+  return flights_.size();
+}
+
+bool RequestCoalescer::is_coalescable(const Request* request) {
+  if (request->opcode() != CQL_OPCODE_EXECUTE || !request->is_idempotent()) {
+    return false;
+  }
+  if (request->request_timeout_ms() != CASS_UINT64_MAX ||
+      request->retry_policy() ||
+      request->custom_payload()) {
+    return false;
+  }
+  const ResultMetadata::Ptr& result_metadata =
+      static_cast<const ExecuteRequest*>(request)->prepared()->result()->result_metadata();
+  return result_metadata && result_metadata->column_count() > 0;
+}
+
+void RequestCoalescer::on_finished(CassFuture* future, void* data) {
+  Flight* flight = static_cast<Flight*>(data);
+  ResponseFuture* leader = static_cast<ResponseFuture*>(future->from());
+
+  {
+    // Requests added after this point start a new flight
+    ScopedMutex l(&flight->coalescer->mutex_);
+    flight->coalescer->flights_.erase(flight->key);
+  }
+
+  Address address(leader->address());
+  Response::Ptr response(leader->response());
+  const Future::Error* error = leader->error();
+
+  for (std::vector<ResponseFuture::Ptr>::const_iterator i = flight->futures.begin(),
+       end = flight->futures.end(); i != end; ++i) {
+    if (error == NULL) {
+      (*i)->set_response(address, response);
+    } else if (response) {
+      (*i)->set_error_with_response(address, response, error->code, error->message);
+    } else {
+      (*i)->set_error_with_address(address, error->code, error->message);
+    }
+  }
+
+  delete flight;
+}
+
+} // namespace cass
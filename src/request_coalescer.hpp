@@ -0,0 +1,86 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_REQUEST_COALESCER_HPP_INCLUDED__
+#define __CASS_REQUEST_COALESCER_HPP_INCLUDED__
+
+#include "atomic.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "request_handler.hpp"
+
+#include <sparsehash/dense_hash_map>
+
+#include <string>
+#include <uv.h>
+#include <vector>
+
+namespace cass {
+
+/**
+ * Coalesces identical requests that are in flight at the same time. The
+ * first request for a key is executed using an internal future and the
+ * futures of all the requests with the same key, including the first one,
+ * are set from its response when it finishes.
+ */
+class RequestCoalescer : public RefCounted<RequestCoalescer> {
+public:
+  typedef SharedRefPtr<RequestCoalescer> Ptr;
+
+  RequestCoalescer();
+  ~RequestCoalescer();
+
+  // Attaches a request's future to the in-flight request with the same key.
+  // If there's no such request, a future that the request must be executed
+  // with is returned. Otherwise, the returned pointer is empty.
+  ResponseFuture::Ptr add(const std::string& key, const ResponseFuture::Ptr& future);
+
+  size_t in_flight() const;
+
+  // Only idempotent bound statements that return rows (reads) are coalesced.
+  // Statements with their own request timeout, retry policy or custom
+  // payload aren't coalesced because those aren't part of the key and the
+  // requests would otherwise share another request's settings.
+  static bool is_coalescable(const Request* request);
+
+  uint64_t coalesced() const { return coalesced_.load(MEMORY_ORDER_RELAXED); }
+
+private:
+  struct Flight {
+    Flight(RequestCoalescer* coalescer, const std::string& key)
+      : coalescer(coalescer)
+      , key(key) { }
+
+    Ptr coalescer;
+    std::string key;
+    std::vector<ResponseFuture::Ptr> futures;
+  };
+
+  typedef sparsehash::dense_hash_map<std::string, Flight*> Map;
+
+  static void on_finished(CassFuture* future, void* data);
+
+  mutable uv_mutex_t mutex_;
+  Map flights_;
+  Atomic<uint64_t> coalesced_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(RequestCoalescer);
+};
+
+} // namespace cass
+
+#endif
@@ -96,6 +96,37 @@ void PrepareCallback::on_internal_timeout() {
   request_execution_->on_retry_next_host();
 }
 
+bool ResponseFuture::cancel() {
+  ScopedMutex lock(&mutex_);
+  if (is_set()) {
+    return false;
+  }
+  RequestHandler* request_handler = request_handler_;
+  request_handler_ = NULL;
+  internal_set_error(CASS_ERROR_LIB_REQUEST_CANCELLED,
+                     "Request was cancelled", lock);
+  lock.unlock();
+  if (request_handler != NULL) {
+    request_handler->cancel();
+    request_handler->dec_ref();
+  }
+  return true;
+}
+
+void ResponseFuture::set_request_handler(RequestHandler* request_handler) {
+  ScopedMutex lock(&mutex_);
+  assert(request_handler_ == NULL);
+  request_handler->inc_ref();
+  request_handler_ = request_handler;
+}
+
+RequestHandler* ResponseFuture::release_request_handler() {
+  ScopedMutex lock(&mutex_);
+  RequestHandler* request_handler = request_handler_;
+  request_handler_ = NULL;
+  return request_handler;
+}
+
 void RequestHandler::add_execution(RequestExecution* request_execution) {
   running_executions_++;
   request_execution->inc_ref();
@@ -107,6 +138,7 @@ void RequestHandler::add_attempted_address(const Address& address) {
 }
 
 void RequestHandler::schedule_next_execution(const Host::Ptr& current_host) {
+  if (is_stopped_) return;
   int64_t timeout = execution_plan_->next_execution(current_host);
   if (timeout >= 0) {
     RequestExecution::Ptr request_execution(
@@ -115,19 +147,27 @@ void RequestHandler::schedule_next_execution(const Host::Ptr& current_host) {
   }
 }
 
+void RequestHandler::pre_encode(Session* session, int protocol_version) {
+  wrapper_.init(session->config(), session->keyspace(), session->prepared_metadata());
+  wrapper_.pre_encode(protocol_version);
+  is_pre_encoded_ = true;
+}
+
 void RequestHandler::init(Session* session) {
   const Config& config = session->config();
-  wrapper_.init(config, session->prepared_metadata());
+  if (!is_pre_encoded_) {
+    wrapper_.init(config, session->keyspace(), session->prepared_metadata());
+  }
 
   // Attempt to use the statement's keyspace first then if not set then use the session's keyspace
-  const std::string& keyspace(!request()->keyspace().empty() ? request()->keyspace() : session->keyspace());
+  const std::string& keyspace(wrapper_.keyspace());
 
   query_plan_.reset(config.load_balancing_policy()->new_query_plan(keyspace, this, session));
   execution_plan_.reset(config.speculative_execution_policy()->new_plan(keyspace, wrapper_.request().get()));
 }
 
 void RequestHandler::start_request(IOWorker* io_worker) {
-  io_worker_ = io_worker;
+  io_worker_.store(io_worker);
   uint64_t request_timeout_ms = wrapper_.request_timeout_ms();
   if (request_timeout_ms > 0) { // 0 means no timeout
     timer_.start(io_worker->loop(),
@@ -137,10 +177,48 @@ void RequestHandler::start_request(IOWorker* io_worker) {
   }
 }
 
+void RequestHandler::cancel() {
+  is_cancelled_.store(true);
+  // A request that hasn't been started is dropped by the I/O worker when it's
+  // dequeued, otherwise the I/O worker needs to stop the running request.
+  IOWorker* io_worker = io_worker_.load();
+  if (io_worker != NULL) {
+    io_worker->cancel_request_async(this);
+  }
+}
+
+void RequestHandler::finish_cancel() {
+  if (!is_stopped_) {
+    LOG_DEBUG("Stopping cancelled request (%p)", static_cast<void*>(this));
+    stop_request();
+  }
+}
+
 void RequestHandler::set_response(const Host::Ptr& host,
                                   const Response::Ptr& response) {
+  if (response->opcode() == CQL_OPCODE_RESULT) {
+    static_cast<ResultResponse*>(response.get())->set_received(response_size_,
+                                                               uv_hrtime() - start_time_ns_);
+  }
   if (future_->set_response(host->address(), response)) {
-    io_worker_->metrics()->record_request(uv_hrtime() - start_time_ns_);
+    io_worker()->metrics()->record_request(uv_hrtime() - start_time_ns_);
+    if (result_cache_ &&
+        response->opcode() == CQL_OPCODE_RESULT &&
+        static_cast<ResultResponse*>(response.get())->kind() == CASS_RESULT_KIND_ROWS) {
+      result_cache_->put(result_cache_key_,
+                         result_cache_keyspace_, result_cache_table_,
+                         host->address(), response);
+    }
+    record_partition_stats();
+    if (statement_metrics_entry_) {
+      int32_t rows = 0;
+      if (response->opcode() == CQL_OPCODE_RESULT &&
+          static_cast<ResultResponse*>(response.get())->kind() == CASS_RESULT_KIND_ROWS) {
+        rows = static_cast<ResultResponse*>(response.get())->row_count();
+      }
+      statement_metrics_entry_->record_response(uv_hrtime() - start_time_ns_,
+                                                rows, response_size_);
+    }
     stop_request();
   }
 }
@@ -148,6 +226,8 @@ void RequestHandler::set_response(const Host::Ptr& host,
 void RequestHandler::set_error(CassError code,
                                const std::string& message) {
   if (future_->set_error(code, message)) {
+    record_partition_stats();
+    if (statement_metrics_entry_) statement_metrics_entry_->record_error();
     stop_request();
   }
 }
@@ -158,6 +238,8 @@ void RequestHandler::set_error(const Host::Ptr& host,
   if (!skip) {
     if (host) {
       if (future_->set_error_with_address(host->address(), code, message)) {
+        record_partition_stats();
+        if (statement_metrics_entry_) statement_metrics_entry_->record_error();
         stop_request();
       }
     } else {
@@ -170,6 +252,8 @@ void RequestHandler::set_error_with_error_response(const Host::Ptr& host,
                                                    const Response::Ptr& error,
                                                    CassError code, const std::string& message) {
   if (future_->set_error_with_response(host->address(), error, code, message)) {
+    record_partition_stats();
+    if (statement_metrics_entry_) statement_metrics_entry_->record_error();
     stop_request();
   }
 }
@@ -177,22 +261,49 @@ void RequestHandler::set_error_with_error_response(const Host::Ptr& host,
 void RequestHandler::on_timeout(Timer* timer) {
   RequestHandler* request_handler =
       static_cast<RequestHandler*>(timer->data());
-  request_handler->io_worker_->metrics()->request_timeouts.inc();
+  if (request_handler->is_cancelled()) {
+    request_handler->finish_cancel();
+    return;
+  }
+  request_handler->io_worker()->metrics()->request_timeouts.inc();
+  for (RequestExecutionVec::const_iterator i = request_handler->request_executions_.begin(),
+       end = request_handler->request_executions_.end(); i != end; ++i) {
+    const Host::Ptr& host = (*i)->current_host();
+    if (host) host->record_outcome(true);
+  }
   request_handler->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT,
                              "Request timed out");
   LOG_DEBUG("Request timed out");
 }
 
+void RequestHandler::record_partition_stats() {
+  if (partition_stats_) {
+    partition_stats_->record(partition_stats_sample_, response_size_,
+                             uv_hrtime() - start_time_ns_);
+  }
+}
+
 void RequestHandler::stop_request() {
+  is_stopped_ = true;
   timer_.stop();
+  // The page has been received (or won't be) so it no longer counts against
+  // the paging budget
+  paging_reservation_.release();
   for (RequestExecutionVec::const_iterator i = request_executions_.begin(),
        end = request_executions_.end(); i != end; ++i) {
     RequestExecution* request_execution = *i;
     request_execution->cancel();
     request_execution->dec_ref();
   }
-  if (io_worker_ != NULL) {
-    io_worker_->request_finished();
+  request_executions_.clear();
+  if (io_worker() != NULL) {
+    io_worker()->request_finished();
+  }
+  // This MUST be last because the future's reference could be the last
+  // reference to this handler.
+  RequestHandler* request_handler = future_->release_request_handler();
+  if (request_handler != NULL) {
+    request_handler->dec_ref();
   }
 }
 
@@ -235,6 +346,11 @@ void RequestExecution::on_execute(Timer* timer) {
   request_execution->execute();
 }
 
+void RequestExecution::on_retry(Timer* timer) {
+  RequestExecution* request_execution = static_cast<RequestExecution*>(timer->data());
+  request_execution->retry_current_host();
+}
+
 void RequestExecution::on_start() {
   assert(current_host_ && "Tried to start on a non-existent host");
   if (request()->record_attempted_addresses()) {
@@ -247,6 +363,13 @@ void RequestExecution::on_set(ResponseMessage* response) {
   assert(connection() != NULL);
   assert(current_host_ && "Tried to set on a non-existent host");
 
+  if (request_handler_->is_cancelled()) {
+    request_handler_->finish_cancel();
+    return;
+  }
+
+  request_handler_->response_size_ = response->length();
+
   switch (response->opcode()) {
     case CQL_OPCODE_RESULT:
       on_result_response(connection(), response);
@@ -262,6 +385,15 @@ void RequestExecution::on_set(ResponseMessage* response) {
 }
 
 void RequestExecution::on_error(CassError code, const std::string& message) {
+  if (request_handler_->is_cancelled()) {
+    request_handler_->finish_cancel();
+    return;
+  }
+
+  if (code == CASS_ERROR_LIB_WRITE_ERROR && current_host_) {
+    current_host_->record_outcome(true);
+  }
+
   // Handle recoverable errors by retrying with the next host
   if (code == CASS_ERROR_LIB_WRITE_ERROR ||
       code == CASS_ERROR_LIB_UNABLE_TO_SET_KEYSPACE) {
@@ -340,6 +472,7 @@ void RequestExecution::schedule_next(int64_t timeout) {
 
 void RequestExecution::cancel() {
   schedule_timer_.stop();
+  retry_timer_.stop();
   set_state(REQUEST_STATE_CANCELLED);
 }
 
@@ -347,6 +480,11 @@ void RequestExecution::on_result_response(Connection* connection, ResponseMessag
   ResultResponse* result =
       static_cast<ResultResponse*>(response->response_body().get());
 
+  if (retry_policy()) {
+    retry_policy()->on_success(current_host_->address());
+  }
+  current_host_->record_outcome(false);
+
   switch (result->kind()) {
     case CASS_RESULT_KIND_ROWS:
       current_host_->update_latency(uv_hrtime() - start_time_ns_);
@@ -369,14 +507,9 @@ void RequestExecution::on_result_response(Connection* connection, ResponseMessag
       set_response(response->response_body());
       break;
 
-    case CASS_RESULT_KIND_SCHEMA_CHANGE: {
-      SchemaChangeCallback::Ptr schema_change_handler(
-            new SchemaChangeCallback(connection,
-                                     Ptr(this),
-                                     response->response_body()));
-      schema_change_handler->execute();
+    case CASS_RESULT_KIND_SCHEMA_CHANGE:
+      connection->wait_for_schema_agreement(Ptr(this), response->response_body());
       break;
-    }
 
     case CASS_RESULT_KIND_SET_KEYSPACE:
       request_handler_->io_worker()->broadcast_keyspace_change(result->keyspace().to_string());
@@ -405,6 +538,21 @@ void RequestExecution::on_error_response(Connection* connection, ResponseMessage
 
   RetryPolicy::RetryDecision decision = RetryPolicy::RetryDecision::return_error();
 
+  // Only errors that indicate an unhealthy host count as failures; the rest
+  // (syntax, unavailable, etc.) show that the host is responsive.
+  switch (error->code()) {
+    case CQL_ERROR_READ_TIMEOUT:
+    case CQL_ERROR_WRITE_TIMEOUT:
+    case CQL_ERROR_OVERLOADED:
+    case CQL_ERROR_SERVER_ERROR:
+    case CQL_ERROR_IS_BOOTSTRAPPING:
+      current_host_->record_outcome(true);
+      break;
+    default:
+      current_host_->record_outcome(false);
+      break;
+  }
+
   switch(error->code()) {
     case CQL_ERROR_READ_TIMEOUT:
       if (retry_policy()) {
@@ -479,6 +627,31 @@ void RequestExecution::on_error_response(Connection* connection, ResponseMessage
 
   // Process retry decision
   switch(decision.type()) {
+    case RetryPolicy::RetryDecision::RETRY:
+      if (retry_policy()->acquire_retry(current_host_->address())) {
+        // Only retries that are limited by a retry budget are counted
+        if (retry_policy()->has_retry_budget()) {
+          request_handler_->io_worker()->metrics()->retries_allowed.inc();
+        }
+        set_retry_consistency(decision.retry_consistency());
+        uint64_t delay_ms = retry_policy()->retry_delay_ms(num_retries_);
+        if (delay_ms > 0) {
+          if (!decision.retry_current_host()) {
+            next_host();
+          }
+          retry_timer_.start(request_handler_->io_worker()->loop(), delay_ms,
+                             this, on_retry);
+        } else if (decision.retry_current_host()) {
+          retry_current_host();
+        } else {
+          retry_next_host();
+        }
+        num_retries_++;
+        break;
+      }
+      // The retry budget is exhausted so the error is returned
+      request_handler_->io_worker()->metrics()->retries_denied.inc();
+      // Fall through
     case RetryPolicy::RetryDecision::RETURN_ERROR:
       set_error_with_error_response(response->response_body(),
                                     static_cast<CassError>(CASS_ERROR(
@@ -486,16 +659,6 @@ void RequestExecution::on_error_response(Connection* connection, ResponseMessage
                                     error->message().to_string());
       break;
 
-    case RetryPolicy::RetryDecision::RETRY:
-      set_retry_consistency(decision.retry_consistency());
-      if (decision.retry_current_host()) {
-        retry_current_host();
-      } else {
-        retry_next_host();
-      }
-      num_retries_++;
-      break;
-
     case RetryPolicy::RetryDecision::IGNORE:
       set_response(Response::Ptr(new ResultResponse()));
       break;
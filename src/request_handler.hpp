@@ -24,14 +24,18 @@
 #include "host.hpp"
 #include "load_balancing.hpp"
 #include "metadata.hpp"
+#include "page_sizer.hpp"
+#include "partition_stats.hpp"
 #include "prepare_request.hpp"
 #include "request.hpp"
 #include "response.hpp"
+#include "result_cache.hpp"
 #include "result_response.hpp"
 #include "retry_policy.hpp"
 #include "scoped_ptr.hpp"
 #include "small_vector.hpp"
 #include "speculative_execution.hpp"
+#include "statement_metrics.hpp"
 
 #include <string>
 #include <uv.h>
@@ -41,6 +45,7 @@ namespace cass {
 class Connection;
 class IOWorker;
 class Pool;
+class RequestHandler;
 class Session;
 class Timer;
 class TokenMap;
@@ -50,11 +55,17 @@ public:
   typedef SharedRefPtr<ResponseFuture> Ptr;
 
   ResponseFuture()
-      : Future(CASS_FUTURE_TYPE_RESPONSE) { }
+      : Future(CASS_FUTURE_TYPE_RESPONSE)
+      , request_handler_(NULL) { }
 
   ResponseFuture(const Metadata::SchemaSnapshot& schema_metadata)
       : Future(CASS_FUTURE_TYPE_RESPONSE)
-      , schema_metadata(new Metadata::SchemaSnapshot(schema_metadata)) { }
+      , schema_metadata(new Metadata::SchemaSnapshot(schema_metadata))
+      , request_handler_(NULL) { }
+
+  // Sets the future with a "cancelled" error and asynchronously releases the
+  // resources held by the request. Returns false if the future is already set.
+  bool cancel();
 
   bool set_response(Address address, const Response::Ptr& response) {
     ScopedMutex lock(&mutex_);
@@ -119,10 +130,16 @@ private:
     attempted_addresses_.push_back(address);
   }
 
+  // The future holds a reference to its request handler so that it can be
+  // cancelled. The handler releases it when the request is finished.
+  void set_request_handler(RequestHandler* request_handler);
+  RequestHandler* release_request_handler();
+
 private:
   Address address_;
   Response::Ptr response_;
   AddressVec attempted_addresses_;
+  RequestHandler* request_handler_;
 };
 
 class RequestExecution;
@@ -149,10 +166,54 @@ public:
     , io_worker_(NULL)
     , running_executions_(0)
     , start_time_ns_(uv_hrtime())
-    , listener_(listener) { }
+    , listener_(listener)
+    , is_cancelled_(false)
+    , is_stopped_(false)
+    , is_pre_encoded_(false)
+    , response_size_(0) {
+    future_->set_request_handler(this);
+  }
+
+  // Encodes the request ahead of time using the session's protocol version.
+  // This is run on the thread executing the request, before it's queued.
+  void pre_encode(Session* session, int protocol_version);
 
   void init(Session* session);
 
+  // Stores the request's result in the cache when it's received
+  void set_result_cache(const ResultCache::Ptr& result_cache,
+                        const std::string& key,
+                        const std::string& keyspace,
+                        const std::string& table) {
+    result_cache_ = result_cache;
+    result_cache_key_ = key;
+    result_cache_keyspace_ = keyspace;
+    result_cache_table_ = table;
+  }
+
+  // Records the request's partition and tablet when it finishes
+  void set_partition_stats(const PartitionStats::Ptr& partition_stats,
+                           const PartitionStats::Sample& sample) {
+    partition_stats_ = partition_stats;
+    partition_stats_sample_ = sample;
+  }
+
+  // Uses a smaller page size for this execution of an adaptive paging
+  // statement. The reservation is kept until the request finishes.
+  void set_paging_reservation(int32_t page_size,
+                              PagingReservation* reservation) {
+    wrapper_.set_page_size(page_size);
+    paging_reservation_.take(reservation);
+  }
+
+  // Records the request's latency, rows and errors in its statement's
+  // metrics
+  void set_statement_metrics(const StatementMetrics::Ptr& statement_metrics,
+                             const StatementMetrics::Entry::Ptr& entry) {
+    statement_metrics_ = statement_metrics;
+    statement_metrics_entry_ = entry;
+  }
+
   const RequestWrapper& wrapper() const { return wrapper_; }
 
   const Request* request() const { return wrapper_.request().get(); }
@@ -173,10 +234,20 @@ public:
     return current_host_;
   }
 
-  IOWorker* io_worker() { return io_worker_; }
+  IOWorker* io_worker() { return io_worker_.load(MEMORY_ORDER_RELAXED); }
 
   void start_request(IOWorker* io_worker);
 
+  bool is_cancelled() const { return is_cancelled_.load(); }
+
+  // Marks the request as cancelled. This can be called from any thread and
+  // the request is stopped asynchronously on its I/O worker's thread.
+  void cancel();
+
+  // Stops a cancelled request, if it hasn't already been stopped. This MUST
+  // be called on the I/O worker's thread.
+  void finish_cancel();
+
   void set_response(const Host::Ptr& host,
                     const Response::Ptr& response);
   void set_error(CassError code, const std::string& message);
@@ -195,9 +266,10 @@ private:
   void add_execution(RequestExecution* request_execution);
   void add_attempted_address(const Address& address);
   void schedule_next_execution(const Host::Ptr& current_host);
+  void record_partition_stats();
 
-  // This MUST only be called once and that's currently guaranteed by the
-  // response future.
+  // This is only run once; that's guaranteed by the response future and,
+  // for cancelled requests, by the stopped flag.
   void stop_request();
 
 private:
@@ -208,7 +280,7 @@ private:
   ScopedPtr<QueryPlan> query_plan_;
   ScopedPtr<SpeculativeExecutionPlan> execution_plan_;
   Host::Ptr current_host_;
-  IOWorker* io_worker_;
+  Atomic<IOWorker*> io_worker_;
   Timer timer_;
   int running_executions_;
   RequestExecutionVec request_executions_;
@@ -216,6 +288,19 @@ private:
   Address preferred_address_;
   ResultMetadata::Ptr prepared_result_metadata_;
   RequestListener* listener_;
+  Atomic<bool> is_cancelled_;
+  bool is_stopped_;
+  bool is_pre_encoded_;
+  ResultCache::Ptr result_cache_;
+  std::string result_cache_key_;
+  std::string result_cache_keyspace_;
+  std::string result_cache_table_;
+  PartitionStats::Ptr partition_stats_;
+  PartitionStats::Sample partition_stats_sample_;
+  size_t response_size_;
+  StatementMetrics::Ptr statement_metrics_;
+  StatementMetrics::Entry::Ptr statement_metrics_entry_;
+  PagingReservation paging_reservation_;
 };
 
 class RequestExecution : public RequestCallback {
@@ -246,6 +331,7 @@ private:
 
 private:
   static void on_execute(Timer* timer);
+  static void on_retry(Timer* timer);
 
   virtual void on_start();
 
@@ -270,6 +356,7 @@ private:
   RequestHandler::Ptr request_handler_;
   Host::Ptr current_host_;
   Timer schedule_timer_;
+  Timer retry_timer_;
   int num_retries_;
   uint64_t start_time_ns_;
 };
@@ -134,12 +134,16 @@ ssize_t ResponseMessage::decode(char* input, size_t size) {
 
       is_header_received_ = true;
 
-      if (!allocate_body(opcode_) || !response_body_) {
-        return -1;
-      }
+      if (stream_ >= 0 && filter_ != NULL && filter_->is_discarded(stream_)) {
+        is_body_discarded_ = true;
+      } else {
+        if (!allocate_body(opcode_) || !response_body_) {
+          return -1;
+        }
 
-      response_body_->set_buffer(length_);
-      body_buffer_pos_ = response_body_->data();
+        response_body_->set_buffer(length_);
+        body_buffer_pos_ = response_body_->data();
+      }
     } else {
       // We haven't received all the data for the header. We consume the
       // entire buffer.
@@ -157,6 +161,12 @@ ssize_t ResponseMessage::decode(char* input, size_t size) {
     size_t overage = received_ - frame_size;
     size_t needed = remaining - overage;
 
+    if (is_body_discarded_) {
+      input_pos += needed;
+      is_body_ready_ = true;
+      return input_pos - input;
+    }
+
     memcpy(body_buffer_pos_, input_pos, needed);
     body_buffer_pos_ += needed;
     input_pos += needed;
@@ -181,8 +191,10 @@ ssize_t ResponseMessage::decode(char* input, size_t size) {
   } else {
     // We haven't received all the data for the frame. We consume the entire
     // buffer.
-    memcpy(body_buffer_pos_, input_pos, remaining);
-    body_buffer_pos_ += remaining;
+    if (!is_body_discarded_) {
+      memcpy(body_buffer_pos_, input_pos, remaining);
+      body_buffer_pos_ += remaining;
+    }
     return size;
   }
 
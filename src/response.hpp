@@ -76,8 +76,20 @@ private:
 
 class ResponseMessage {
 public:
-  ResponseMessage()
-      : version_(0)
+  /**
+   * Determines, once a response's header has been decoded, whether its body
+   * is needed. Unneeded bodies (e.g. for cancelled requests) are skipped
+   * without being copied or decoded.
+   */
+  class Filter {
+  public:
+    virtual ~Filter() { }
+    virtual bool is_discarded(int16_t stream) const = 0;
+  };
+
+  ResponseMessage(const Filter* filter = NULL)
+      : filter_(filter)
+      , version_(0)
       , flags_(0)
       , stream_(0)
       , opcode_(0)
@@ -88,6 +100,7 @@ public:
       , header_buffer_pos_(header_buffer_)
       , is_body_ready_(false)
       , is_body_error_(false)
+      , is_body_discarded_(false)
       , body_buffer_pos_(NULL) {}
 
   uint8_t floats() const { return flags_; }
@@ -96,16 +109,22 @@ public:
 
   int16_t stream() const { return stream_; }
 
+  int32_t length() const { return length_; }
+
   const Response::Ptr& response_body() { return response_body_; }
 
   bool is_body_ready() const { return is_body_ready_; }
 
+  // The body was skipped and the response body is empty
+  bool is_body_discarded() const { return is_body_discarded_; }
+
   ssize_t decode(char* input, size_t size);
 
 private:
   bool allocate_body(int8_t opcode);
 
 private:
+  const Filter* filter_;
   uint8_t version_;
   uint8_t flags_;
   int16_t stream_;
@@ -120,6 +139,7 @@ private:
 
   bool is_body_ready_;
   bool is_body_error_;
+  bool is_body_discarded_;
   Response::Ptr response_body_;
   char* body_buffer_pos_;
 
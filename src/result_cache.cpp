@@ -0,0 +1,165 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "result_cache.hpp"
+
+#include "constants.hpp"
+#include "execute_request.hpp"
+#include "hash.hpp"
+#include "scoped_lock.hpp"
+#include "serialization.hpp"
+
+#include <algorithm>
+
+namespace cass {
+
+ResultCache::Shard::Shard() {
+  entries.set_empty_key(std::string());
+  entries.set_deleted_key(std::string(1, '\0'));
+  uv_rwlock_init(&rwlock);
+}
+
+ResultCache::Shard::~Shard() {
+  uv_rwlock_destroy(&rwlock);
+}
+
+ResultCache::ResultCache(size_t max_entries, uint64_t ttl_ms)
+  : max_entries_per_shard_(std::max(static_cast<size_t>(1),
+                                    (max_entries + NUM_SHARDS - 1) / NUM_SHARDS))
+  , ttl_ns_(ttl_ms * 1000 * 1000)
+  , hits_(0)
+  , misses_(0)
+  , evictions_(0) { }
+
+ResultCache::~ResultCache() { }
+
+// Format: <prepared_id><consistency><page_size><paging_state><value_1>...<value_n>
+// where:
+// <prepared_id> and <paging_state> are [short bytes]/[bytes]
+// <value> is a [bytes] or an int32 of -2 for an unset value
+bool ResultCache::make_key(const ExecuteRequest* request, int32_t page_size,
+                           std::string* key) {
+  const std::string& id = request->prepared()->id();
+  const std::string& paging_state = request->paging_state();
+
+  char buf[sizeof(int32_t)];
+  key->reserve(id.size() + paging_state.size() + 64);
+
+  encode_uint16(buf, static_cast<uint16_t>(id.size()));
+  key->append(buf, sizeof(uint16_t));
+  key->append(id);
+
+  encode_uint16(buf, static_cast<uint16_t>(request->consistency()));
+  key->append(buf, sizeof(uint16_t));
+
+  encode_int32(buf, page_size);
+  key->append(buf, sizeof(int32_t));
+
+  encode_int32(buf, static_cast<int32_t>(paging_state.size()));
+  key->append(buf, sizeof(int32_t));
+  key->append(paging_state);
+
+  const AbstractData::ElementVec& elements = request->elements();
+  for (AbstractData::ElementVec::const_iterator i = elements.begin(),
+       end = elements.end(); i != end; ++i) {
+    if (i->is_unset()) {
+      // Distinct from a null value (a length of -1)
+      encode_int32(buf, -2);
+      key->append(buf, sizeof(int32_t));
+    } else {
+      Buffer value(i->get_buffer(CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION));
+      key->append(value.data(), value.size());
+    }
+  }
+
+  return true;
+}
+
+bool ResultCache::get(const std::string& key, Address* address, Response::Ptr* response) {
+  const Shard& s = shard(key);
+  {
+    ScopedReadLock rl(&s.rwlock);
+    Map::const_iterator i = s.entries.find(key);
+    if (i != s.entries.end() && uv_hrtime() < i->second.expires) {
+      *address = i->second.address;
+      *response = i->second.response;
+      rl.unlock();
+      hits_.fetch_add(1, MEMORY_ORDER_RELAXED);
+      return true;
+    }
+  }
+  misses_.fetch_add(1, MEMORY_ORDER_RELAXED);
+  return false;
+}
+
+void ResultCache::put(const std::string& key,
+                      const std::string& keyspace, const std::string& table,
+                      const Address& address, const Response::Ptr& response) {
+  Shard& s = shard(key);
+  uint64_t expires = uv_hrtime() + ttl_ns_;
+
+  ScopedWriteLock wl(&s.rwlock);
+
+  Map::iterator i = s.entries.find(key);
+  if (i != s.entries.end()) {
+    s.keys.erase(i->second.position);
+    s.entries.erase(i);
+  }
+
+  while (s.entries.size() >= max_entries_per_shard_) {
+    s.entries.erase(s.keys.front());
+    s.keys.pop_front();
+    evictions_.fetch_add(1, MEMORY_ORDER_RELAXED);
+  }
+
+  Entry& entry = s.entries[key];
+  entry.keyspace = keyspace;
+  entry.table = table;
+  entry.address = address;
+  entry.response = response;
+  entry.expires = expires;
+  entry.position = s.keys.insert(s.keys.end(), key);
+}
+
+void ResultCache::invalidate(const std::string& keyspace, const std::string& table) {
+  for (size_t n = 0; n < NUM_SHARDS; ++n) {
+    Shard& s = shards_[n];
+    ScopedWriteLock wl(&s.rwlock);
+    for (Map::iterator i = s.entries.begin(),
+         end = s.entries.end(); i != end; ++i) {
+      if (i->second.keyspace == keyspace &&
+          (table.empty() || i->second.table == table)) {
+        s.keys.erase(i->second.position);
+        s.entries.erase(i); // Doesn't invalidate the iterator
+      }
+    }
+  }
+}
+
+size_t ResultCache::size() const {
+  size_t size = 0;
+  for (size_t n = 0; n < NUM_SHARDS; ++n) {
+    ScopedReadLock rl(&shards_[n].rwlock);
+    size += shards_[n].entries.size();
+  }
+  return size;
+}
+
+ResultCache::Shard& ResultCache::shard(const std::string& key) {
+  return shards_[hash::fnv1a(key.data(), key.size()) % NUM_SHARDS];
+}
+
+} // namespace cass
@@ -0,0 +1,112 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_RESULT_CACHE_HPP_INCLUDED__
+#define __CASS_RESULT_CACHE_HPP_INCLUDED__
+
+#include "address.hpp"
+#include "atomic.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "response.hpp"
+
+#include <sparsehash/dense_hash_map>
+
+#include <list>
+#include <string>
+#include <uv.h>
+
+namespace cass {
+
+class ExecuteRequest;
+
+/**
+ * A size-bounded cache of the results of prepared reads. Entries are keyed
+ * by the prepared ID and the statement's bound values, expire after a fixed
+ * TTL and are evicted in insertion order when the cache is full. The cache is
+ * split into shards so that lookups only take a shared lock on a single
+ * shard and never wait on each other.
+ */
+class ResultCache : public RefCounted<ResultCache> {
+public:
+  typedef SharedRefPtr<ResultCache> Ptr;
+
+  ResultCache(size_t max_entries, uint64_t ttl_ms);
+  ~ResultCache();
+
+  // Builds the cache key for a prepared statement executed with the given
+  // page size. Returns false if the statement can't be cached.
+  static bool make_key(const ExecuteRequest* request, int32_t page_size,
+                       std::string* key);
+
+  bool get(const std::string& key, Address* address, Response::Ptr* response);
+
+  void put(const std::string& key,
+           const std::string& keyspace, const std::string& table,
+           const Address& address, const Response::Ptr& response);
+
+  // Removes the entries of a table, or all the entries of a keyspace if the
+  // table is empty.
+  void invalidate(const std::string& keyspace, const std::string& table);
+
+  size_t size() const;
+
+  uint64_t hits() const { return hits_.load(MEMORY_ORDER_RELAXED); }
+  uint64_t misses() const { return misses_.load(MEMORY_ORDER_RELAXED); }
+  uint64_t evictions() const { return evictions_.load(MEMORY_ORDER_RELAXED); }
+
+private:
+  static const size_t NUM_SHARDS = 16;
+
+  typedef std::list<std::string> KeyList;
+
+  struct Entry {
+    std::string keyspace;
+    std::string table;
+    Address address;
+    Response::Ptr response;
+    uint64_t expires;
+    KeyList::iterator position;
+  };
+
+  typedef sparsehash::dense_hash_map<std::string, Entry> Map;
+
+  struct Shard {
+    Shard();
+    ~Shard();
+
+    mutable uv_rwlock_t rwlock;
+    Map entries;
+    KeyList keys; // Insertion order
+  };
+
+  Shard& shard(const std::string& key);
+
+  const size_t max_entries_per_shard_;
+  const uint64_t ttl_ns_;
+  Shard shards_[NUM_SHARDS];
+
+  Atomic<uint64_t> hits_;
+  Atomic<uint64_t> misses_;
+  Atomic<uint64_t> evictions_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ResultCache);
+};
+
+} // namespace cass
+
+#endif
@@ -45,7 +45,9 @@ public:
       , kind_(CASS_RESULT_KIND_VOID)
       , has_more_pages_(false)
       , row_count_(0)
-      , rows_(NULL) {
+      , rows_(NULL)
+      , size_(0)
+      , latency_ns_(0) {
     first_row_.set_result(this);
   }
 
@@ -85,6 +87,16 @@ public:
 
   const PKIndexVec& pk_indices() const { return pk_indices_; }
 
+  // The size of the response's body and the time it took to receive it.
+  // Only set for results received from the cluster (not for cached results).
+  size_t size() const { return size_; }
+  uint64_t latency_ns() const { return latency_ns_; }
+
+  void set_received(size_t size, uint64_t latency_ns) {
+    size_ = size;
+    latency_ns_ = latency_ns;
+  }
+
   bool decode(int version, char* input, size_t size);
 
 private:
@@ -119,6 +131,8 @@ private:
   char* rows_;
   Row first_row_;
   PKIndexVec pk_indices_;
+  size_t size_;
+  uint64_t latency_ns_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ResultResponse);
@@ -19,6 +19,9 @@
 #include "external.hpp"
 #include "logger.hpp"
 #include "request.hpp"
+#include "scoped_lock.hpp"
+
+#include <algorithm>
 
 extern "C" {
 
@@ -51,6 +54,28 @@ CassRetryPolicy* cass_retry_policy_logging_new(CassRetryPolicy* child_retry_poli
   return CassRetryPolicy::to(policy);
 }
 
+CassRetryPolicy* cass_retry_policy_budget_new(CassRetryPolicy* child_retry_policy,
+                                              cass_double_t retry_ratio,
+                                              unsigned max_retries,
+                                              cass_uint64_t base_delay_ms,
+                                              cass_uint64_t max_delay_ms) {
+  if (child_retry_policy->type() == cass::RetryPolicy::BUDGET ||
+      retry_ratio < 0.0 || max_delay_ms < base_delay_ms) {
+    return NULL;
+  }
+  cass::BudgetRetryPolicy::Settings settings;
+  settings.retry_ratio = retry_ratio;
+  settings.max_tokens = max_retries;
+  settings.base_delay_ms = base_delay_ms;
+  settings.max_delay_ms = max_delay_ms;
+  cass::RetryPolicy* policy
+      = new cass::BudgetRetryPolicy(
+          cass::SharedRefPtr<cass::RetryPolicy>(child_retry_policy),
+          settings);
+  policy->inc_ref();
+  return CassRetryPolicy::to(policy);
+}
+
 void cass_retry_policy_free(CassRetryPolicy* policy) {
   policy->dec_ref();
 }
@@ -319,4 +344,169 @@ RetryPolicy::RetryDecision LoggingRetryPolicy::on_request_error(const Request* r
   return decision;
 }
 
+RetryPolicy* LoggingRetryPolicy::new_instance() {
+  return new LoggingRetryPolicy(RetryPolicy::Ptr(retry_policy_->new_instance()));
+}
+
+bool LoggingRetryPolicy::has_retry_budget() const {
+  return retry_policy_->has_retry_budget();
+}
+
+void LoggingRetryPolicy::on_success(const Address& address) const {
+  retry_policy_->on_success(address);
+}
+
+bool LoggingRetryPolicy::acquire_retry(const Address& address) const {
+  if (!retry_policy_->acquire_retry(address)) {
+    LOG_INFO("Retry budget exhausted for host %s", address.to_string().c_str());
+    return false;
+  }
+  return true;
+}
+
+uint64_t LoggingRetryPolicy::retry_delay_ms(int num_retries) const {
+  return retry_policy_->retry_delay_ms(num_retries);
+}
+
+void LoggingRetryPolicy::on_host_removed(const Address& address) const {
+  retry_policy_->on_host_removed(address);
+}
+
+// Budget retry policy
+
+#define TOKEN_SCALE 1000
+
+void BudgetRetryPolicy::TokenBucket::deposit(int64_t amount, int64_t max) {
+  int64_t tokens = tokens_.load();
+  while (tokens < max) {
+    int64_t next = std::min(tokens + amount, max);
+    if (tokens_.compare_exchange_weak(tokens, next)) break;
+  }
+}
+
+bool BudgetRetryPolicy::TokenBucket::withdraw(int64_t amount) {
+  int64_t tokens = tokens_.load();
+  while (tokens >= amount) {
+    if (tokens_.compare_exchange_weak(tokens, tokens - amount)) return true;
+  }
+  return false;
+}
+
+BudgetRetryPolicy::BudgetRetryPolicy(const RetryPolicy::Ptr& retry_policy,
+                                     const Settings& settings)
+  : RetryPolicy(BUDGET)
+  , retry_policy_(retry_policy)
+  , settings_(settings)
+  , deposit_amount_(static_cast<int64_t>(settings.retry_ratio * TOKEN_SCALE + 0.5))
+  , max_amount_(static_cast<int64_t>(settings.max_tokens) * TOKEN_SCALE)
+  , session_bucket_(max_amount_)
+  , random_state_(uv_hrtime()) {
+  host_buckets_.set_empty_key(Address::EMPTY_KEY);
+  host_buckets_.set_deleted_key(Address::DELETED_KEY);
+  uv_rwlock_init(&rwlock_);
+}
+
+BudgetRetryPolicy::~BudgetRetryPolicy() {
+  uv_rwlock_destroy(&rwlock_);
+}
+
+RetryPolicy::RetryDecision BudgetRetryPolicy::on_read_timeout(const Request* request, CassConsistency cl,
+                                                              int received, int required,
+                                                              bool data_recevied, int num_retries) const {
+  return retry_policy_->on_read_timeout(request, cl, received, required, data_recevied, num_retries);
+}
+
+RetryPolicy::RetryDecision BudgetRetryPolicy::on_write_timeout(const Request* request, CassConsistency cl,
+                                                               int received, int required,
+                                                               CassWriteType write_type, int num_retries) const {
+  return retry_policy_->on_write_timeout(request, cl, received, required, write_type, num_retries);
+}
+
+RetryPolicy::RetryDecision BudgetRetryPolicy::on_unavailable(const Request* request, CassConsistency cl,
+                                                             int required, int alive,
+                                                             int num_retries) const {
+  return retry_policy_->on_unavailable(request, cl, required, alive, num_retries);
+}
+
+RetryPolicy::RetryDecision BudgetRetryPolicy::on_request_error(const Request* request, CassConsistency cl,
+                                                               const ErrorResponse* error, int num_retries) const {
+  return retry_policy_->on_request_error(request, cl, error, num_retries);
+}
+
+RetryPolicy* BudgetRetryPolicy::new_instance() {
+  return new BudgetRetryPolicy(RetryPolicy::Ptr(retry_policy_->new_instance()),
+                               settings_);
+}
+
+bool BudgetRetryPolicy::has_retry_budget() const {
+  return true;
+}
+
+void BudgetRetryPolicy::on_success(const Address& address) const {
+  session_bucket_.deposit(deposit_amount_, max_amount_);
+  host_bucket(address)->deposit(deposit_amount_, max_amount_);
+  retry_policy_->on_success(address);
+}
+
+bool BudgetRetryPolicy::acquire_retry(const Address& address) const {
+  if (!retry_policy_->acquire_retry(address)) return false;
+
+  TokenBucket::Ptr bucket(host_bucket(address));
+  if (!bucket->withdraw(TOKEN_SCALE)) return false;
+  if (!session_bucket_.withdraw(TOKEN_SCALE)) {
+    // Return the host's token because the retry is denied
+    bucket->deposit(TOKEN_SCALE, max_amount_);
+    return false;
+  }
+  return true;
+}
+
+uint64_t BudgetRetryPolicy::retry_delay_ms(int num_retries) const {
+  if (settings_.base_delay_ms == 0) {
+    return retry_policy_->retry_delay_ms(num_retries);
+  }
+
+  // Exponential backoff capped at the max delay. Half of the delay is
+  // randomized (jitter) so that retries from multiple requests that failed
+  // at the same time are spread out.
+  uint64_t delay = settings_.base_delay_ms << std::min(num_retries, 20);
+  if (delay > settings_.max_delay_ms) {
+    delay = settings_.max_delay_ms;
+  }
+  uint64_t half = delay / 2;
+  return half + next_random() % (delay - half + 1);
+}
+
+void BudgetRetryPolicy::on_host_removed(const Address& address) const {
+  { // Write lock
+    ScopedWriteLock wl(&rwlock_);
+    host_buckets_.erase(address);
+  }
+  retry_policy_->on_host_removed(address);
+}
+
+BudgetRetryPolicy::TokenBucket::Ptr BudgetRetryPolicy::host_bucket(const Address& address) const {
+  { // Read lock
+    ScopedReadLock rl(&rwlock_);
+    TokenBucketMap::const_iterator it = host_buckets_.find(address);
+    if (it != host_buckets_.end()) return it->second;
+  }
+
+  // Write lock
+  ScopedWriteLock wl(&rwlock_);
+  TokenBucket::Ptr& bucket = host_buckets_[address];
+  if (!bucket) {
+    bucket.reset(new TokenBucket(max_amount_));
+  }
+  return bucket;
+}
+
+uint64_t BudgetRetryPolicy::next_random() const {
+  // SplitMix64: each call gets a unique state so this is thread-safe
+  uint64_t z = random_state_.fetch_add(0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
 } // namespace cass
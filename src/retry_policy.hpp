@@ -17,11 +17,16 @@
 #ifndef __CASS_RETRY_POLICY_HPP_INCLUDED__
 #define __CASS_RETRY_POLICY_HPP_INCLUDED__
 
+#include "address.hpp"
+#include "atomic.hpp"
 #include "cassandra.h"
 #include "error_response.hpp"
 #include "external.hpp"
 #include "ref_counted.hpp"
 
+#include <sparsehash/dense_hash_map>
+#include <uv.h>
+
 #ifdef _WIN32
 # ifdef IGNORE
 #   undef IGNORE
@@ -41,7 +46,8 @@ public:
     DEFAULT,
     DOWNGRADING,
     FALLTHROUGH,
-    LOGGING
+    LOGGING,
+    BUDGET
   };
 
   class RetryDecision {
@@ -102,6 +108,22 @@ public:
   virtual RetryDecision on_request_error(const Request* request, CassConsistency cl,
                                          const ErrorResponse* error, int num_retries) const = 0;
 
+  // Returns the instance used by a session. Policies that keep state
+  // (e.g. retry budgets) return a new instance so that the state isn't
+  // shared between sessions.
+  virtual RetryPolicy* new_instance() { return this; }
+
+  // The following are used to limit retries (see BudgetRetryPolicy). They're
+  // called on the I/O worker threads. By default, retries are unlimited and
+  // sent immediately.
+  virtual bool has_retry_budget() const { return false; }
+  virtual void on_success(const Address& address) const { }
+  virtual bool acquire_retry(const Address& address) const { return true; }
+  virtual uint64_t retry_delay_ms(int num_retries) const { return 0; }
+
+  // Called on the session thread when a host is removed from the cluster
+  virtual void on_host_removed(const Address& address) const { }
+
 private:
   Type type_;
 };
@@ -178,8 +200,94 @@ public:
   virtual RetryDecision on_request_error(const Request* request, CassConsistency cl,
                                          const ErrorResponse* response, int num_retries) const;
 
+  virtual RetryPolicy* new_instance();
+
+  virtual bool has_retry_budget() const;
+  virtual void on_success(const Address& address) const;
+  virtual bool acquire_retry(const Address& address) const;
+  virtual uint64_t retry_delay_ms(int num_retries) const;
+
+  virtual void on_host_removed(const Address& address) const;
+
+private:
+  RetryPolicy::Ptr retry_policy_;
+};
+
+class BudgetRetryPolicy : public RetryPolicy {
+public:
+  struct Settings {
+    Settings()
+      : retry_ratio(0.1)
+      , max_tokens(10)
+      , base_delay_ms(0)
+      , max_delay_ms(0) { }
+
+    // The number of retries earned by each successful request
+    double retry_ratio;
+    // The maximum number of retries that can be accumulated (the burst size)
+    unsigned max_tokens;
+    // The exponential backoff delays. No delay is used if base_delay_ms is 0.
+    uint64_t base_delay_ms;
+    uint64_t max_delay_ms;
+  };
+
+  BudgetRetryPolicy(const RetryPolicy::Ptr& retry_policy,
+                    const Settings& settings = Settings());
+  ~BudgetRetryPolicy();
+
+  const Settings& settings() const { return settings_; }
+
+  virtual RetryDecision on_read_timeout(const Request* request, CassConsistency cl,
+                                        int received, int required,
+                                        bool data_recevied, int num_retries) const;
+  virtual RetryDecision on_write_timeout(const Request* request, CassConsistency cl,
+                                         int received, int required,
+                                         CassWriteType write_type, int num_retries) const;
+  virtual RetryDecision on_unavailable(const Request* request, CassConsistency cl,
+                                       int required, int alive,
+                                       int num_retries) const;
+  virtual RetryDecision on_request_error(const Request* request, CassConsistency cl,
+                                         const ErrorResponse* response, int num_retries) const;
+
+  virtual RetryPolicy* new_instance();
+
+  virtual bool has_retry_budget() const;
+  virtual void on_success(const Address& address) const;
+  virtual bool acquire_retry(const Address& address) const;
+  virtual uint64_t retry_delay_ms(int num_retries) const;
+
+  virtual void on_host_removed(const Address& address) const;
+
+private:
+  // Tokens are stored in thousandths so that fractional ratios can be used
+  class TokenBucket : public RefCounted<TokenBucket> {
+  public:
+    typedef SharedRefPtr<TokenBucket> Ptr;
+
+    TokenBucket(int64_t tokens)
+      : tokens_(tokens) { }
+
+    void deposit(int64_t amount, int64_t max);
+    bool withdraw(int64_t amount);
+
+  private:
+    Atomic<int64_t> tokens_;
+  };
+
+  typedef sparsehash::dense_hash_map<Address, TokenBucket::Ptr, AddressHash> TokenBucketMap;
+
+  TokenBucket::Ptr host_bucket(const Address& address) const;
+  uint64_t next_random() const;
+
 private:
   RetryPolicy::Ptr retry_policy_;
+  const Settings settings_;
+  const int64_t deposit_amount_;
+  const int64_t max_amount_;
+  mutable TokenBucket session_bucket_;
+  mutable TokenBucketMap host_buckets_;
+  mutable uv_rwlock_t rwlock_;
+  mutable Atomic<uint64_t> random_state_;
 };
 
 } // namespace cass
@@ -0,0 +1,211 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_SCHEMA_AGREEMENT_SCHEDULER_HPP_INCLUDED__
+#define __CASS_SCHEMA_AGREEMENT_SCHEDULER_HPP_INCLUDED__
+
+#include "logger.hpp"
+#include "macros.hpp"
+
+#include <algorithm>
+#include <stdint.h>
+#include <vector>
+
+namespace cass {
+
+// Schedules the schema agreement checks of a connection. All the schema
+// change requests waiting on the connection share a single check and
+// requests that start waiting during a check are covered by the next check,
+// which starts as soon as the current one finishes. If the live nodes don't
+// agree yet the check is retried with a backoff, or right away once a schema
+// change event is received. Each waiter is returned after at most
+// MAX_WAIT_MS whether or not the nodes agree.
+//
+// The checks and the retry timer are provided by the handler (the
+// connection). A waiter must provide:
+//
+//   uint64_t start_ms;               // When the waiter started waiting
+//   bool is_cancelled() const;       // Stops waiting without a response
+//   void set_response() const;       // Returns the schema change response
+//
+// This must only be used from the connection's event loop thread.
+template <class Waiter>
+class SchemaAgreementScheduler {
+public:
+  static const uint64_t MIN_RETRY_MS = 10;
+  static const uint64_t MAX_RETRY_MS = 200;
+  static const uint64_t MAX_WAIT_MS = 10000;
+
+  typedef std::vector<Waiter> WaiterVec;
+
+  class Handler {
+  public:
+    virtual ~Handler() { }
+
+    // Starts a check for the waiters; they are moved into the check.
+    // on_checked() must be called with them once it's done.
+    virtual void on_check_schema_agreement(WaiterVec* waiters) = 0;
+
+    virtual void on_start_schema_agreement_timer(uint64_t delay_ms) = 0;
+    virtual void on_stop_schema_agreement_timer() = 0;
+  };
+
+  explicit SchemaAgreementScheduler(Handler* handler)
+    : handler_(handler)
+    , is_checking_(false)
+    , is_timer_running_(false)
+    , has_schema_change_event_(false)
+    , retry_ms_(MIN_RETRY_MS) { }
+
+  void add(const Waiter& waiter) {
+    waiters_.push_back(waiter);
+    if (!is_checking_) {
+      // A new schema change may have been propagated already so don't wait
+      // for a pending retry.
+      stop_timer();
+      retry_ms_ = MIN_RETRY_MS;
+      check();
+    }
+  }
+
+  // Returns the responses of the checked waiters that are done and
+  // schedules the next check for the rest. No more checks are scheduled if
+  // the connection is closing; the waiters are returned by close().
+  void on_checked(bool has_agreement, bool has_error,
+                  uint64_t now_ms, bool is_closing,
+                  WaiterVec* checked) {
+    is_checking_ = false;
+
+    WaiterVec remaining;
+    for (typename WaiterVec::const_iterator it = checked->begin(),
+         end = checked->end(); it != end; ++it) {
+      // Don't wait for schema agreement if the underlying request is cancelled
+      if (it->is_cancelled()) {
+        continue;
+      }
+
+      uint64_t elapsed_ms = now_ms - it->start_ms;
+      if (has_error) {
+        // Return the response without waiting any longer
+        it->set_response();
+      } else if (has_agreement) {
+        LOG_DEBUG("Found schema agreement in %llu ms",
+                  static_cast<unsigned long long>(elapsed_ms));
+        it->set_response();
+      } else if (elapsed_ms >= MAX_WAIT_MS) {
+        LOG_WARN("No schema agreement on live nodes after %llu ms. "
+                 "Schema may not be up-to-date on some nodes.",
+                 static_cast<unsigned long long>(elapsed_ms));
+        it->set_response();
+      } else {
+        remaining.push_back(*it);
+      }
+    }
+    checked->clear();
+
+    bool has_new_waiters = !waiters_.empty();
+    waiters_.insert(waiters_.end(), remaining.begin(), remaining.end());
+    if (waiters_.empty() || is_closing) {
+      return;
+    }
+
+    if (has_new_waiters) {
+      retry_ms_ = MIN_RETRY_MS;
+      check();
+    } else if (has_schema_change_event_) {
+      check();
+    } else {
+      LOG_DEBUG("Schema still not up-to-date on some live nodes. "
+                "Trying again in %llu ms",
+                static_cast<unsigned long long>(retry_ms_));
+      is_timer_running_ = true;
+      handler_->on_start_schema_agreement_timer(retry_ms_);
+      // Back off while the schema is still propagating
+      retry_ms_ = std::min(retry_ms_ * 2, MAX_RETRY_MS);
+    }
+  }
+
+  void on_timer() {
+    is_timer_running_ = false;
+    check();
+  }
+
+  // Runs a pending check immediately instead of waiting for the retry timer
+  void on_schema_change_event() {
+    if (is_checking_) {
+      has_schema_change_event_ = true;
+    } else if (is_timer_running_) {
+      stop_timer();
+      check();
+    }
+  }
+
+  // Returns the responses of the waiters without waiting for agreement
+  void close() {
+    stop_timer();
+    if (waiters_.empty()) return;
+    LOG_WARN("Connection closed while waiting for schema agreement");
+    for (typename WaiterVec::const_iterator it = waiters_.begin(),
+         end = waiters_.end(); it != end; ++it) {
+      if (!it->is_cancelled()) {
+        it->set_response();
+      }
+    }
+    waiters_.clear();
+  }
+
+  bool is_checking() const { return is_checking_; }
+  bool is_timer_running() const { return is_timer_running_; }
+  size_t waiter_count() const { return waiters_.size(); }
+
+private:
+  void check() {
+    is_checking_ = true;
+    has_schema_change_event_ = false;
+    handler_->on_check_schema_agreement(&waiters_);
+  }
+
+  void stop_timer() {
+    if (is_timer_running_) {
+      is_timer_running_ = false;
+      handler_->on_stop_schema_agreement_timer();
+    }
+  }
+
+private:
+  Handler* handler_;
+  WaiterVec waiters_;
+  bool is_checking_;
+  bool is_timer_running_;
+  bool has_schema_change_event_;
+  uint64_t retry_ms_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(SchemaAgreementScheduler);
+};
+
+template <class Waiter>
+const uint64_t SchemaAgreementScheduler<Waiter>::MIN_RETRY_MS;
+
+template <class Waiter>
+const uint64_t SchemaAgreementScheduler<Waiter>::MAX_RETRY_MS;
+
+template <class Waiter>
+const uint64_t SchemaAgreementScheduler<Waiter>::MAX_WAIT_MS;
+
+} // namespace cass
+
+#endif
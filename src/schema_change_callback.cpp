@@ -29,20 +29,28 @@
 #include <iomanip>
 #include <sstream>
 
-#define MAX_SCHEMA_AGREEMENT_WAIT_MS 10000
-#define RETRY_SCHEMA_AGREEMENT_WAIT_MS 200
-
 namespace cass {
 
+SchemaChangeCallback::Waiter::Waiter(const RequestExecution::Ptr& request_execution,
+                                     const Response::Ptr& response)
+  : request_execution(request_execution)
+  , response(response)
+  , start_ms(get_time_since_epoch_ms()) { }
+
+bool SchemaChangeCallback::Waiter::is_cancelled() const {
+  return request_execution->state() == RequestCallback::REQUEST_STATE_CANCELLED;
+}
+
+void SchemaChangeCallback::Waiter::set_response() const {
+  request_execution->set_response(response);
+}
+
 SchemaChangeCallback::SchemaChangeCallback(Connection* connection,
-                                           const RequestExecution::Ptr& request_execution,
-                                           const Response::Ptr& response,
-                                           uint64_t elapsed)
+                                           WaiterVec* waiters)
   : MultipleRequestCallback(connection)
-  , request_execution_(request_execution)
-  , request_response_(response)
-  , start_ms_(get_time_since_epoch_ms())
-  , elapsed_ms_(elapsed) {}
+  , is_finished_(false) {
+  waiters_.swap(*waiters);
+}
 
 void SchemaChangeCallback::execute() {
   execute_query("local", "SELECT schema_version FROM system.local WHERE key='local'");
@@ -67,6 +75,9 @@ bool SchemaChangeCallback::has_schema_agreement(const ResponseMap& responses) {
               connection()->address_string().c_str());
   }
 
+  // All the waiters' requests were executed by the same IO worker
+  const RequestExecution::Ptr& request_execution = waiters_.front().request_execution;
+
   ResultResponse* peers_result;
   if (MultipleRequestCallback::get_result_response(responses, "peers", &peers_result)) {
     ResultIterator rows(peers_result);
@@ -80,7 +91,7 @@ bool SchemaChangeCallback::has_schema_agreement(const ResponseMap& responses) {
                                                                row->get_by_name("rpc_address"),
                                                                &address);
 
-      if (is_valid_address && request_execution_->is_host_up(address)) {
+      if (is_valid_address && request_execution->is_host_up(address)) {
         const Value* v = row->get_by_name("schema_version");
         if (!row->get_by_name("rpc_address")->is_null() && !v->is_null()) {
           StringRef version(v->to_string_ref());
@@ -95,14 +106,13 @@ bool SchemaChangeCallback::has_schema_agreement(const ResponseMap& responses) {
   return true;
 }
 
-void SchemaChangeCallback::on_set(const ResponseMap& responses) {
-  // Don't wait for schema agreement if the underlying request is cancelled
-  if (request_execution_->state() == RequestCallback::REQUEST_STATE_CANCELLED) {
-    return;
-  }
-
-  elapsed_ms_ += get_time_since_epoch_ms() - start_ms_;
+void SchemaChangeCallback::finish(bool has_agreement, bool has_error) {
+  if (is_finished_) return;
+  is_finished_ = true;
+  connection()->on_schema_agreement_checked(has_agreement, has_error, &waiters_);
+}
 
+void SchemaChangeCallback::on_set(const ResponseMap& responses) {
   bool has_error = false;
   for (MultipleRequestCallback::ResponseMap::const_iterator it = responses.begin(),
        end = responses.end(); it != end; ++it) {
@@ -111,30 +121,7 @@ void SchemaChangeCallback::on_set(const ResponseMap& responses) {
     }
   }
 
-  if (!has_error && has_schema_agreement(responses)) {
-    LOG_DEBUG("Found schema agreement in %llu ms",
-              static_cast<unsigned long long>(elapsed_ms_));
-    request_execution_->set_response(request_response_);
-    return;
-  } else if (elapsed_ms_ >= MAX_SCHEMA_AGREEMENT_WAIT_MS) {
-    LOG_WARN("No schema agreement on live nodes after %llu ms. "
-             "Schema may not be up-to-date on some nodes.",
-             static_cast<unsigned long long>(elapsed_ms_));
-    request_execution_->set_response(request_response_);
-    return;
-  }
-
-  LOG_DEBUG("Schema still not up-to-date on some live nodes. "
-            "Trying again in %d ms", RETRY_SCHEMA_AGREEMENT_WAIT_MS);
-
-  // Try again
-  Ptr callback(
-        new SchemaChangeCallback(connection(),
-                                 request_execution_,
-                                 request_response_,
-                                 elapsed_ms_));
-  connection()->schedule_schema_agreement(callback,
-                                          RETRY_SCHEMA_AGREEMENT_WAIT_MS);
+  finish(!has_error && has_schema_agreement(responses), false);
 }
 
 void SchemaChangeCallback::on_error(CassError code, const std::string& message) {
@@ -142,17 +129,12 @@ void SchemaChangeCallback::on_error(CassError code, const std::string& message)
   ss << "An error occurred waiting for schema agreement: '" << message
      << "' (0x" << std::hex << std::uppercase << std::setw(8) << std::setfill('0') << code << ")";
   LOG_ERROR("%s", ss.str().c_str());
-  request_execution_->set_response(request_response_);
+  finish(false, true);
 }
 
 void SchemaChangeCallback::on_timeout() {
   LOG_ERROR("A timeout occurred waiting for schema agreement");
-  request_execution_->set_response(request_response_);
-}
-
-void SchemaChangeCallback::on_closing() {
-  LOG_WARN("Connection closed while waiting for schema agreement");
-  request_execution_->set_response(request_response_);
+  finish(false, true);
 }
 
 } // namespace cass
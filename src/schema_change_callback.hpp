@@ -19,39 +19,57 @@
 
 #include "ref_counted.hpp"
 #include "request_handler.hpp"
+#include "schema_agreement_scheduler.hpp"
 #include "scoped_ptr.hpp"
 #include "string_ref.hpp"
 
 #include <uv.h>
+#include <vector>
 
 namespace cass {
 
 class Connection;
 class Response;
 
+// A schema agreement check that is shared by all the schema change requests
+// waiting on the same connection. Once the check is done the waiters are
+// handed back to the connection's scheduler which returns their responses
+// or schedules the next check.
 class SchemaChangeCallback : public MultipleRequestCallback {
 public:
   typedef SharedRefPtr<SchemaChangeCallback> Ptr;
 
+  struct Waiter {
+    Waiter(const RequestExecution::Ptr& request_execution,
+           const Response::Ptr& response);
+
+    bool is_cancelled() const;
+    void set_response() const;
+
+    RequestExecution::Ptr request_execution;
+    Response::Ptr response;
+    uint64_t start_ms;
+  };
+
+  typedef SchemaAgreementScheduler<Waiter> Scheduler;
+  typedef Scheduler::WaiterVec WaiterVec;
+
+  // The waiters are moved into the check
   SchemaChangeCallback(Connection* connection,
-                      const RequestExecution::Ptr& request_execution,
-                      const Response::Ptr& response,
-                      uint64_t elapsed = 0);
+                       WaiterVec* waiters);
 
   void execute();
 
   virtual void on_set(const ResponseMap& responses);
   virtual void on_error(CassError code, const std::string& message);
   virtual void on_timeout();
-  void on_closing();
 
 private:
   bool has_schema_agreement(const ResponseMap& responses);
+  void finish(bool has_agreement, bool has_error);
 
-  RequestExecution::Ptr request_execution_;
-  Response::Ptr request_response_;
-  uint64_t start_ms_;
-  uint64_t elapsed_ms_;
+  WaiterVec waiters_;
+  bool is_finished_;
 };
 
 } // namespace cass
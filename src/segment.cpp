@@ -0,0 +1,253 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "segment.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <string.h>
+
+#define SEGMENT_CRC24_INIT 0x875060
+#define SEGMENT_CRC24_POLY 0x1974F0B
+#define SEGMENT_SELF_CONTAINED_FLAG (1 << 17)
+
+namespace {
+
+// The CRC32 is seeded with these bytes so that a zeroed payload doesn't
+// have a zero checksum
+const uint8_t CRC32_INITIAL_BYTES[] = { 0xFA, 0x2D, 0x55, 0xCA };
+
+class Crc32Table {
+public:
+  Crc32Table() {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int j = 0; j < 8; ++j) {
+        crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320U : crc >> 1;
+      }
+      table_[i] = crc;
+    }
+  }
+
+  uint32_t update(uint32_t crc, const uint8_t* data, size_t size) const {
+    for (size_t i = 0; i < size; ++i) {
+      crc = table_[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+  }
+
+private:
+  uint32_t table_[256];
+};
+
+const Crc32Table crc32_table;
+
+void encode_uint24_le(char* output, uint32_t value) {
+  output[0] = static_cast<char>(value & 0xFF);
+  output[1] = static_cast<char>((value >> 8) & 0xFF);
+  output[2] = static_cast<char>((value >> 16) & 0xFF);
+}
+
+uint32_t decode_uint24_le(const char* input) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(input);
+  return static_cast<uint32_t>(bytes[0]) |
+         static_cast<uint32_t>(bytes[1]) << 8 |
+         static_cast<uint32_t>(bytes[2]) << 16;
+}
+
+void encode_uint32_le(char* output, uint32_t value) {
+  encode_uint24_le(output, value);
+  output[3] = static_cast<char>((value >> 24) & 0xFF);
+}
+
+uint32_t decode_uint32_le(const char* input) {
+  return decode_uint24_le(input) |
+         static_cast<uint32_t>(static_cast<uint8_t>(input[3])) << 24;
+}
+
+// Copies the contents of a sequence of buffers
+class BufferCursor {
+public:
+  BufferCursor(const cass::BufferVec& buffers)
+    : it_(buffers.begin())
+    , end_(buffers.end())
+    , offset_(0) { }
+
+  void copy(char* output, size_t size) {
+    while (size > 0) {
+      assert(it_ != end_);
+      size_t to_copy = std::min(size, it_->size() - offset_);
+      memcpy(output, it_->data() + offset_, to_copy);
+      output += to_copy;
+      size -= to_copy;
+      offset_ += to_copy;
+      if (offset_ == it_->size()) {
+        ++it_;
+        offset_ = 0;
+      }
+    }
+  }
+
+private:
+  cass::BufferVec::const_iterator it_;
+  cass::BufferVec::const_iterator end_;
+  size_t offset_;
+};
+
+void encode_segment(BufferCursor* cursor, size_t payload_size, bool is_self_contained,
+                    cass::BufferVec* segments) {
+  using cass::Segment;
+
+  cass::Buffer segment(Segment::HEADER_SIZE + payload_size + Segment::TRAILER_SIZE);
+  char* data = segment.data();
+
+  uint32_t header = static_cast<uint32_t>(payload_size);
+  if (is_self_contained) header |= SEGMENT_SELF_CONTAINED_FLAG;
+  encode_uint24_le(data, header);
+  encode_uint24_le(data + 3, Segment::crc24(header, 3));
+
+  char* payload = data + Segment::HEADER_SIZE;
+  cursor->copy(payload, payload_size);
+  encode_uint32_le(payload + payload_size, Segment::crc32(payload, payload_size));
+
+  segments->push_back(segment);
+}
+
+} // namespace
+
+namespace cass {
+
+const size_t Segment::HEADER_SIZE;
+const size_t Segment::TRAILER_SIZE;
+const size_t Segment::MAX_PAYLOAD_SIZE;
+
+void Segment::encode(const BufferVec& frames,
+                     const FrameSizeVec& frame_sizes,
+                     BufferVec* segments) {
+  BufferCursor cursor(frames);
+  size_t payload_size = 0;
+
+  for (FrameSizeVec::const_iterator i = frame_sizes.begin(),
+       end = frame_sizes.end(); i != end; ++i) {
+    size_t frame_size = *i;
+
+    if (payload_size + frame_size > MAX_PAYLOAD_SIZE && payload_size > 0) {
+      encode_segment(&cursor, payload_size, true, segments);
+      payload_size = 0;
+    }
+
+    if (frame_size > MAX_PAYLOAD_SIZE) {
+      // Large frames are split across several segments
+      while (frame_size > 0) {
+        size_t size = std::min(frame_size, MAX_PAYLOAD_SIZE);
+        encode_segment(&cursor, size, false, segments);
+        frame_size -= size;
+      }
+    } else {
+      payload_size += frame_size;
+    }
+  }
+
+  if (payload_size > 0) {
+    encode_segment(&cursor, payload_size, true, segments);
+  }
+}
+
+uint32_t Segment::crc24(uint64_t value, size_t length) {
+  uint32_t crc = SEGMENT_CRC24_INIT;
+  while (length-- > 0) {
+    crc ^= static_cast<uint32_t>(value & 0xFF) << 16;
+    value >>= 8;
+    for (int i = 0; i < 8; ++i) {
+      crc <<= 1;
+      if (crc & 0x1000000) crc ^= SEGMENT_CRC24_POLY;
+    }
+  }
+  return crc;
+}
+
+uint32_t Segment::crc32(const char* data, size_t size) {
+  uint32_t crc = crc32_table.update(0xFFFFFFFFU, CRC32_INITIAL_BYTES,
+                                    sizeof(CRC32_INITIAL_BYTES));
+  crc = crc32_table.update(crc, reinterpret_cast<const uint8_t*>(data), size);
+  return crc ^ 0xFFFFFFFFU;
+}
+
+ssize_t SegmentDecoder::decode(const char* input, size_t size) {
+  if (is_payload_ready_) {
+    is_payload_ready_ = false;
+    payload_ = NULL;
+    buffer_.clear();
+  }
+
+  // Avoid copying segments that are completely contained in the input
+  if (buffer_.empty() && size >= Segment::HEADER_SIZE) {
+    if (!decode_header(input)) return -1;
+    size_t segment_size = Segment::HEADER_SIZE + payload_size_ + Segment::TRAILER_SIZE;
+    if (size >= segment_size) {
+      if (!verify_payload(input + Segment::HEADER_SIZE)) return -1;
+      payload_ = input + Segment::HEADER_SIZE;
+      is_payload_ready_ = true;
+      return segment_size;
+    }
+  }
+
+  size_t consumed = 0;
+  while (consumed < size) {
+    size_t needed = buffer_.size() < Segment::HEADER_SIZE
+                    ? Segment::HEADER_SIZE
+                    : Segment::HEADER_SIZE + payload_size_ + Segment::TRAILER_SIZE;
+    size_t to_copy = std::min(needed - buffer_.size(), size - consumed);
+    buffer_.append(input + consumed, to_copy);
+    consumed += to_copy;
+
+    if (buffer_.size() < needed) break;
+
+    if (needed == Segment::HEADER_SIZE) {
+      if (!decode_header(buffer_.data())) return -1;
+      buffer_.reserve(Segment::HEADER_SIZE + payload_size_ + Segment::TRAILER_SIZE);
+    } else {
+      if (!verify_payload(buffer_.data() + Segment::HEADER_SIZE)) return -1;
+      payload_ = buffer_.data() + Segment::HEADER_SIZE;
+      is_payload_ready_ = true;
+      break;
+    }
+  }
+
+  return consumed;
+}
+
+bool SegmentDecoder::decode_header(const char* header) {
+  uint32_t value = decode_uint24_le(header);
+  if (Segment::crc24(value, 3) != decode_uint24_le(header + 3)) {
+    error_message_ = "Segment header checksum mismatch";
+    return false;
+  }
+  payload_size_ = value & Segment::MAX_PAYLOAD_SIZE;
+  is_self_contained_ = (value & SEGMENT_SELF_CONTAINED_FLAG) != 0;
+  return true;
+}
+
+bool SegmentDecoder::verify_payload(const char* payload) {
+  if (Segment::crc32(payload, payload_size_) !=
+      decode_uint32_le(payload + payload_size_)) {
+    error_message_ = "Segment payload checksum mismatch";
+    return false;
+  }
+  return true;
+}
+
+} // namespace cass
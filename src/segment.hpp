@@ -0,0 +1,95 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_SEGMENT_HPP_INCLUDED__
+#define __CASS_SEGMENT_HPP_INCLUDED__
+
+#include "buffer.hpp"
+#include "macros.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <uv.h>
+
+namespace cass {
+
+// Protocol v5 outer framing. After the STARTUP handshake frames are sent in
+// segments. A self-contained segment packs one or more complete frames and a
+// frame that's larger than the maximum payload size is split across several
+// segments that aren't self-contained.
+//
+// An uncompressed segment is a 3 byte header (17 bits payload length,
+// 1 bit self-contained flag) protected by a CRC24, followed by the payload
+// and a CRC32 of the payload. All the fields are little-endian.
+class Segment {
+public:
+  static const size_t HEADER_SIZE = 6;
+  static const size_t TRAILER_SIZE = 4;
+  static const size_t MAX_PAYLOAD_SIZE = 128 * 1024 - 1;
+
+  typedef std::vector<size_t> FrameSizeVec;
+
+  // Packs the frames contained in "frames" (the buffers of the frames one
+  // after the other) into as few segments as possible.
+  static void encode(const BufferVec& frames,
+                     const FrameSizeVec& frame_sizes,
+                     BufferVec* segments);
+
+  static uint32_t crc24(uint64_t value, size_t length);
+  static uint32_t crc32(const char* data, size_t size);
+};
+
+class SegmentDecoder {
+public:
+  SegmentDecoder()
+    : is_payload_ready_(false)
+    , is_self_contained_(false)
+    , payload_size_(0)
+    , payload_(NULL) { }
+
+  // Returns the number of bytes consumed or -1 if the segment is invalid.
+  // The payload of a completed segment is valid until the next call.
+  ssize_t decode(const char* input, size_t size);
+
+  bool is_payload_ready() const { return is_payload_ready_; }
+  bool is_self_contained() const { return is_self_contained_; }
+  const char* payload() const { return payload_; }
+  size_t payload_size() const { return payload_size_; }
+
+  const std::string& error_message() const { return error_message_; }
+
+private:
+  bool decode_header(const char* header);
+  bool verify_payload(const char* payload);
+
+private:
+  bool is_payload_ready_;
+  bool is_self_contained_;
+  size_t payload_size_;
+  const char* payload_;
+
+  // Only used for segments that span several reads
+  std::string buffer_;
+  std::string error_message_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(SegmentDecoder);
+};
+
+} // namespace cass
+
+#endif
@@ -30,6 +30,8 @@
 #include "timer.hpp"
 #include "external.hpp"
 
+#include <sstream>
+
 extern "C" {
 
 CassSession* cass_session_new() {
@@ -42,6 +44,12 @@ void cass_session_free(CassSession* session) {
   // if the session is already closed.
   cass::SharedRefPtr<cass::Future> future(new cass::SessionFuture());
   session->close_async(future);
+  if (session->is_run_externally()) {
+    // Nothing else is running the loop so run it until the session is closed
+    while (!future->ready()) {
+      session->run_once(false);
+    }
+  }
   future->wait();
 
   delete session->from();
@@ -77,6 +85,21 @@ CassFuture* cass_session_close(CassSession* session) {
   return CassFuture::to(close_future.get());
 }
 
+int cass_session_event_loop_fd(CassSession* session) {
+  if (!session->is_run_externally()) return -1;
+  return session->backend_fd();
+}
+
+int cass_session_event_loop_timeout(CassSession* session) {
+  if (!session->is_run_externally()) return -1;
+  return session->backend_timeout();
+}
+
+cass_bool_t cass_session_event_loop_run(CassSession* session, cass_bool_t nowait) {
+  if (!session->is_run_externally()) return cass_false;
+  return static_cast<cass_bool_t>(session->run_once(nowait == cass_true));
+}
+
 CassFuture* cass_session_prepare(CassSession* session, const char* query) {
   return cass_session_prepare_n(session, query, SAFE_STRLEN(query));
 }
@@ -146,21 +169,38 @@ void  cass_session_get_metrics(const CassSession* session,
   metrics->errors.request_timeouts = internal_metrics->request_timeouts.sum();
 }
 
+void cass_session_get_retry_budget_metrics(const CassSession* session,
+                                           CassRetryBudgetMetrics* metrics) {
+  const cass::Metrics* internal_metrics = session->metrics();
+  metrics->allowed = internal_metrics->retries_allowed.sum();
+  metrics->denied = internal_metrics->retries_denied.sum();
+}
+
+void cass_session_get_result_cache_metrics(const CassSession* session,
+                                           CassResultCacheMetrics* metrics) {
+  const cass::ResultCache::Ptr& result_cache = session->result_cache();
+  metrics->hits = result_cache ? result_cache->hits() : 0;
+  metrics->misses = result_cache ? result_cache->misses() : 0;
+  metrics->evictions = result_cache ? result_cache->evictions() : 0;
+}
+
 } // extern "C"
 
 namespace cass {
 
 Session::Session()
     : state_(SESSION_STATE_CLOSED)
+    , encoding_protocol_version_(0)
     , connect_error_code_(CASS_OK)
+    , topology_cache_loaded_(false)
     , current_host_mark_(true)
     , pending_pool_count_(0)
-    , pending_workers_count_(0)
-    , current_io_worker_(0) {
+    , pending_workers_count_(0) {
   uv_mutex_init(&state_mutex_);
   uv_mutex_init(&hosts_mutex_);
   uv_mutex_init(&keyspace_mutex_);
   uv_mutex_init(&refresh_metadata_future_mutex_);
+  uv_mutex_init(&token_map_snapshot_mutex_);
 }
 
 Session::~Session() {
@@ -169,14 +209,44 @@ Session::~Session() {
   uv_mutex_destroy(&hosts_mutex_);
   uv_mutex_destroy(&keyspace_mutex_);
   uv_mutex_destroy(&refresh_metadata_future_mutex_);
+  uv_mutex_destroy(&token_map_snapshot_mutex_);
 }
 
 void Session::clear(const Config& config) {
   config_ = config.new_instance();
   random_.reset();
   metrics_.reset(new Metrics(config_.thread_count_io() + 1));
+  if (config_.request_coalescing()) {
+    request_coalescer_.reset(new RequestCoalescer());
+  } else {
+    request_coalescer_.reset();
+  }
+  if (config_.result_cache_max_entries() > 0) {
+    result_cache_.reset(new ResultCache(config_.result_cache_max_entries(),
+                                        config_.result_cache_ttl_ms()));
+  } else {
+    result_cache_.reset();
+  }
+  if (config_.paging_memory_budget() > 0) {
+    paging_budget_.reset(new PagingBudget(config_.paging_memory_budget()));
+  } else {
+    paging_budget_.reset();
+  }
+  if (config_.partition_stats_sample_rate() > 0) {
+    partition_stats_.reset(new PartitionStats(config_.partition_stats_sample_rate(),
+                                              config_.partition_stats_top_k()));
+  } else {
+    partition_stats_.reset();
+  }
+  if (config_.statement_metrics_max_statements() > 0) {
+    statement_metrics_.reset(new StatementMetrics(config_.thread_count_io() + 1,
+                                                  config_.statement_metrics_max_statements()));
+  } else {
+    statement_metrics_.reset();
+  }
   connect_future_.reset();
   close_future_.reset();
+  encoding_protocol_version_.store(0);
   {
     ScopedMutex lock_future(&refresh_metadata_future_mutex_);
     refresh_metadata_future_.reset();
@@ -185,6 +255,7 @@ void Session::clear(const Config& config) {
     ScopedMutex l(&hosts_mutex_);
     hosts_.clear();
   }
+  topology_cache_loaded_ = false;
   io_workers_.clear();
   request_queue_.reset();
   metadata_.clear();
@@ -194,10 +265,11 @@ void Session::clear(const Config& config) {
   current_host_mark_ = true;
   pending_pool_count_ = 0;
   pending_workers_count_ = 0;
-  current_io_worker_ = 0;
+  io_worker_selector_.reset();
 }
 
 int Session::init() {
+  set_run_externally(config_.use_external_event_loop());
   int rc = EventThread<SessionEvent>::init(config_.queue_size_event());
   if (rc != 0) return rc;
   request_queue_.reset(
@@ -205,7 +277,10 @@ int Session::init() {
   rc = request_queue_->init(loop(), this, &Session::on_execute);
   if (rc != 0) return rc;
 
-  for (unsigned int i = 0; i < config_.thread_count_io(); ++i) {
+  // A single IO worker shares the session's loop when it's run by the
+  // application.
+  unsigned int thread_count_io = is_run_externally() ? 1 : config_.thread_count_io();
+  for (unsigned int i = 0; i < thread_count_io; ++i) {
     IOWorker::Ptr io_worker(new IOWorker(this));
     int rc = io_worker->init();
     if (rc != 0) return rc;
@@ -250,6 +325,23 @@ Host::Ptr Session::get_host(const Address& address) {
   return it->second;
 }
 
+TokenMapSnapshot::ConstPtr Session::token_map_snapshot() const {
+  ScopedMutex l(&token_map_snapshot_mutex_);
+  return token_map_snapshot_;
+}
+
+void Session::update_token_map_snapshot() {
+  TokenMapSnapshot::ConstPtr snapshot(token_map_ ? new TokenMapSnapshot(*token_map_) : NULL);
+  ScopedMutex l(&token_map_snapshot_mutex_);
+  token_map_snapshot_ = snapshot;
+}
+
+size_t Session::host_count() {
+  // Lock hosts. This can be called on a non-session thread.
+  ScopedMutex l(&hosts_mutex_);
+  return hosts_.size();
+}
+
 Host::Ptr Session::add_host(const Address& address) {
   LOG_DEBUG("Adding new host: %s", address.to_string().c_str());
   Host::Ptr host(new Host(address, !current_host_mark_));
@@ -285,6 +377,112 @@ void Session::purge_hosts(bool is_initial_connection) {
   current_host_mark_ = !current_host_mark_;
 }
 
+void Session::load_topology_cache() {
+  TopologyCache cache;
+  if (!cache.load(config_.topology_cache_path())) {
+    return;
+  }
+
+  const TopologyCache::HostEntryVec& entries = cache.hosts();
+  for (TopologyCache::HostEntryVec::const_iterator it = entries.begin(),
+       end = entries.end(); it != end; ++it) {
+    Address address;
+    if (!Address::from_string(it->address, it->port, &address)) {
+      LOG_WARN("Ignoring invalid host address %s from topology cache",
+               it->address.c_str());
+      continue;
+    }
+
+    // Cached hosts are used as additional contact points. Hosts that are no
+    // longer part of the cluster are purged once the control connection has
+    // queried the "system" tables.
+    Host::Ptr host = get_host(address);
+    if (!host) {
+      host = add_host(address);
+      host->set_rack_and_dc(it->rack, it->dc);
+      VersionNumber cassandra_version;
+      if (cassandra_version.parse(it->release_version)) {
+        host->set_cassaandra_version(cassandra_version);
+      }
+    }
+  }
+
+  if (!cache.partitions().empty()) {
+    metadata_.set_partitions(cache.partitions());
+  }
+
+  topology_cache_loaded_ = true;
+}
+
+void Session::save_topology_cache() {
+  if (config_.topology_cache_path().empty()) {
+    return;
+  }
+
+  // The hosts (and their datacenter and rack) are only updated on the
+  // session thread so they can be read without a lock here.
+  ScopedPtr<TopologyCache> cache(new TopologyCache());
+  cache->hosts().reserve(hosts_.size());
+  for (HostMap::const_iterator it = hosts_.begin(),
+       end = hosts_.end(); it != end; ++it) {
+    const Host::Ptr& host = it->second;
+    const VersionNumber& cassandra_version = host->cassandra_version();
+    std::ostringstream release_version;
+    release_version << cassandra_version.major_version() << "."
+                    << cassandra_version.minor_version() << "."
+                    << cassandra_version.patch_version();
+
+    TopologyCache::HostEntry entry;
+    entry.address = host->address().to_string();
+    entry.port = host->address().port();
+    entry.dc = host->dc();
+    entry.rack = host->rack();
+    entry.release_version = release_version.str();
+    cache->hosts().push_back(entry);
+  }
+  cache->partitions() = *metadata_.schema_snapshot(protocol_version(),
+                                                   cassandra_version()).get_partitions();
+
+  if (topology_cache_writing_) {
+    topology_cache_pending_.reset(cache.release());
+  } else {
+    write_topology_cache(cache.release());
+  }
+}
+
+bool Session::save_topology_cache_async() {
+  SessionEvent event;
+  event.type = SessionEvent::SAVE_TOPOLOGY_CACHE;
+  return send_event_async(event);
+}
+
+void Session::write_topology_cache(TopologyCache* cache) {
+  topology_cache_writing_.reset(cache);
+  topology_cache_work_.data = this;
+  uv_queue_work(loop(), &topology_cache_work_,
+                on_write_topology_cache,
+                on_after_write_topology_cache);
+}
+
+void Session::on_write_topology_cache(uv_work_t* request) {
+  Session* session = static_cast<Session*>(request->data);
+  const TopologyCache& cache = *session->topology_cache_writing_;
+  if (cache.save(session->config_.topology_cache_path())) {
+    LOG_DEBUG("Saved topology cache \"%s\" with %u hosts and %u tables",
+              session->config_.topology_cache_path().c_str(),
+              static_cast<unsigned int>(cache.hosts().size()),
+              static_cast<unsigned int>(cache.partitions().size()));
+  }
+}
+
+void Session::on_after_write_topology_cache(uv_work_t* request, int status) {
+  Session* session = static_cast<Session*>(request->data);
+  session->topology_cache_writing_.reset();
+  if (session->topology_cache_pending_) {
+    session->write_topology_cache(session->topology_cache_pending_.release());
+  }
+}
+
 bool Session::prepare_host(const Host::Ptr& host,
                            PrepareHostHandler::Callback callback) {
   if (config_.prepare_on_up_or_add_host()) {
@@ -398,6 +596,9 @@ void Session::close_async(const Future::Ptr& future) {
 }
 
 void Session::internal_connect() {
+  if (!config_.topology_cache_path().empty()) {
+    load_topology_cache();
+  }
   if (hosts_.empty()) { // No hosts lock necessary (only called on session thread)
     notify_connect_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
                          "No hosts provided or no hosts resolved");
@@ -498,6 +699,8 @@ void Session::refresh_metadata_callback(CassFuture* future, void* data) {
   const VersionNumber& cassandra_version = session->control_connection_.cassandra_version();
   ResultResponse* const partitions_result = static_cast<ResultResponse*>(response.get());
   session->metadata().update_partitions(protocol_version, cassandra_version, partitions_result);
+  // This is called on an IO worker thread
+  session->save_topology_cache_async();
 }
 
 void Session::notify_connect_error(CassError code, const std::string& message) {
@@ -640,6 +843,10 @@ void Session::on_event(const SessionEvent& event) {
       control_connection_.on_down(event.address);
       break;
 
+    case SessionEvent::SAVE_TOPOLOGY_CACHE:
+      save_topology_cache();
+      break;
+
     default:
       assert(false);
       break;
@@ -674,6 +881,13 @@ void Session::execute(const RequestHandler::Ptr& request_handler) {
     return;
   }
 
+  if (is_run_externally()) {
+    // The application runs the session's loop and makes its calls on the
+    // loop's thread so the request can be dispatched directly.
+    internal_execute(request_handler);
+    return;
+  }
+
   request_handler->inc_ref(); // Queue reference
   if (!request_queue_->enqueue(request_handler.get())) {
     request_handler->dec_ref();
@@ -717,6 +931,7 @@ void Session::on_control_connection_ready() {
        end = io_workers_.end(); it != end; ++it) {
     (*it)->set_protocol_version(control_connection_.protocol_version());
   }
+  encoding_protocol_version_.store(control_connection_.protocol_version());
   for (HostMap::iterator it = hosts_.begin(), hosts_end = hosts_.end();
        it != hosts_end; ++it) {
     on_add(it->second, true);
@@ -731,6 +946,13 @@ void Session::on_control_connection_ready() {
   }
 }
 
+void Session::broadcast_schema_change() {
+  for (IOWorkerVec::iterator it = io_workers_.begin(),
+       end = io_workers_.end(); it != end; ++it) {
+    (*it)->schema_change_async();
+  }
+}
+
 void Session::on_control_connection_error(CassError code, const std::string& message) {
   notify_connect_error(code, message);
 }
@@ -814,6 +1036,7 @@ void Session::on_remove(Host::Ptr host) {
   host->set_down();
 
   config().load_balancing_policy()->on_remove(host);
+  config().retry_policy()->on_host_removed(host->address());
   { // Lock hosts
     ScopedMutex l(&hosts_mutex_);
     hosts_.erase(host->address());
@@ -888,12 +1111,94 @@ Future::Ptr Session::execute(const Request::ConstPtr& request,
                              const Address* preferred_address) {
   ResponseFuture::Ptr future(new ResponseFuture());
 
-  RequestHandler::Ptr request_handler(new RequestHandler(request, future, this));
+  // The page size of an adaptive paging statement's execution is reduced
+  // when the session's paging memory budget is exhausted. This must be done
+  // before the page size is used (e.g. in the result cache key). The
+  // reservation is released if the request isn't sent.
+  int32_t page_size = 0;
+  PagingReservation paging_reservation;
+  if (request->opcode() == CQL_OPCODE_QUERY || request->opcode() == CQL_OPCODE_EXECUTE) {
+    const Statement* statement = static_cast<const Statement*>(request.get());
+    page_size = statement->page_size();
+    if (paging_budget_ && statement->page_sizer() != NULL) {
+      page_size = statement->page_sizer()->reserve(paging_budget_, &paging_reservation);
+    }
+  }
+
+  std::string result_cache_key;
+  if (result_cache_ &&
+      request->opcode() == CQL_OPCODE_EXECUTE &&
+      static_cast<const ExecuteRequest*>(request.get())->use_result_cache() &&
+      ResultCache::make_key(static_cast<const ExecuteRequest*>(request.get()),
+                            page_size, &result_cache_key)) {
+    Address address;
+    Response::Ptr response;
+    if (result_cache_->get(result_cache_key, &address, &response)) {
+      future->set_response(address, response);
+      return future;
+    }
+  }
+
+  // Identical reads that are already in flight share the first one's response
+  ResponseFuture::Ptr request_future(future);
+  if (request_coalescer_ && preferred_address == NULL &&
+      RequestCoalescer::is_coalescable(request.get())) {
+    std::string key(result_cache_key);
+    if (key.empty()) {
+      ResultCache::make_key(static_cast<const ExecuteRequest*>(request.get()),
+                            page_size, &key);
+    }
+    request_future = request_coalescer_->add(key, future);
+    if (!request_future) {
+      return future;
+    }
+  }
+
+  RequestHandler::Ptr request_handler(new RequestHandler(request, request_future, this));
+
+  if (paging_reservation.reserved() > 0) {
+    request_handler->set_paging_reservation(page_size, &paging_reservation);
+  }
+
+  if (!result_cache_key.empty()) {
+    const ResultResponse::ConstPtr& prepared_result =
+        static_cast<const ExecuteRequest*>(request.get())->prepared()->result();
+    request_handler->set_result_cache(result_cache_, result_cache_key,
+                                      prepared_result->keyspace().to_string(),
+                                      prepared_result->table().to_string());
+  }
+
+  if (statement_metrics_ && request->opcode() == CQL_OPCODE_EXECUTE) {
+    const Prepared::ConstPtr& prepared =
+        static_cast<const ExecuteRequest*>(request.get())->prepared();
+    request_handler->set_statement_metrics(statement_metrics_,
+                                           statement_metrics_->get(prepared->id(),
+                                                                   prepared->query()));
+  }
+
+  if (partition_stats_ && partition_stats_->should_sample()) {
+    PartitionStats::Sample sample;
+    TokenMapSnapshot::ConstPtr token_map(token_map_snapshot());
+    if (PartitionStats::make_sample(request.get(),
+                                    metadata().schema_snapshot(protocol_version(),
+                                                               cassandra_version()),
+                                    token_map ? token_map->token_map() : NULL,
+                                    &sample)) {
+      request_handler->set_partition_stats(partition_stats_, sample);
+    }
+  }
 
   if (preferred_address) {
     request_handler->set_preferred_address(*preferred_address);
   }
 
+  if (config_.pre_encode_requests()) {
+    int protocol_version = encoding_protocol_version_.load();
+    if (protocol_version > 0) {
+      request_handler->pre_encode(this, protocol_version);
+    }
+  }
+
   execute(request_handler);
 
   return future;
@@ -913,29 +1218,7 @@ void Session::on_execute(uv_async_t* data) {
     RequestHandler::Ptr request_handler(temp);
     if (request_handler) {
       request_handler->dec_ref(); // Queue reference
-      request_handler->init(session);
-
-      bool is_done = false;
-      while (!is_done) {
-        request_handler->next_host();
-
-        if (!request_handler->current_host()) {
-          request_handler->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
-                                     "All connections on all I/O threads are busy");
-          break;
-        }
-
-        size_t start = session->current_io_worker_;
-        for (size_t i = 0, size = session->io_workers_.size(); i < size; ++i) {
-          const IOWorker::Ptr& io_worker = session->io_workers_[start % size];
-          if (io_worker->execute(request_handler)) {
-            session->current_io_worker_ = (start + 1) % size;
-            is_done = true;
-            break;
-          }
-          start++;
-        }
-      }
+      session->internal_execute(request_handler);
     } else {
       is_closing = true;
     }
@@ -951,6 +1234,28 @@ void Session::on_execute(uv_async_t* data) {
   }
 }
 
+void Session::internal_execute(const RequestHandler::Ptr& request_handler) {
+  if (request_handler->is_cancelled()) {
+    // Drop requests that were cancelled while they were queued
+    request_handler->finish_cancel();
+    return;
+  }
+  request_handler->init(this);
+
+  bool is_done = false;
+  while (!is_done) {
+    request_handler->next_host();
+
+    if (!request_handler->current_host()) {
+      request_handler->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE,
+                                 "All connections on all I/O threads are busy");
+      break;
+    }
+
+    is_done = io_worker_selector_.execute(io_workers_, request_handler);
+  }
+}
+
 QueryPlan* Session::new_query_plan() {
   return config_.load_balancing_policy()->new_query_plan(keyspace(), NULL, this);
 }
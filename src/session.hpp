@@ -24,21 +24,28 @@
 #include "future.hpp"
 #include "host.hpp"
 #include "io_worker.hpp"
+#include "io_worker_selector.hpp"
 #include "load_balancing.hpp"
 #include "metadata.hpp"
 #include "metrics.hpp"
 #include "mpmc_queue.hpp"
+#include "page_sizer.hpp"
+#include "partition_stats.hpp"
 #include "prepared.hpp"
 #include "prepare_host_handler.hpp"
 #include "random.hpp"
 #include "ref_counted.hpp"
+#include "request_coalescer.hpp"
 #include "request_handler.hpp"
 #include "resolver.hpp"
+#include "result_cache.hpp"
 #include "row.hpp"
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
 #include "speculative_execution.hpp"
+#include "statement_metrics.hpp"
 #include "token_map.hpp"
+#include "topology_cache.hpp"
 
 #include <memory>
 #include <set>
@@ -61,7 +68,8 @@ struct SessionEvent {
     NOTIFY_KEYSPACE_ERROR,
     NOTIFY_WORKER_CLOSED,
     NOTIFY_UP,
-    NOTIFY_DOWN
+    NOTIFY_DOWN,
+    SAVE_TOPOLOGY_CACHE
   };
 
   SessionEvent()
@@ -85,6 +93,9 @@ public:
 
   const Config& config() const { return config_; }
   Metrics* metrics() const { return metrics_.get(); }
+  const ResultCache::Ptr& result_cache() const { return result_cache_; }
+  const PartitionStats::Ptr& partition_stats() const { return partition_stats_; }
+  const StatementMetrics::Ptr& statement_metrics() const { return statement_metrics_; }
 
   PreparedMetadata::Entry::Vec prepared_metadata_entries() const {
     return prepared_metadata_.copy();
@@ -100,6 +111,7 @@ public:
                                  const IOWorker* calling_io_worker);
 
   Host::Ptr get_host(const Address& address);
+  size_t host_count();
 
   bool notify_ready_async();
   bool notify_keyspace_error_async();
@@ -119,8 +131,13 @@ public:
 
   const Metadata& metadata() const { return metadata_; }
 
+  // This must only be used on the session thread
   const TokenMap* token_map() const { return token_map_.get(); }
 
+  // Returns the last token map that was built. This can be used from any
+  // thread and isn't changed by later rebuilds.
+  TokenMapSnapshot::ConstPtr token_map_snapshot() const;
+
   ControlConnection* control_connection() { return &control_connection_; }
 
   int protocol_version() const {
@@ -145,6 +162,7 @@ private:
   void notify_closed();
 
   void execute(const RequestHandler::Ptr& request_handler);
+  void internal_execute(const RequestHandler::Ptr& request_handler);
 
   virtual void on_run();
   virtual void on_after_run();
@@ -188,8 +206,26 @@ private:
   Host::Ptr add_host(const Address& address);
   void purge_hosts(bool is_initial_connection);
 
+  // Adds the hosts and the partition map from the topology cache (if
+  // configured) so that requests can be routed before the control
+  // connection has refreshed them.
+  void load_topology_cache();
+  bool is_topology_cache_loaded() const { return topology_cache_loaded_; }
+
+  // Takes a snapshot of the hosts and the partition map and writes it to
+  // the topology cache on a libuv work thread. This must be called on the
+  // session thread; use save_topology_cache_async() from other threads.
+  void save_topology_cache();
+  bool save_topology_cache_async();
+  void write_topology_cache(TopologyCache* cache);
+  static void on_write_topology_cache(uv_work_t* request);
+  static void on_after_write_topology_cache(uv_work_t* request, int status);
+
   Metadata& metadata() { return metadata_; }
 
+  // Publishes a copy of the token map once it has been (re)built
+  void update_token_map_snapshot();
+
   // Asynchronously prepare all queries on a host
   bool prepare_host(const Host::Ptr& host,
                     PrepareHostHandler::Callback callback);
@@ -200,6 +236,10 @@ private:
   void on_control_connection_ready();
   void on_control_connection_error(CassError code, const std::string& message);
 
+  // Notifies the IO workers so that pending schema agreement checks
+  // are retried immediately.
+  void broadcast_schema_change();
+
   void on_add(Host::Ptr host, bool is_initial_connection);
   void internal_on_add(Host::Ptr host, bool is_initial_connection);
 
@@ -227,8 +267,17 @@ private:
   Atomic<State> state_;
   uv_mutex_t state_mutex_;
 
+  // The protocol version used to encode requests on the executing thread,
+  // zero until the control connection is established.
+  Atomic<int> encoding_protocol_version_;
+
   Config config_;
   ScopedPtr<Metrics> metrics_;
+  ResultCache::Ptr result_cache_;
+  RequestCoalescer::Ptr request_coalescer_;
+  PartitionStats::Ptr partition_stats_;
+  StatementMetrics::Ptr statement_metrics_;
+  PagingBudget::Ptr paging_budget_;
   CassError connect_error_code_;
   std::string connect_error_message_;
   Future::Ptr connect_future_;
@@ -241,10 +290,19 @@ private:
   HostMap hosts_;
   uv_mutex_t hosts_mutex_;
 
+  bool topology_cache_loaded_;
+  // Only one snapshot is written at a time. The latest snapshot taken
+  // during a write is written next.
+  uv_work_t topology_cache_work_;
+  ScopedPtr<TopologyCache> topology_cache_writing_;
+  ScopedPtr<TopologyCache> topology_cache_pending_;
+
   IOWorkerVec io_workers_;
   ScopedPtr<AsyncQueue<MPMCQueue<RequestHandler*> > > request_queue_;
 
   ScopedPtr<TokenMap> token_map_;
+  TokenMapSnapshot::ConstPtr token_map_snapshot_;
+  mutable uv_mutex_t token_map_snapshot_mutex_;
   Metadata metadata_;
   PreparedMetadata prepared_metadata_;
   ScopedPtr<Random> random_;
@@ -252,7 +310,7 @@ private:
   bool current_host_mark_;
   int pending_pool_count_;
   int pending_workers_count_;
-  int current_io_worker_;
+  IOWorkerSelector<IOWorker::Ptr> io_worker_selector_;
 
   std::string keyspace_;
   mutable uv_mutex_t keyspace_mutex_;
@@ -0,0 +1,201 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#include "shared_io_threads.hpp"
+
+#include "scoped_lock.hpp"
+
+#define SHARED_IO_THREADS_EVENT_QUEUE_SIZE 256
+
+extern "C" {
+
+CassSharedIoThreads* cass_shared_io_threads_new(unsigned num_threads) {
+  if (num_threads == 0) return NULL;
+  cass::SharedIOThreads* shared_io_threads = new cass::SharedIOThreads(num_threads);
+  if (shared_io_threads->init() != 0) {
+    delete shared_io_threads;
+    return NULL;
+  }
+  shared_io_threads->inc_ref();
+  return CassSharedIoThreads::to(shared_io_threads);
+}
+
+void cass_shared_io_threads_free(CassSharedIoThreads* shared_io_threads) {
+  shared_io_threads->dec_ref();
+}
+
+} // extern "C"
+
+namespace cass {
+
+struct SharedIOThreadsTaskResult {
+  SharedIOThreadsTaskResult()
+    : is_done(false)
+    , rc(0) {
+    uv_mutex_init(&mutex);
+    uv_cond_init(&cond);
+  }
+
+  ~SharedIOThreadsTaskResult() {
+    uv_cond_destroy(&cond);
+    uv_mutex_destroy(&mutex);
+  }
+
+  uv_mutex_t mutex;
+  uv_cond_t cond;
+  bool is_done;
+  int rc;
+};
+
+struct SharedIOThreadsEvent {
+  SharedIOThreadsEvent()
+    : task(NULL)
+    , data(NULL)
+    , result(NULL) { }
+
+  // A NULL task closes the thread
+  SharedIOThreads::Task task;
+  void* data;
+  SharedIOThreadsTaskResult* result;
+};
+
+class SharedIOThread
+    : public EventThread<SharedIOThreadsEvent>
+    , public RefCounted<SharedIOThread> {
+public:
+  typedef SharedRefPtr<SharedIOThread> Ptr;
+
+  SharedIOThread()
+    : is_running_(false) { }
+
+  int init() {
+    return EventThread<SharedIOThreadsEvent>::init(SHARED_IO_THREADS_EVENT_QUEUE_SIZE);
+  }
+
+  bool is_current_thread() const {
+#if UV_VERSION_MAJOR >= 1
+    if (!is_running_.load()) return false;
+    uv_thread_t self = uv_thread_self();
+    return uv_thread_equal(&self, &thread_id_) != 0;
+#else
+    return false;
+#endif
+  }
+
+  int run_task(SharedIOThreads::Task task, void* data) {
+    SharedIOThreadsTaskResult result;
+    SharedIOThreadsEvent event;
+    event.task = task;
+    event.data = data;
+    event.result = &result;
+    while (!send_event_async(event)) {
+      // Keep trying
+    }
+
+    ScopedMutex lock(&result.mutex);
+    while (!result.is_done) {
+      uv_cond_wait(&result.cond, &result.mutex);
+    }
+    return result.rc;
+  }
+
+  void close_async() {
+    while (!send_event_async(SharedIOThreadsEvent())) {
+      // Keep trying
+    }
+  }
+
+private:
+  virtual void on_run() {
+#if UV_VERSION_MAJOR >= 1
+    thread_id_ = uv_thread_self();
+    is_running_.store(true);
+#endif
+  }
+
+  virtual void on_event(const SharedIOThreadsEvent& event) {
+    if (event.task == NULL) {
+      close_handles();
+      return;
+    }
+
+    int rc = event.task(event.data);
+
+    SharedIOThreadsTaskResult* result = event.result;
+    ScopedMutex lock(&result->mutex);
+    result->rc = rc;
+    result->is_done = true;
+    uv_cond_signal(&result->cond);
+  }
+
+private:
+  Atomic<bool> is_running_;
+  uv_thread_t thread_id_;
+};
+
+SharedIOThreads::SharedIOThreads(unsigned num_threads)
+  : num_threads_(num_threads)
+  , next_thread_index_(0) { }
+
+SharedIOThreads::~SharedIOThreads() {
+  close();
+}
+
+int SharedIOThreads::init() {
+  threads_.reserve(num_threads_);
+  for (unsigned i = 0; i < num_threads_; ++i) {
+    SharedIOThread::Ptr thread(new SharedIOThread());
+    int rc = thread->init();
+    if (rc != 0) return rc;
+    rc = thread->run();
+    if (rc != 0) return rc;
+    threads_.push_back(thread);
+  }
+  return 0;
+}
+
+size_t SharedIOThreads::next_thread_index() {
+  return next_thread_index_.fetch_add(1) % threads_.size();
+}
+
+uv_loop_t* SharedIOThreads::loop(size_t index) {
+  return threads_[index % threads_.size()]->loop();
+}
+
+int SharedIOThreads::run_task(size_t index, Task task, void* data) {
+  SharedIOThread* thread = threads_[index % threads_.size()].get();
+  if (thread->is_current_thread()) {
+    return task(data);
+  }
+  return thread->run_task(task, data);
+}
+
+void SharedIOThreads::close() {
+  // The loops only exit after the sessions attached to them have closed
+  // their handles.
+  for (ThreadVec::iterator it = threads_.begin(),
+       end = threads_.end(); it != end; ++it) {
+    (*it)->close_async();
+  }
+  for (ThreadVec::iterator it = threads_.begin(),
+       end = threads_.end(); it != end; ++it) {
+    (*it)->join();
+  }
+  threads_.clear();
+}
+
+} // namespace cass
@@ -0,0 +1,86 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+
+#ifndef __CASS_SHARED_IO_THREADS_HPP_INCLUDED__
+#define __CASS_SHARED_IO_THREADS_HPP_INCLUDED__
+
+#include "atomic.hpp"
+#include "cassandra.h"
+#include "event_thread.hpp"
+#include "external.hpp"
+#include "ref_counted.hpp"
+
+#include <uv.h>
+#include <vector>
+
+namespace cass {
+
+class SharedIOThread;
+
+/**
+ * A group of event loop threads that can be shared by multiple sessions. The
+ * IO workers of sessions that use them are attached to the shared threads'
+ * loops instead of creating threads (and loops) of their own. This keeps the
+ * number of IO worker threads per process constant as the number of sessions
+ * grows. Each session still runs its own session thread (which also runs
+ * the control connection) and has its own connection pools.
+ */
+class SharedIOThreads : public RefCounted<SharedIOThreads> {
+public:
+  typedef SharedRefPtr<SharedIOThreads> Ptr;
+
+  // A task that is run on one of the shared threads.
+  typedef int (*Task)(void* data);
+
+  SharedIOThreads(unsigned num_threads);
+  ~SharedIOThreads();
+
+  int init();
+
+  size_t num_threads() const { return threads_.size(); }
+
+  // Returns the index of the thread the next attached worker should use. The
+  // workers are distributed evenly across the shared threads.
+  size_t next_thread_index();
+
+  uv_loop_t* loop(size_t index);
+
+  // Runs a task on the given shared thread and waits for the result. This
+  // is used to initialize handles on a loop that is already running (libuv
+  // handles can only be initialized on the loop's thread). The task is run
+  // immediately when called from the thread itself.
+  int run_task(size_t index, Task task, void* data);
+
+private:
+  typedef std::vector<SharedRefPtr<SharedIOThread> > ThreadVec;
+
+  void close();
+
+private:
+  const unsigned num_threads_;
+  ThreadVec threads_;
+  Atomic<size_t> next_thread_index_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(SharedIOThreads);
+};
+
+} // namespace cass
+
+EXTERNAL_TYPE(cass::SharedIOThreads, CassSharedIoThreads)
+
+#endif
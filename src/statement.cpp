@@ -99,7 +99,7 @@ CassError cass_statement_set_paging_size(CassStatement* statement,
 
 CassError cass_statement_set_paging_state(CassStatement* statement,
                                           const CassResult* result) {
-  statement->set_paging_state(result->paging_state().to_string());
+  statement->set_paging_state(result);
   return CASS_OK;
 }
 
@@ -110,6 +110,23 @@ CassError cass_statement_set_paging_state_token(CassStatement* statement,
   return CASS_OK;
 }
 
+CassError cass_statement_set_adaptive_paging(CassStatement* statement,
+                                            cass_uint64_t target_page_bytes,
+                                            cass_uint64_t target_latency_ms,
+                                            int min_page_size,
+                                            int max_page_size) {
+  if (target_page_bytes == 0 || min_page_size <= 0 || max_page_size < min_page_size) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cass::PageSizer::Settings settings;
+  settings.target_page_bytes = target_page_bytes;
+  settings.target_latency_ns = target_latency_ms * 1000 * 1000;
+  settings.min_page_size = min_page_size;
+  settings.max_page_size = max_page_size;
+  statement->set_adaptive_paging(settings);
+  return CASS_OK;
+}
+
 CassError cass_statement_set_retry_policy(CassStatement* statement,
                                           CassRetryPolicy* retry_policy) {
   statement->set_retry_policy(retry_policy);
@@ -134,6 +151,15 @@ CassError cass_statement_set_is_idempotent(CassStatement* statement,
   return CASS_OK;
 }
 
+CassError cass_statement_set_use_result_cache(CassStatement* statement,
+                                             cass_bool_t enabled) {
+  if (statement->opcode() != CQL_OPCODE_EXECUTE) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  statement->set_use_result_cache(enabled == cass_true);
+  return CASS_OK;
+}
+
 CassError cass_statement_set_custom_payload(CassStatement* statement,
                                             const CassCustomPayload* payload) {
   statement->set_custom_payload(payload);
@@ -172,6 +198,10 @@ CASS_STATEMENT_BIND(user_type, ONE_PARAM_(const CassUserType* value), value->fro
 CASS_STATEMENT_BIND(bytes,
                     TWO_PARAMS_(const cass_byte_t* value, size_t value_size),
                     cass::CassBytes(value, value_size))
+CASS_STATEMENT_BIND(bytes_external,
+                    FOUR_PARAMS_(const cass_byte_t* value, size_t value_size,
+                                 CassBufferReleaseCallback release, void* data),
+                    cass::CassExternalBytes(value, value_size, release, data))
 CASS_STATEMENT_BIND(decimal,
                     THREE_PARAMS_(const cass_byte_t* varint, size_t varint_size, int scale),
                     cass::CassDecimal(varint, varint_size, scale))
@@ -267,7 +297,8 @@ Statement::Statement(const char* query, size_t query_length, size_t values_count
   , AbstractData(values_count)
   , query_or_id_(sizeof(int32_t) + query_length)
   , flags_(0)
-  , page_size_(-1) {
+  , page_size_(-1)
+  , use_result_cache_(false) {
   // <query> [long string]
   query_or_id_.encode_long_string(0, query, query_length);
 }
@@ -277,7 +308,8 @@ Statement::Statement(const Prepared* prepared)
   , AbstractData(prepared->result()->column_count())
   , query_or_id_(sizeof(uint16_t) + prepared->id().size())
   , flags_(0)
-  , page_size_(-1) {
+  , page_size_(-1)
+  , use_result_cache_(false) {
   // <id> [short bytes] (or [string])
   const std::string& id = prepared->id();
   query_or_id_.encode_string(0, id.data(), id.size());
@@ -298,6 +330,20 @@ std::string Statement::query() const {
   return std::string();
 }
 
+int32_t Statement::page_size(RequestCallback* callback) const {
+  if (callback->page_size() > 0) {
+    return callback->page_size();
+  }
+  return page_size();
+}
+
+void Statement::set_paging_state(const ResultResponse* result) {
+  if (page_sizer_) {
+    page_sizer_->update(result->row_count(), result->size(), result->latency_ns());
+  }
+  paging_state_ = result->paging_state().to_string();
+}
+
 // Format: <kind><string_or_id><n><value_1>...<value_n>
 // where:
 // <kind> is a [byte]
@@ -333,11 +379,11 @@ int32_t Statement::encode_batch(int version, RequestCallback* callback, BufferVe
   return length;
 }
 
-bool Statement::with_keyspace(int version) const {
+bool Statement::with_keyspace(int version, RequestCallback* callback) const {
   return supports_set_keyspace(version) &&
       // Execute requests (bound statements) use the keyspace
       // from the time of prepare.
-      opcode() != CQL_OPCODE_EXECUTE && !keyspace().empty();
+      opcode() != CQL_OPCODE_EXECUTE && !callback->keyspace().empty();
 }
 
 // Format: <string_or_id>[<n><value_1>...<value_n>]<consistency>
@@ -420,7 +466,7 @@ int32_t Statement::encode_begin(int version, uint16_t element_count,
     flags |= CASS_QUERY_FLAG_VALUES;
   }
 
-  if (page_size() > 0) {
+  if (page_size(callback) > 0) {
     flags |= CASS_QUERY_FLAG_PAGE_SIZE;
   }
 
@@ -436,7 +482,7 @@ int32_t Statement::encode_begin(int version, uint16_t element_count,
     flags |= CASS_QUERY_FLAG_DEFAULT_TIMESTAMP;
   }
 
-  if (with_keyspace(version)) {
+  if (with_keyspace(version, callback)) {
     flags |= CASS_QUERY_FLAG_WITH_KEYSPACE;
   }
 
@@ -467,10 +513,11 @@ int32_t Statement::encode_values(int version, RequestCallback* callback, BufferV
   for (size_t i = 0; i < elements().size(); ++i) {
     const Element& element = elements()[i];
     if (!element.is_unset()) {
-      bufs->push_back(element.get_buffer(version));
+      length += element.get_buffers(version, bufs);
     } else  {
       if (version >= 4) {
         bufs->push_back(cass::encode_with_length(CassUnset()));
+        length += bufs->back().size();
       } else {
         std::stringstream ss;
         ss << "Query parameter at index " << i << " was not set";
@@ -478,7 +525,6 @@ int32_t Statement::encode_values(int version, RequestCallback* callback, BufferV
         return Request::REQUEST_ERROR_PARAMETER_UNSET;
       }
     }
-    length += bufs->back().size();
   }
   return length;
 }
@@ -494,9 +540,10 @@ int32_t Statement::encode_end(int version, RequestCallback* callback, BufferVec*
   int32_t length = 0;
   size_t paging_buf_size = 0;
 
-  bool with_keyspace = this->with_keyspace(version);
+  bool with_keyspace = this->with_keyspace(version, callback);
+  int32_t page_size = this->page_size(callback);
 
-  if (page_size() > 0) {
+  if (page_size > 0) {
     paging_buf_size += sizeof(int32_t); // [int]
   }
 
@@ -513,7 +560,7 @@ int32_t Statement::encode_end(int version, RequestCallback* callback, BufferVec*
   }
 
   if (with_keyspace) {
-    paging_buf_size += sizeof(uint16_t) + keyspace().size();
+    paging_buf_size += sizeof(uint16_t) + callback->keyspace().size();
   }
 
   if (paging_buf_size > 0) {
@@ -523,8 +570,8 @@ int32_t Statement::encode_end(int version, RequestCallback* callback, BufferVec*
     Buffer& buf = bufs->back();
     size_t pos = 0;
 
-    if (page_size() >= 0) {
-      pos = buf.encode_int32(pos, page_size());
+    if (page_size >= 0) {
+      pos = buf.encode_int32(pos, page_size);
     }
 
     if (!paging_state().empty()) {
@@ -540,7 +587,7 @@ int32_t Statement::encode_end(int version, RequestCallback* callback, BufferVec*
     }
 
     if (with_keyspace) {
-      pos = buf.encode_string(pos, keyspace().data(), keyspace().size());
+      pos = buf.encode_string(pos, callback->keyspace().data(), callback->keyspace().size());
     }
   }
 
@@ -21,6 +21,7 @@
 #include "constants.hpp"
 #include "external.hpp"
 #include "macros.hpp"
+#include "page_sizer.hpp"
 #include "prepared.hpp"
 #include "request.hpp"
 #include "result_metadata.hpp"
@@ -63,9 +64,28 @@ public:
     return flags_ & CASS_QUERY_FLAG_NAMES_FOR_VALUES;
   }
 
-  int32_t page_size() const { return page_size_; }
+  int32_t page_size() const {
+    return page_sizer_ ? page_sizer_->page_size() : page_size_;
+  }
+
+  // Setting a fixed page size disables adaptive paging
+  void set_page_size(int32_t page_size) {
+    page_size_ = page_size;
+    page_sizer_.reset();
+  }
+
+  // The page sizer is updated when the paging state is set. Executions only
+  // read it.
+  const PageSizer* page_sizer() const { return page_sizer_.get(); }
+
+  void set_adaptive_paging(const PageSizer::Settings& settings) {
+    page_sizer_.reset(new PageSizer(settings, page_size_ > 0 ? page_size_
+                                                             : CASS_DEFAULT_PAGE_SIZE));
+  }
 
-  void set_page_size(int32_t page_size) { page_size_ = page_size; }
+  // Sets the paging state of the next page from a received page. The page
+  // size is adjusted first if adaptive paging is enabled.
+  void set_paging_state(const ResultResponse* result);
 
   const std::string& paging_state() const { return paging_state_; }
 
@@ -73,6 +93,12 @@ public:
     paging_state_ = paging_state;
   }
 
+  bool use_result_cache() const { return use_result_cache_; }
+
+  void set_use_result_cache(bool use_result_cache) {
+    use_result_cache_ = use_result_cache;
+  }
+
   uint8_t kind() const {
     return opcode() == CQL_OPCODE_QUERY ? CASS_BATCH_KIND_QUERY
                                         : CASS_BATCH_KIND_PREPARED;
@@ -87,7 +113,7 @@ public:
   int32_t encode_batch(int version, RequestCallback* callback, BufferVec* bufs) const;
 
 protected:
-  bool with_keyspace(int version) const;
+  bool with_keyspace(int version, RequestCallback* callback) const;
 
   int32_t encode_v1(RequestCallback* callback, BufferVec* bufs) const;
 
@@ -97,6 +123,10 @@ protected:
   int32_t encode_values(int version, RequestCallback* callback, BufferVec* bufs) const;
   int32_t encode_end(int version, RequestCallback* callback, BufferVec* bufs) const;
 
+  // The page size of an execution. An adaptive paging execution can use a
+  // smaller page size than the statement's when the paging budget is low.
+  int32_t page_size(RequestCallback* callback) const;
+
   bool calculate_routing_key(const std::vector<size_t>& key_indices, std::string* routing_key) const;
 
 private:
@@ -104,6 +134,8 @@ private:
   int32_t flags_;
   int32_t page_size_;
   std::string paging_state_;
+  ScopedPtr<PageSizer> page_sizer_;
+  bool use_result_cache_;
   std::vector<size_t> key_indices_;
 
 private:
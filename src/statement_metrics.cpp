@@ -0,0 +1,165 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "statement_metrics.hpp"
+
+#include "scoped_lock.hpp"
+#include "session.hpp"
+
+#include <algorithm>
+
+extern "C" {
+
+CassIterator* cass_iterator_statement_metrics_from_session(const CassSession* session) {
+  const cass::StatementMetrics::Ptr& statement_metrics = session->statement_metrics();
+  if (!statement_metrics) {
+    return NULL;
+  }
+  return CassIterator::to(new cass::StatementMetricsIterator(*statement_metrics));
+}
+
+CassError cass_iterator_get_statement_metrics(const CassIterator* iterator,
+                                              CassStatementMetrics* output) {
+  if (iterator->type() != CASS_ITERATOR_TYPE_STATEMENT_METRICS) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  const cass::StatementMetrics::Snapshot* snapshot =
+      static_cast<const cass::StatementMetricsIterator*>(iterator->from())->snapshot();
+  if (snapshot == NULL) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+
+  output->prepared_id = reinterpret_cast<const cass_byte_t*>(snapshot->prepared_id.data());
+  output->prepared_id_size = snapshot->prepared_id.size();
+  output->query = snapshot->query.data();
+  output->query_length = snapshot->query.size();
+
+  output->latencies.min = snapshot->latencies.min;
+  output->latencies.max = snapshot->latencies.max;
+  output->latencies.mean = snapshot->latencies.mean;
+  output->latencies.stddev = snapshot->latencies.stddev;
+  output->latencies.median = snapshot->latencies.median;
+  output->latencies.percentile_75th = snapshot->latencies.percentile_75th;
+  output->latencies.percentile_95th = snapshot->latencies.percentile_95th;
+  output->latencies.percentile_98th = snapshot->latencies.percentile_98th;
+  output->latencies.percentile_99th = snapshot->latencies.percentile_99th;
+  output->latencies.percentile_999th = snapshot->latencies.percentile_999th;
+
+  output->requests = snapshot->requests;
+  output->errors = snapshot->errors;
+  output->rows = snapshot->rows;
+  output->bytes = snapshot->bytes;
+  return CASS_OK;
+}
+
+} // extern "C"
+
+namespace cass {
+
+const uint64_t StatementMetrics::ADMISSION_INTERVAL;
+
+StatementMetrics::StatementMetrics(size_t max_threads, size_t max_statements)
+  : thread_state_(max_threads)
+  , max_statements_(std::max(max_statements, static_cast<size_t>(1)))
+  , misses_(0) {
+  uv_rwlock_init(&rwlock_);
+  entries_.set_empty_key(std::string());
+  entries_.set_deleted_key(std::string(1, '\0'));
+}
+
+StatementMetrics::~StatementMetrics() {
+  uv_rwlock_destroy(&rwlock_);
+}
+
+StatementMetrics::Entry::Ptr StatementMetrics::get(const std::string& id,
+                                                   const std::string& query) {
+  {
+    ScopedReadLock rl(&rwlock_);
+    EntryMap::const_iterator it = entries_.find(id);
+    if (it != entries_.end()) {
+      return it->second;
+    }
+
+    // Once the limit is reached most executions of untracked statements are
+    // skipped without taking the write lock, scanning or allocating an entry.
+    if (entries_.size() >= max_statements_ &&
+        misses_.fetch_add(1, MEMORY_ORDER_RELAXED) % ADMISSION_INTERVAL != 0) {
+      return Entry::Ptr();
+    }
+  }
+
+  ScopedWriteLock wl(&rwlock_);
+  EntryMap::const_iterator it = entries_.find(id);
+  if (it != entries_.end()) {
+    return it->second; // Added by another thread
+  }
+
+  uint64_t inherited_requests = 0;
+  if (entries_.size() >= max_statements_) {
+    EntryMap::iterator min = entries_.begin();
+    uint64_t min_requests = min->second->estimated_requests();
+    for (EntryMap::iterator i = entries_.begin(), end = entries_.end(); i != end; ++i) {
+      uint64_t requests = i->second->estimated_requests();
+      if (requests < min_requests) {
+        min = i;
+        min_requests = requests;
+      }
+    }
+    entries_.erase(min);
+    inherited_requests = min_requests;
+  }
+
+  Entry::Ptr entry(new Entry(id, query, inherited_requests, &thread_state_));
+  entries_[id] = entry;
+  return entry;
+}
+
+static bool compare_requests(const StatementMetrics::Snapshot& lhs,
+                             const StatementMetrics::Snapshot& rhs) {
+  return lhs.requests > rhs.requests;
+}
+
+void StatementMetrics::snapshot(SnapshotVec* output) const {
+  std::vector<Entry::Ptr> entries;
+  {
+    ScopedReadLock rl(&rwlock_);
+    entries.reserve(entries_.size());
+    for (EntryMap::const_iterator i = entries_.begin(), end = entries_.end(); i != end; ++i) {
+      entries.push_back(i->second);
+    }
+  }
+
+  output->resize(entries.size());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const Entry::Ptr& entry = entries[i];
+    Snapshot& snapshot = (*output)[i];
+    snapshot.prepared_id = entry->prepared_id_;
+    snapshot.query = entry->query_;
+    entry->latencies_.get_snapshot(&snapshot.latencies);
+    snapshot.requests = entry->requests_.sum();
+    snapshot.errors = entry->errors_.load(MEMORY_ORDER_RELAXED);
+    snapshot.rows = entry->rows_.sum();
+    snapshot.bytes = entry->bytes_.sum();
+  }
+  std::sort(output->begin(), output->end(), compare_requests);
+}
+
+size_t StatementMetrics::size() const {
+  ScopedReadLock rl(&rwlock_);
+  return entries_.size();
+}
+
+} // namespace cass
@@ -0,0 +1,178 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_STATEMENT_METRICS_HPP_INCLUDED__
+#define __CASS_STATEMENT_METRICS_HPP_INCLUDED__
+
+#include "atomic.hpp"
+#include "iterator.hpp"
+#include "macros.hpp"
+#include "metrics.hpp"
+#include "ref_counted.hpp"
+
+#include <sparsehash/dense_hash_map>
+
+#include <string>
+#include <uv.h>
+#include <vector>
+
+namespace cass {
+
+/**
+ * Latency, throughput and error metrics for each prepared statement. The
+ * latencies, request, row and byte counts are recorded using per-thread
+ * histograms and counters so the I/O workers never wait on each other.
+ * Only `max_statements` statements are tracked. When the limit is reached
+ * one in ADMISSION_INTERVAL executions of untracked statements replaces the
+ * statement with the fewest requests and the rest aren't recorded. As in the
+ * Space-Saving algorithm the replacement inherits the evicted statement's
+ * request count for future evictions, so a frequently executed statement
+ * isn't immediately evicted by the next untracked one.
+ */
+class StatementMetrics : public RefCounted<StatementMetrics> {
+public:
+  typedef SharedRefPtr<StatementMetrics> Ptr;
+
+  // The per-statement histograms use less precision than the session's
+  // histogram to bound their memory (values are in microseconds).
+  static const int64_t HIGHEST_TRACKABLE_VALUE = 60LL * 1000LL * 1000LL;
+  static const int SIGNIFICANT_FIGURES = 2;
+
+  static const uint64_t ADMISSION_INTERVAL = 64;
+
+  class Entry : public RefCounted<Entry> {
+  public:
+    typedef SharedRefPtr<Entry> Ptr;
+
+    Entry(const std::string& prepared_id,
+          const std::string& query,
+          uint64_t inherited_requests,
+          Metrics::ThreadState* thread_state)
+      : prepared_id_(prepared_id)
+      , query_(query)
+      , inherited_requests_(inherited_requests)
+      , latencies_(thread_state, HIGHEST_TRACKABLE_VALUE, SIGNIFICANT_FIGURES)
+      , requests_(thread_state)
+      , rows_(thread_state)
+      , bytes_(thread_state)
+      , errors_(0) { }
+
+    const std::string& prepared_id() const { return prepared_id_; }
+    const std::string& query() const { return query_; }
+
+    // This must only be called from the session's I/O worker threads
+    void record_response(uint64_t latency_ns, uint64_t rows, uint64_t bytes) {
+      latencies_.record_value(latency_ns / 1000);
+      requests_.inc();
+      rows_.add(rows);
+      bytes_.add(bytes);
+    }
+
+    // Errors can be set from any thread
+    void record_error() {
+      errors_.fetch_add(1, MEMORY_ORDER_RELAXED);
+    }
+
+    uint64_t requests() const { return requests_.sum(); }
+
+    // The requests used to choose the statement that's evicted. This
+    // includes the requests of the statement it replaced.
+    uint64_t estimated_requests() const {
+      return inherited_requests_ + requests_.sum();
+    }
+
+  private:
+    friend class StatementMetrics;
+
+    const std::string prepared_id_;
+    const std::string query_;
+    const uint64_t inherited_requests_;
+    Metrics::Histogram latencies_;
+    Metrics::Counter requests_;
+    Metrics::Counter rows_;
+    Metrics::Counter bytes_;
+    Atomic<uint64_t> errors_;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(Entry);
+  };
+
+  struct Snapshot {
+    std::string prepared_id;
+    std::string query;
+    Metrics::Histogram::Snapshot latencies;
+    uint64_t requests;
+    uint64_t errors;
+    uint64_t rows;
+    uint64_t bytes;
+  };
+
+  typedef std::vector<Snapshot> SnapshotVec;
+
+  StatementMetrics(size_t max_threads, size_t max_statements);
+  ~StatementMetrics();
+
+  // Finds the statement's entry, adding it if it's not tracked yet. This
+  // returns NULL if the statement isn't tracked and wasn't admitted.
+  Entry::Ptr get(const std::string& prepared_id, const std::string& query);
+
+  // Copies the statements' metrics ordered from the most requests to the
+  // fewest
+  void snapshot(SnapshotVec* output) const;
+
+  size_t size() const;
+
+private:
+  typedef sparsehash::dense_hash_map<std::string, Entry::Ptr> EntryMap;
+
+  Metrics::ThreadState thread_state_;
+  const size_t max_statements_;
+  mutable uv_rwlock_t rwlock_;
+  EntryMap entries_;
+  Atomic<uint64_t> misses_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(StatementMetrics);
+};
+
+class StatementMetricsIterator : public Iterator {
+public:
+  StatementMetricsIterator(const StatementMetrics& statement_metrics)
+    : Iterator(CASS_ITERATOR_TYPE_STATEMENT_METRICS)
+    , index_(-1) {
+    statement_metrics.snapshot(&snapshots_);
+  }
+
+  virtual bool next() {
+    if (index_ + 1 >= static_cast<int>(snapshots_.size())) {
+      return false;
+    }
+    ++index_;
+    return true;
+  }
+
+  const StatementMetrics::Snapshot* snapshot() const {
+    return index_ >= 0 ? &snapshots_[index_] : NULL;
+  }
+
+private:
+  StatementMetrics::SnapshotVec snapshots_;
+  int index_;
+};
+
+} // namespace cass
+
+#endif
@@ -80,6 +80,15 @@ public:
     return false;
   }
 
+  bool get_pending(int stream, T& output) const {
+    typename PendingMap::const_iterator i = pending_.find(stream);
+    if (i != pending_.end()) {
+      output = i->second;
+      return true;
+    }
+    return false;
+  }
+
   size_t available_streams() const { return max_streams_ - pending_.size(); }
   size_t pending_streams() const { return pending_.size(); }
   size_t max_streams() const { return max_streams_; }
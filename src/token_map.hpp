@@ -18,8 +18,12 @@
 #define __CASS_TOKEN_MAP_HPP_INCLUDED__
 
 #include "host.hpp"
+#include "ref_counted.hpp"
+#include "scoped_ptr.hpp"
 
+#include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace cass {
 
@@ -34,6 +38,10 @@ public:
 
   virtual ~TokenMap() { }
 
+  // Copies the token map so that a snapshot can be read by other threads
+  // while this map is updated.
+  virtual TokenMap* copy() const = 0;
+
   virtual void add_host(const Host::Ptr& host, const Value* tokens) = 0;
   virtual void update_host_and_build(const Host::Ptr& host, const Value* tokens) = 0;
   virtual void remove_host_and_build(const Host::Ptr& host) = 0;
@@ -48,6 +56,35 @@ public:
 
   virtual const CopyOnWriteHostVec& get_replicas(const std::string& keyspace_name,
                                                  const std::string& routing_key) const = 0;
+
+  // Gets the token of a routing key. Returns false if the partitioner's
+  // tokens aren't 64-bit integers (only Murmur3Partitioner's are).
+  virtual bool get_token(const std::string& routing_key, int64_t* token) const = 0;
+
+  // Gets the replicas of several routing keys at once (appended to
+  // "replicas"). The keys' tokens are also returned if the partitioner's
+  // tokens are 64-bit integers (Murmur3Partitioner), otherwise "tokens" is
+  // left unchanged and false is returned.
+  virtual bool get_tokens_and_replicas(const std::string& keyspace_name,
+                                       const std::string* routing_keys,
+                                       size_t count,
+                                       int64_t* tokens,
+                                       std::vector<CopyOnWriteHostVec>* replicas) const = 0;
+};
+
+// A copy of a token map that isn't changed once it's created so it can be
+// shared by threads while the original map is updated.
+class TokenMapSnapshot : public RefCounted<TokenMapSnapshot> {
+public:
+  typedef SharedRefPtr<const TokenMapSnapshot> ConstPtr;
+
+  explicit TokenMapSnapshot(const TokenMap& token_map)
+    : token_map_(token_map.copy()) { }
+
+  const TokenMap* token_map() const { return token_map_.get(); }
+
+private:
+  ScopedPtr<TokenMap> token_map_;
 };
 
 } // namespace cass
@@ -94,6 +94,12 @@ Murmur3Partitioner::Token Murmur3Partitioner::hash(const StringRef& str) {
   return MurmurHash3_x64_128(str.data(), str.size(), 0);
 }
 
+void Murmur3Partitioner::hash_many(const StringRef* strs, size_t count, Token* tokens) {
+  for (size_t i = 0; i < count; ++i) {
+    tokens[i] = hash(strs[i]);
+  }
+}
+
 RandomPartitioner::Token RandomPartitioner::from_string(const StringRef& str) {
   Token token;
   parse_int128(str.data(), str.size(), &token.hi, &token.lo);
@@ -125,10 +131,28 @@ RandomPartitioner::Token RandomPartitioner::abs(RandomPartitioner::Token token)
 }
 
 RandomPartitioner::Token RandomPartitioner::hash(const StringRef& str) {
-  Md5 hash;
-  hash.update(reinterpret_cast<const uint8_t*>(str.data()), str.size());
   uint8_t digest[16];
-  hash.final(digest);
+  Md5::hash(reinterpret_cast<const uint8_t*>(str.data()), str.size(), digest);
+  return from_digest(digest);
+}
+
+void RandomPartitioner::hash_many(const StringRef* strs, size_t count, Token* tokens) {
+  std::vector<const uint8_t*> data(count);
+  std::vector<size_t> sizes(count);
+  std::vector<uint8_t> digests(16 * count);
+  for (size_t i = 0; i < count; ++i) {
+    data[i] = reinterpret_cast<const uint8_t*>(strs[i].data());
+    sizes[i] = strs[i].size();
+  }
+  if (count > 0) {
+    Md5::hash_many(&data[0], &sizes[0], count, &digests[0]);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    tokens[i] = from_digest(&digests[16 * i]);
+  }
+}
+
+RandomPartitioner::Token RandomPartitioner::from_digest(uint8_t* digest) {
   Token token;
 
   // For compatability with Cassandra we interpret the MD5 as a big-endian value:
@@ -152,4 +176,10 @@ ByteOrderedPartitioner::Token ByteOrderedPartitioner::hash(const StringRef& str)
   return Token(data, data + str.size());
 }
 
+void ByteOrderedPartitioner::hash_many(const StringRef* strs, size_t count, Token* tokens) {
+  for (size_t i = 0; i < count; ++i) {
+    tokens[i] = hash(strs[i]);
+  }
+}
+
 } // namespace cass
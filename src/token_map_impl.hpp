@@ -19,6 +19,7 @@
 
 #include "collection_iterator.hpp"
 #include "constants.hpp"
+#include "eytzinger_index.hpp"
 #include "map_iterator.hpp"
 #include "result_iterator.hpp"
 #include "result_response.hpp"
@@ -104,6 +105,7 @@ struct Murmur3Partitioner {
 
   static Token from_string(const StringRef& str);
   static Token hash(const StringRef& str);
+  static void hash_many(const StringRef* strs, size_t count, Token* tokens);
   static StringRef name() { return "Murmur3Partitioner"; }
 };
 
@@ -123,9 +125,13 @@ struct RandomPartitioner {
 
   static Token abs(Token token);
   static uint64_t encode(uint8_t* bytes);
+  static Token from_digest(uint8_t* digest);
 
   static Token from_string(const StringRef& str);
   static Token hash(const StringRef& str);
+  // Hashes several keys at once (e.g. the routing keys of a batch or a bulk
+  // load) which is faster than hashing them one at a time.
+  static void hash_many(const StringRef* strs, size_t count, Token* tokens);
   static StringRef name() { return "RandomPartitioner"; }
 };
 
@@ -135,6 +141,7 @@ public:
 
   static Token from_string(const StringRef& str);
   static Token hash(const StringRef& str);
+  static void hash_many(const StringRef* strs, size_t count, Token* tokens);
   static StringRef name() { return "ByteOrderedPartitioner"; }
 };
 
@@ -541,13 +548,11 @@ public:
   typedef std::pair<Token, CopyOnWriteHostVec> TokenReplicas;
   typedef std::vector<TokenReplicas> TokenReplicasVec;
 
-  struct TokenReplicasCompare {
-    bool operator()(const TokenReplicas& lhs, const TokenReplicas& rhs) const {
-      return lhs.first < rhs.first;
-    }
-  };
+  // The replicas for each token of the ring. They're stored in token order,
+  // separately from the tokens, which are searched using the ring index.
+  typedef std::vector<CopyOnWriteHostVec> ReplicasVec;
 
-  typedef sparsehash::dense_hash_map<std::string, TokenReplicasVec> KeyspaceReplicaMap;
+  typedef sparsehash::dense_hash_map<std::string, ReplicasVec> KeyspaceReplicaMap;
   typedef sparsehash::dense_hash_map<std::string, ReplicationStrategy<Partitioner> > KeyspaceStrategyMap;
 
   static const CopyOnWriteHostVec NO_REPLICAS;
@@ -559,6 +564,19 @@ public:
     strategies_.set_deleted_key(std::string(1, '\0'));
   }
 
+  TokenMapImpl(const TokenMapImpl& other)
+    : TokenMap()
+    , tokens_(other.tokens_)
+    , ring_index_(other.ring_index_)
+    , hosts_(other.hosts_)
+    , datacenters_(other.datacenters_)
+    , replicas_(other.replicas_)
+    , strategies_(other.strategies_)
+    , rack_ids_(other.rack_ids_)
+    , dc_ids_(other.dc_ids_) { }
+
+  virtual TokenMap* copy() const { return new TokenMapImpl(*this); }
+
   virtual void add_host(const Host::Ptr& host, const Value* tokens);
   virtual void update_host_and_build(const Host::Ptr& host, const Value* tokens);
   virtual void remove_host_and_build(const Host::Ptr& host);
@@ -574,6 +592,14 @@ public:
   virtual const CopyOnWriteHostVec& get_replicas(const std::string& keyspace_name,
                                                  const std::string& routing_key) const;
 
+  virtual bool get_token(const std::string& routing_key, int64_t* token) const;
+
+  virtual bool get_tokens_and_replicas(const std::string& keyspace_name,
+                                       const std::string* routing_keys,
+                                       size_t count,
+                                       int64_t* tokens,
+                                       std::vector<CopyOnWriteHostVec>* replicas) const;
+
   // Test only
   bool contains(const Token& token) const {
     for (typename TokenHostVec::const_iterator i = tokens_.begin(),
@@ -589,10 +615,14 @@ private:
                        bool should_build_replicas);
   void remove_host_tokens(const Host::Ptr& host);
   void update_host_ids(const Host::Ptr& host);
+  void build_ring_index();
   void build_replicas();
+  void build_keyspace_replicas(const std::string& keyspace_name,
+                               const ReplicationStrategy<Partitioner>& strategy);
 
 private:
   TokenHostVec tokens_;
+  EytzingerIndex<Token> ring_index_;
   HostSet hosts_;
   DatacenterMap datacenters_;
   KeyspaceReplicaMap replicas_;
@@ -707,22 +737,71 @@ const CopyOnWriteHostVec& TokenMapImpl<Partitioner>::get_replicas(const std::str
                                                                   const std::string& routing_key) const {
   typename KeyspaceReplicaMap::const_iterator ks_it = replicas_.find(keyspace_name);
 
-  if (ks_it != replicas_.end()) {
-    Token token = Partitioner::hash(routing_key);
-    const TokenReplicasVec& replicas = ks_it->second;
-    typename TokenReplicasVec::const_iterator replicas_it = std::upper_bound(replicas.begin(), replicas.end(),
-                                                                             TokenReplicas(token, NO_REPLICAS),
-                                                                             TokenReplicasCompare());
-    if (replicas_it != replicas.end()) {
-      return replicas_it->second;
+  // The replicas are only valid for the current ring if they were built
+  // after the ring's tokens were last updated.
+  if (ks_it != replicas_.end() && ks_it->second.size() == ring_index_.size()) {
+    const ReplicasVec& replicas = ks_it->second;
+    size_t position = ring_index_.upper_bound(Partitioner::hash(routing_key));
+    if (position < replicas.size()) {
+      return replicas[position];
     } else if (!replicas.empty()) {
-      return replicas.front().second;
+      return replicas.front();
     }
   }
 
   return NO_REPLICAS;
 }
 
+inline bool to_int64_tokens(const std::vector<int64_t>& tokens, int64_t* output) {
+  std::copy(tokens.begin(), tokens.end(), output);
+  return true;
+}
+
+template <class Token>
+inline bool to_int64_tokens(const std::vector<Token>& tokens, int64_t* output) {
+  return false;
+}
+
+template <class Partitioner>
+bool TokenMapImpl<Partitioner>::get_token(const std::string& routing_key,
+                                          int64_t* token) const {
+  std::vector<Token> hashed(1, Partitioner::hash(routing_key));
+  return to_int64_tokens(hashed, token);
+}
+
+template <class Partitioner>
+bool TokenMapImpl<Partitioner>::get_tokens_and_replicas(const std::string& keyspace_name,
+                                                        const std::string* routing_keys,
+                                                        size_t count,
+                                                        int64_t* tokens,
+                                                        std::vector<CopyOnWriteHostVec>* replicas) const {
+  std::vector<StringRef> keys(routing_keys, routing_keys + count);
+  std::vector<Token> hashed(count);
+  if (count > 0) {
+    Partitioner::hash_many(&keys[0], count, &hashed[0]);
+  }
+
+  const ReplicasVec* keyspace_replicas = NULL;
+  typename KeyspaceReplicaMap::const_iterator ks_it = replicas_.find(keyspace_name);
+  if (ks_it != replicas_.end() && !ks_it->second.empty() &&
+      ks_it->second.size() == ring_index_.size()) {
+    keyspace_replicas = &ks_it->second;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    if (keyspace_replicas != NULL) {
+      size_t position = ring_index_.upper_bound(hashed[i]);
+      replicas->push_back(position < keyspace_replicas->size()
+                          ? (*keyspace_replicas)[position]
+                          : keyspace_replicas->front());
+    } else {
+      replicas->push_back(NO_REPLICAS);
+    }
+  }
+
+  return to_int64_tokens(hashed, tokens);
+}
+
 template <class Partitioner>
 void TokenMapImpl<Partitioner>::update_keyspace(const VersionNumber& cassandra_version,
                                                 ResultResponse* result,
@@ -752,7 +831,7 @@ void TokenMapImpl<Partitioner>::update_keyspace(const VersionNumber& cassandra_v
       if (should_build_replicas) {
         uint64_t start = uv_hrtime();
         build_datacenters(hosts_, datacenters_);
-        strategy.build_replicas(tokens_, datacenters_, replicas_[keyspace_name]);
+        build_keyspace_replicas(keyspace_name, strategy);
         LOG_DEBUG("Updated token map with keyspace '%s'. Rebuilt token map with %u hosts and %u tokens in %f ms",
                   keyspace_name.c_str(),
                   (unsigned int)hosts_.size(),
@@ -776,15 +855,40 @@ void TokenMapImpl<Partitioner>::update_host_ids(const Host::Ptr& host) {
   host->set_rack_and_dc_ids(rack_ids_.get(host->rack()), dc_ids_.get(host->dc()));
 }
 
+template <class Partitioner>
+void TokenMapImpl<Partitioner>::build_ring_index() {
+  std::vector<Token> tokens;
+  tokens.reserve(tokens_.size());
+  for (typename TokenHostVec::const_iterator i = tokens_.begin(),
+       end = tokens_.end(); i != end; ++i) {
+    tokens.push_back(i->first);
+  }
+  ring_index_.build(tokens);
+}
+
 template <class Partitioner>
 void TokenMapImpl<Partitioner>::build_replicas() {
+  build_ring_index();
   build_datacenters(hosts_, datacenters_);
   for (typename KeyspaceStrategyMap::const_iterator i = strategies_.begin(),
        end = strategies_.end();
        i != end; ++i) {
-    const std::string& keyspace_name = i->first;
-    const ReplicationStrategy<Partitioner>& strategy = i->second;
-    strategy.build_replicas(tokens_, datacenters_, replicas_[keyspace_name]);
+    build_keyspace_replicas(i->first, i->second);
+  }
+}
+
+template <class Partitioner>
+void TokenMapImpl<Partitioner>::build_keyspace_replicas(const std::string& keyspace_name,
+                                                        const ReplicationStrategy<Partitioner>& strategy) {
+  TokenReplicasVec token_replicas;
+  strategy.build_replicas(tokens_, datacenters_, token_replicas);
+
+  ReplicasVec& replicas = replicas_[keyspace_name];
+  replicas.clear();
+  replicas.reserve(token_replicas.size());
+  for (typename TokenReplicasVec::const_iterator i = token_replicas.begin(),
+       end = token_replicas.end(); i != end; ++i) {
+    replicas.push_back(i->second);
   }
 }
 
@@ -0,0 +1,309 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "topology_cache.hpp"
+
+#include "logger.hpp"
+#include "serialization.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <list>
+
+#define TOPOLOGY_CACHE_MAGIC "CTC1"
+#define TOPOLOGY_CACHE_MAGIC_SIZE 4
+#define TOPOLOGY_CACHE_HEADER_SIZE (TOPOLOGY_CACHE_MAGIC_SIZE + sizeof(uint16_t) + sizeof(uint32_t))
+
+namespace {
+
+uint32_t checksum(const char* data, size_t size) {
+  uint32_t hash = 2166136261U;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+class Encoder {
+public:
+  Encoder(std::string* output)
+    : output_(output) { }
+
+  void uint16(uint16_t value) {
+    char buf[sizeof(uint16_t)];
+    cass::encode_uint16(buf, value);
+    output_->append(buf, sizeof(buf));
+  }
+
+  void uint32(uint32_t value) {
+    char buf[sizeof(uint32_t)];
+    cass::encode_uint32(buf, value);
+    output_->append(buf, sizeof(buf));
+  }
+
+  void int32(int32_t value) {
+    char buf[sizeof(int32_t)];
+    cass::encode_int32(buf, value);
+    output_->append(buf, sizeof(buf));
+  }
+
+  void string(const std::string& value) {
+    // Longer strings aren't valid names or addresses and are truncated
+    size_t size = std::min<size_t>(value.size(), 0xFFFF);
+    uint16(static_cast<uint16_t>(size));
+    output_->append(value.data(), size);
+  }
+
+private:
+  std::string* output_;
+};
+
+class Decoder {
+public:
+  Decoder(const char* data, size_t size)
+    : pos_(const_cast<char*>(data))
+    , remaining_(size) { }
+
+  bool uint16(uint16_t* output) {
+    if (remaining_ < sizeof(uint16_t)) return false;
+    pos_ = cass::decode_uint16(pos_, *output);
+    remaining_ -= sizeof(uint16_t);
+    return true;
+  }
+
+  bool uint32(uint32_t* output) {
+    if (remaining_ < sizeof(uint32_t)) return false;
+    pos_ = cass::decode_uint32(pos_, *output);
+    remaining_ -= sizeof(uint32_t);
+    return true;
+  }
+
+  bool int32(int32_t* output) {
+    if (remaining_ < sizeof(int32_t)) return false;
+    pos_ = cass::decode_int32(pos_, *output);
+    remaining_ -= sizeof(int32_t);
+    return true;
+  }
+
+  bool string(std::string* output) {
+    uint16_t size;
+    if (!uint16(&size) || remaining_ < size) return false;
+    output->assign(pos_, size);
+    pos_ += size;
+    remaining_ -= size;
+    return true;
+  }
+
+  // Counts are bounded by the remaining data so that a corrupted count
+  // can't cause huge allocations.
+  bool count(uint32_t* output, size_t min_element_size) {
+    return uint32(output) && *output <= remaining_ / min_element_size;
+  }
+
+  bool is_done() const { return remaining_ == 0; }
+
+private:
+  char* pos_;
+  size_t remaining_;
+};
+
+} // namespace
+
+namespace cass {
+
+void TopologyCache::encode(std::string* output) const {
+  std::string payload;
+  Encoder encoder(&payload);
+
+  encoder.uint32(static_cast<uint32_t>(hosts_.size()));
+  for (HostEntryVec::const_iterator i = hosts_.begin(),
+       end = hosts_.end(); i != end; ++i) {
+    encoder.string(i->address);
+    encoder.int32(i->port);
+    encoder.string(i->dc);
+    encoder.string(i->rack);
+    encoder.string(i->release_version);
+  }
+
+  encoder.uint32(static_cast<uint32_t>(partitions_.size()));
+  for (TableSplitMetadata::Map::const_iterator i = partitions_.begin(),
+       end = partitions_.end(); i != end; ++i) {
+    const std::vector<PartitionMetadata>& partitions = i->second.partitions();
+    encoder.string(i->first);
+    encoder.uint32(static_cast<uint32_t>(partitions.size()));
+    for (std::vector<PartitionMetadata>::const_iterator j = partitions.begin(),
+         partitions_end = partitions.end(); j != partitions_end; ++j) {
+      encoder.int32(j->start_key_);
+      encoder.int32(j->end_key_);
+      encoder.uint32(static_cast<uint32_t>(j->host_ips_.size()));
+      for (PartitionMetadata::IpList::const_iterator k = j->host_ips_.begin(),
+           ips_end = j->host_ips_.end(); k != ips_end; ++k) {
+        encoder.string(*k);
+      }
+    }
+  }
+
+  output->clear();
+  output->reserve(TOPOLOGY_CACHE_HEADER_SIZE + payload.size() + sizeof(uint32_t));
+  output->append(TOPOLOGY_CACHE_MAGIC, TOPOLOGY_CACHE_MAGIC_SIZE);
+  Encoder header(output);
+  header.uint16(VERSION);
+  header.uint32(static_cast<uint32_t>(payload.size()));
+  output->append(payload);
+  header.uint32(checksum(payload.data(), payload.size()));
+}
+
+bool TopologyCache::decode(const char* data, size_t size) {
+  hosts_.clear();
+  partitions_.clear();
+
+  if (size < TOPOLOGY_CACHE_HEADER_SIZE ||
+      memcmp(data, TOPOLOGY_CACHE_MAGIC, TOPOLOGY_CACHE_MAGIC_SIZE) != 0) {
+    return false;
+  }
+
+  Decoder header(data + TOPOLOGY_CACHE_MAGIC_SIZE, size - TOPOLOGY_CACHE_MAGIC_SIZE);
+  uint16_t version;
+  uint32_t payload_size;
+  header.uint16(&version);
+  header.uint32(&payload_size);
+  if (version != VERSION ||
+      size != TOPOLOGY_CACHE_HEADER_SIZE + payload_size + sizeof(uint32_t)) {
+    return false;
+  }
+
+  const char* payload = data + TOPOLOGY_CACHE_HEADER_SIZE;
+  uint32_t expected_checksum;
+  Decoder trailer(payload + payload_size, sizeof(uint32_t));
+  trailer.uint32(&expected_checksum);
+  if (checksum(payload, payload_size) != expected_checksum) {
+    return false;
+  }
+
+  Decoder decoder(payload, payload_size);
+  HostEntryVec hosts;
+  TableSplitMetadata::Map partitions;
+
+  uint32_t host_count;
+  if (!decoder.count(&host_count, 3 * sizeof(uint16_t) + sizeof(int32_t))) {
+    return false;
+  }
+  hosts.resize(host_count);
+  for (HostEntryVec::iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
+    if (!decoder.string(&i->address) ||
+        !decoder.int32(&i->port) ||
+        !decoder.string(&i->dc) ||
+        !decoder.string(&i->rack) ||
+        !decoder.string(&i->release_version)) {
+      return false;
+    }
+  }
+
+  uint32_t table_count;
+  if (!decoder.count(&table_count, sizeof(uint16_t) + sizeof(uint32_t))) {
+    return false;
+  }
+  for (uint32_t i = 0; i < table_count; ++i) {
+    std::string table_name;
+    uint32_t partition_count;
+    if (!decoder.string(&table_name) ||
+        !decoder.count(&partition_count, 2 * sizeof(int32_t) + sizeof(uint32_t))) {
+      return false;
+    }
+
+    std::list<PartitionMetadata> source;
+    for (uint32_t j = 0; j < partition_count; ++j) {
+      PartitionMetadata partition;
+      uint32_t ip_count;
+      if (!decoder.int32(&partition.start_key_) ||
+          !decoder.int32(&partition.end_key_) ||
+          !decoder.count(&ip_count, sizeof(uint16_t))) {
+        return false;
+      }
+      for (uint32_t k = 0; k < ip_count; ++k) {
+        std::string ip;
+        if (!decoder.string(&ip)) return false;
+        partition.host_ips_.push_back(ip);
+      }
+      source.push_back(partition);
+    }
+    partitions[table_name] = TableSplitMetadata(source);
+  }
+
+  if (!decoder.is_done()) {
+    return false;
+  }
+
+  hosts_.swap(hosts);
+  partitions_.swap(partitions);
+  return true;
+}
+
+bool TopologyCache::load(const std::string& path) {
+  std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+  if (!file) {
+    LOG_DEBUG("No topology cache found at \"%s\"", path.c_str());
+    return false;
+  }
+
+  std::string data((std::istreambuf_iterator<char>(file)),
+                   std::istreambuf_iterator<char>());
+  if (file.bad() || !decode(data.data(), data.size())) {
+    LOG_WARN("Ignoring invalid topology cache \"%s\"", path.c_str());
+    return false;
+  }
+
+  LOG_DEBUG("Loaded topology cache \"%s\" with %u hosts and %u tables",
+            path.c_str(),
+            static_cast<unsigned int>(hosts_.size()),
+            static_cast<unsigned int>(partitions_.size()));
+  return true;
+}
+
+bool TopologyCache::save(const std::string& path) const {
+  std::string data;
+  encode(&data);
+
+  std::string temp_path(path + ".tmp");
+  {
+    std::ofstream file(temp_path.c_str(),
+                       std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.write(data.data(), data.size()) || !file.flush()) {
+      LOG_WARN("Unable to write topology cache \"%s\"", temp_path.c_str());
+      file.close();
+      std::remove(temp_path.c_str());
+      return false;
+    }
+  }
+
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    // Renaming over an existing file isn't supported on all platforms
+    std::remove(path.c_str());
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+      LOG_WARN("Unable to replace topology cache \"%s\"", path.c_str());
+      std::remove(temp_path.c_str());
+      return false;
+    }
+  }
+
+  return true;
+}
+
+} // namespace cass
@@ -0,0 +1,89 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_TOPOLOGY_CACHE_HPP_INCLUDED__
+#define __CASS_TOPOLOGY_CACHE_HPP_INCLUDED__
+
+#include "metadata.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace cass {
+
+// A snapshot of the cluster's topology (hosts and the partition map) that is
+// persisted between sessions so that a new session can route requests before
+// the control connection has rediscovered the cluster.
+//
+// The file format is versioned and consists of big-endian fixed size
+// integers and length-prefixed strings:
+//
+//   magic "CTC1" | version (uint16) | payload size (uint32) | payload | checksum (uint32)
+//
+//   payload: host count (uint32) |
+//              { address | port (int32) | datacenter | rack | release version }...
+//            table count (uint32) |
+//              { table name | partition count (uint32) |
+//                { start key (int32) | end key (int32) | host count (uint32) | { host }... }... }...
+//
+// Strings are encoded as a uint16 length followed by the bytes and the
+// checksum is the FNV-1a hash of the payload.
+class TopologyCache {
+public:
+  static const uint16_t VERSION = 1;
+
+  struct HostEntry {
+    HostEntry()
+      : port(0) { }
+
+    std::string address;
+    int32_t port;
+    std::string dc;
+    std::string rack;
+    std::string release_version;
+  };
+
+  typedef std::vector<HostEntry> HostEntryVec;
+
+  HostEntryVec& hosts() { return hosts_; }
+  const HostEntryVec& hosts() const { return hosts_; }
+
+  TableSplitMetadata::Map& partitions() { return partitions_; }
+  const TableSplitMetadata::Map& partitions() const { return partitions_; }
+
+  bool empty() const { return hosts_.empty() && partitions_.empty(); }
+
+  void encode(std::string* output) const;
+
+  // Returns false if the data is truncated, corrupted or was written using
+  // a different version of the format.
+  bool decode(const char* data, size_t size);
+
+  bool load(const std::string& path);
+
+  // The file is written to a temporary file first and then renamed so that
+  // concurrent loads never observe a partially written cache.
+  bool save(const std::string& path) const;
+
+private:
+  HostEntryVec hosts_;
+  TableSplitMetadata::Map partitions_;
+};
+
+} // namespace cass
+
+#endif
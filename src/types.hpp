@@ -17,6 +17,7 @@
 #ifndef __CASS_TYPES_HPP_INCLUDED__
 #define __CASS_TYPES_HPP_INCLUDED__
 
+#include "buffer.hpp"
 #include "cassandra.h"
 #include "string_ref.hpp"
 
@@ -33,6 +34,17 @@ struct CassBytes {
   size_t size;
 };
 
+// Bytes that are referenced instead of copied
+struct CassExternalBytes {
+  CassExternalBytes(const cass_byte_t* data, size_t size,
+                    CassBufferReleaseCallback callback, void* callback_data)
+    : buffer(new ExternalBuffer(reinterpret_cast<const char*>(data),
+                                callback, callback_data))
+    , size(size) { }
+  ExternalBuffer::Ptr buffer;
+  size_t size;
+};
+
 struct CassCustom {
   CassCustom(StringRef class_name,
              const cass_byte_t* data, size_t size)
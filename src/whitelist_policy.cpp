@@ -19,7 +19,7 @@
 namespace cass {
 
 bool WhitelistPolicy::is_valid_host(const Host::Ptr& host) const {
-  const std::string& host_address = host->address().to_string(false);
+  const std::string& host_address = host->address_string();
   for (ContactPointList::const_iterator it = hosts_.begin(),
                                                 end = hosts_.end();
        it != end; ++it) {